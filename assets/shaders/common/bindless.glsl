@@ -0,0 +1,28 @@
+#ifndef STARRY_COMMON_BINDLESS_GLSL
+#define STARRY_COMMON_BINDLESS_GLSL
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+// 无绑定资源表（BindlessTable）所在的描述符集
+#ifndef BINDLESS_SET
+#define BINDLESS_SET 1
+#endif
+
+// 绑定号与BindlessTable::Binding一致
+layout(set = BINDLESS_SET, binding = 0) uniform texture2D bindlessTextures[];
+layout(set = BINDLESS_SET, binding = 1) uniform sampler bindlessSamplers[];
+layout(set = BINDLESS_SET, binding = 2) readonly buffer BindlessBuffer {
+    uint words[];
+} bindlessBuffers[];
+
+// 索引可能在一次绘制内不一致（例如来自实例数据），统一加nonuniformEXT
+vec4 sampleBindless(uint textureId, uint samplerId, vec2 uv) {
+    return texture(sampler2D(bindlessTextures[nonuniformEXT(textureId)],
+        bindlessSamplers[nonuniformEXT(samplerId)]), uv);
+}
+
+uint loadBindlessWord(uint bufferId, uint wordIndex) {
+    return bindlessBuffers[nonuniformEXT(bufferId)].words[wordIndex];
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef STARRY_COMMON_LIGHTING_GLSL
+#define STARRY_COMMON_LIGHTING_GLSL
+
+// 立方体材质共享的点光源
+const vec3 LIGHT_POSITION = vec3(2.0, 2.0, 2.0);
+
+vec3 lightDirection(vec3 position) {
+    return normalize(LIGHT_POSITION - position);
+}
+
+// 漫反射系数
+float lambert(vec3 normal, vec3 position) {
+    return max(dot(normal, lightDirection(position)), 0.0);
+}
+
+// Phong高光系数（观察点位于原点）
+float phongSpecular(vec3 normal, vec3 position, float shininess) {
+    vec3 viewDir = normalize(-position);
+    vec3 reflectDir = reflect(-lightDirection(position), normal);
+    return pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+}
+
+#endif
@@ -34,8 +34,12 @@ namespace StarryEngine{
 
 #ifdef NDEBUG
     const bool enableValidationLayers = false;
+    const bool enableShaderHotReload = false;
+    const bool enableCacheStats = false;
 #else
     const bool enableValidationLayers = true;
+    const bool enableShaderHotReload = true;
+    const bool enableCacheStats = true;
 #endif 
 
     struct QueueFamilyIndices {
@@ -1,4 +1,6 @@
 #include "Application.hpp"
+#include <algorithm>
+#include <cstdlib>
 
 namespace StarryEngine {
     struct MultiMaterialVertex {
@@ -7,6 +9,13 @@ namespace StarryEngine {
         uint32_t materialID;  
     };
 
+    // 默认材质的固定功能状态：不透明预设，剔除方式与"Opaque"光栅化组件一致（不剔除）
+    inline constexpr PipelineStatePreset DEFAULT_MATERIAL_PRESET = [] {
+        PipelineStatePreset preset = PipelinePresets::Opaque;
+        preset.rasterization.cullMode = VK_CULL_MODE_NONE;
+        return preset;
+    }();
+
     Application::Application() {
         try {
             initialize();
@@ -47,6 +56,46 @@ namespace StarryEngine {
         Buffer::SetVMAAllocator(mRenderer->getBackendAs<VulkanBackend>()->getAllocator());
         mDevice =mRenderer->getBackendAs<VulkanBackend>()->getVulkanCore()->getLogicalDevice();
         mCommandPool =mRenderer->getBackendAs<VulkanBackend>()->getWindowContext()->getCommandPool();
+
+        // SPIR-V磁盘缓存：二次启动时跳过shaderc编译
+        ShaderUtils::SetShaderCache(ShaderCache::create("cache/shaders"));
+
+        // 着色器#include按资源目录解析，共享头文件每次会话只读取一次
+        ShaderUtils::GetIncludeResolver()->addSearchPath("assets/shaders");
+
+        // 离线着色器包（starry_shaderc生成）：命中时直接从映射内存创建模块，不调用shaderc
+        if (auto shaderPack = ShaderPack::open("assets/shaders.pack", "assets/shaders")) {
+            std::cout << "Shader pack: " << shaderPack->getEntryCount() << " variants" << std::endl;
+            ShaderUtils::SetShaderPack(shaderPack);
+        }
+
+        // 管线缓存：二次启动时驱动可跳过大部分管线编译
+        mPipelineCache = PipelineCache::acquire(mDevice);
+        mPipelineCache->load("cache/pipeline_cache.bin");
+
+        // 布局缓存：绑定相同的描述符集布局和管线布局在设备内共享
+        mLayoutCache = LayoutCache::acquire(mDevice);
+
+        // 无绑定资源表：须在创建纹理和存储缓冲前获取，之后创建的资源自动登记索引
+        mBindlessTable = BindlessTable::acquire(mDevice);
+        if (!mBindlessTable) {
+            std::cout << "Bindless table: descriptor indexing not supported" << std::endl;
+        }
+
+        // 管线创建记录：耗时与驱动缓存命中情况，用于决定预编译哪些管线
+        mPipelineFeedback = PipelineFeedback::acquire(mDevice);
+
+        // 管线预缓存清单：上次会话创建过的管线在第一帧前并行预建
+        mPipelinePrecache = PipelinePrecache::acquire(mDevice);
+        mPipelinePrecache->load("cache/pipeline_manifest.txt");
+
+        // 图形管线库：热重载时只重新编译变化的部分，快速链接结果立即可用
+        mPipelineLibrary = PipelineLibrary::acquire(mDevice);
+        if (mPipelineLibrary) {
+            std::cout << "Graphics pipeline library enabled (fast linking: "
+                << (mPipelineLibrary->hasFastLinking() ? "yes" : "no") << ")" << std::endl;
+        }
+
         registerDefaultComponents();
 
         // 注释掉原来的模型加载，使用多材质立方体
@@ -75,12 +124,34 @@ namespace StarryEngine {
         
         // 第五步：创建基础管线（可选，用于测试）
         createGraphicsPipeline();
+
+        // 布局和渲染通道已登记，预建清单中的管线，之后的同状态构建直接共享
+        mPipelinePrecache->prebuild(mComponentRegistry);
         
         // 第六步：创建多材质管线（这是关键！）
         createMultiplePipelines();
         
         // 第七步：创建帧缓冲
         mRenderer->createFramebuffers(mSwapchainFramebuffers,mDepthTexture->getImageView(),mRenderPassResult->renderPass->getHandle());
+
+        // 着色器对象基准测试：只录制命令缓冲，不提交
+        if (std::getenv("STARRY_SHADER_OBJECT_BENCHMARK") != nullptr) {
+            if (mDevice->getOptionalFeatures().shaderObject) {
+                waitPendingPipelines();
+                runShaderObjectBenchmark();
+            }
+            else {
+                std::cout << "Shader object benchmark skipped: VK_EXT_shader_object not enabled" << std::endl;
+            }
+        }
+
+        // 描述符更新模板基准测试：只更新基准自己分配的描述符集
+        if (std::getenv("STARRY_DESCRIPTOR_TEMPLATE_BENCHMARK") != nullptr) {
+            runDescriptorTemplateBenchmark();
+        }
+
+        // 第八步：开发模式下启用着色器热重载
+        createShaderHotReloader();
         
         std::cout << "Application initialized successfully!" << std::endl;
     }
@@ -180,11 +251,11 @@ namespace StarryEngine {
         
         mMultiMaterialShaders.resize(6);
         
-        // 6个不同的片段着色器内容
-        std::vector<std::string> fragmentShaders = {
-            // 红色面 - 纯色
-            R"(
+        // 6个面的片段着色器是同一份源码的关键字变体，每个面选择一个FACE_*关键字
+        const std::string fragmentShader = R"(
             #version 450
+            #pragma keywords FACE_SOLID FACE_CHECKER FACE_DOTS FACE_GRID FACE_GRADIENT FACE_SPECULAR
+            #include "common/lighting.glsl"
             layout(location = 0) in vec3 fragPosition;
             layout(location = 1) in vec3 fragNormal;
             layout(location = 2) flat in uint fragMaterialID;
@@ -192,144 +263,55 @@ namespace StarryEngine {
             layout(location = 0) out vec4 outColor;
             
             void main() {
-                // 红色，加上简单的光照
-                vec3 lightPos = vec3(2.0, 2.0, 2.0);
-                vec3 lightDir = normalize(lightPos - fragPosition);
-                float diff = max(dot(fragNormal, lightDir), 0.0);
+                float diff = lambert(fragNormal, fragPosition);
+            #if defined(FACE_SOLID)
+                // 红色面 - 纯色
                 vec3 color = vec3(1.0, 0.0, 0.0);
                 outColor = vec4(color * (0.2 + 0.8 * diff), 1.0);
-            }
-            )",
-            
-            // 蓝色面 - 棋盘格效果
-            R"(
-            #version 450
-            layout(location = 0) in vec3 fragPosition;
-            layout(location = 1) in vec3 fragNormal;
-            layout(location = 2) flat in uint fragMaterialID;
-            
-            layout(location = 0) out vec4 outColor;
-            
-            void main() {
-                vec3 lightPos = vec3(2.0, 2.0, 2.0);
-                vec3 lightDir = normalize(lightPos - fragPosition);
-                float diff = max(dot(fragNormal, lightDir), 0.0);
-                
-                // 棋盘格效果
+            #elif defined(FACE_CHECKER)
+                // 蓝色面 - 棋盘格效果
                 vec3 pos = fragPosition * 5.0;
                 float pattern = mod(floor(pos.x) + floor(pos.y) + floor(pos.z), 2.0);
                 vec3 color = mix(vec3(0.0, 0.0, 0.5), vec3(0.2, 0.2, 1.0), pattern);
-                
                 outColor = vec4(color * (0.3 + 0.7 * diff), 1.0);
-            }
-            )",
-            
-            // 绿色面 - 点阵效果
-            R"(
-            #version 450
-            layout(location = 0) in vec3 fragPosition;
-            layout(location = 1) in vec3 fragNormal;
-            layout(location = 2) flat in uint fragMaterialID;
-            
-            layout(location = 0) out vec4 outColor;
-            
-            void main() {
-                vec3 lightPos = vec3(2.0, 2.0, 2.0);
-                vec3 lightDir = normalize(lightPos - fragPosition);
-                float diff = max(dot(fragNormal, lightDir), 0.0);
-                
-                // 点阵效果
+            #elif defined(FACE_DOTS)
+                // 绿色面 - 点阵效果
                 vec2 uv = fragPosition.xy * 10.0;
                 float radius = 0.3;
                 float dist = distance(fract(uv), vec2(0.5));
                 float pattern = step(radius, dist);
-                
                 vec3 color = vec3(0.0, pattern * 0.8, pattern * 0.3);
                 outColor = vec4(color * (0.2 + 0.8 * diff), 1.0);
-            }
-            )",
-            
-            // 黄色面 - 线框效果
-            R"(
-            #version 450
-            layout(location = 0) in vec3 fragPosition;
-            layout(location = 1) in vec3 fragNormal;
-            layout(location = 2) flat in uint fragMaterialID;
-            
-            layout(location = 0) out vec4 outColor;
-            
-            void main() {
-                vec3 lightPos = vec3(2.0, 2.0, 2.0);
-                vec3 lightDir = normalize(lightPos - fragPosition);
-                float diff = max(dot(fragNormal, lightDir), 0.0);
-                
-                // 线框效果
+            #elif defined(FACE_GRID)
+                // 黄色面 - 线框效果
                 vec2 uv = fragPosition.xy * 10.0;
                 float lineWidth = 0.1;
                 vec2 grid = abs(fract(uv - 0.5) - 0.5);
                 float pattern = step(lineWidth, min(grid.x, grid.y));
-                
                 vec3 color = mix(vec3(1.0, 1.0, 0.0), vec3(0.5, 0.5, 0.0), pattern);
                 outColor = vec4(color * (0.3 + 0.7 * diff), 1.0);
-            }
-            )",
-            
-            // 紫色面 - 渐变效果
-            R"(
-            #version 450
-            layout(location = 0) in vec3 fragPosition;
-            layout(location = 1) in vec3 fragNormal;
-            layout(location = 2) flat in uint fragMaterialID;
-            
-            layout(location = 0) out vec4 outColor;
-            
-            void main() {
-                vec3 lightPos = vec3(2.0, 2.0, 2.0);
-                vec3 lightDir = normalize(lightPos - fragPosition);
-                float diff = max(dot(fragNormal, lightDir), 0.0);
-                
-                // 渐变效果
+            #elif defined(FACE_GRADIENT)
+                // 紫色面 - 渐变效果
                 float gradient = (fragPosition.y + 0.5) / 1.0;
                 vec3 color = mix(vec3(0.5, 0.0, 0.5), vec3(1.0, 0.5, 1.0), gradient);
-                
                 outColor = vec4(color * (0.2 + 0.8 * diff), 1.0);
-            }
-            )",
-            
-            // 青色面 - 高光效果
-            R"(
-            #version 450
-            layout(location = 0) in vec3 fragPosition;
-            layout(location = 1) in vec3 fragNormal;
-            layout(location = 2) flat in uint fragMaterialID;
-            
-            layout(location = 0) out vec4 outColor;
-            
-            void main() {
-                vec3 lightPos = vec3(2.0, 2.0, 2.0);
-                vec3 lightDir = normalize(lightPos - fragPosition);
-                vec3 viewDir = normalize(-fragPosition);
-                vec3 reflectDir = reflect(-lightDir, fragNormal);
-                
-                float diff = max(dot(fragNormal, lightDir), 0.0);
-                float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32.0);
-                
+            #elif defined(FACE_SPECULAR)
+                // 青色面 - 高光效果
+                float spec = phongSpecular(fragNormal, fragPosition, 32.0);
                 vec3 color = vec3(0.0, 0.8, 0.8);
                 vec3 ambient = color * 0.1;
                 vec3 diffuse = color * diff;
                 vec3 specular = vec3(1.0) * spec;
-                
                 outColor = vec4(ambient + diffuse + specular, 1.0);
+            #endif
             }
-            )"
+            )";
+        const std::array<std::string, 6> faceKeywords = {
+            "FACE_SOLID", "FACE_CHECKER", "FACE_DOTS", "FACE_GRID", "FACE_GRADIENT", "FACE_SPECULAR"
         };
         
-        // 创建6个ShaderProgram
-        for (int i = 0; i < 6; i++) {
-            auto shaderProgram = ShaderProgram::create(mDevice);
-            
-            // 顶点着色器（所有面共享）
-            std::string vertexShader = R"(
+        // 顶点着色器（所有面共享）
+        std::string vertexShader = R"(
             #version 450
             layout(location = 0) in vec3 inPosition;
             layout(location = 1) in vec3 inNormal;
@@ -354,30 +336,44 @@ namespace StarryEngine {
                 fragMaterialID = inMaterialID;
             }
             )";
-            
-            // 检查ShaderProgram是否支持GLSL字符串
-            try {
-                // 尝试使用GLSL字符串方式
-                shaderProgram->addGLSLStringStage(
-                    vertexShader,
-                    VK_SHADER_STAGE_VERTEX_BIT,
-                    "main",
-                    {},
-                    "VertexShader_CubeFace" + std::to_string(i)
-                );
-                
-                shaderProgram->addGLSLStringStage(
-                    fragmentShaders[i],
-                    VK_SHADER_STAGE_FRAGMENT_BIT,
-                    "main",
-                    {},
-                    "FragmentShader_CubeFace" + std::to_string(i)
-                );
-            } catch (const std::exception& e) {
-                std::cerr << "Failed to create shader from string: " << e.what() << std::endl;
-                std::cerr << "Trying file-based shaders..." << std::endl;
-                
-                // 回退方案：使用文件
+
+        // 变体库解析关键字轴，6个变体合并为一次并行批量编译
+        ShaderStageDesc vertexDesc{};
+        vertexDesc.sourceType = ShaderStageDesc::SourceType::GLSLString;
+        vertexDesc.source = vertexShader;
+        vertexDesc.stage = VK_SHADER_STAGE_VERTEX_BIT;
+        vertexDesc.debugName = "VertexShader_CubeFace";
+
+        ShaderStageDesc fragmentDesc{};
+        fragmentDesc.sourceType = ShaderStageDesc::SourceType::GLSLString;
+        fragmentDesc.source = fragmentShader;
+        fragmentDesc.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        fragmentDesc.debugName = "FragmentShader_CubeFace";
+
+        mMaterialShaderVariants = ShaderVariantLibrary::create(mDevice, { vertexDesc, fragmentDesc });
+
+        try {
+            std::vector<std::vector<std::string>> keywordSets;
+            for (const auto& keyword : faceKeywords) {
+                keywordSets.push_back({ keyword });
+            }
+            mMaterialShaderVariants->precompile(keywordSets);
+            for (int i = 0; i < 6; i++) {
+                mMultiMaterialShaders[i] = mMaterialShaderVariants->getVariantBlocking({ faceKeywords[i] });
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to create shader from string: " << e.what() << std::endl;
+            std::cerr << "Trying file-based shaders..." << std::endl;
+
+            // 回退方案：使用文件，片段着色器按变体的关键字宏编译
+            std::string fragFilename = "temp_frag.frag";
+            std::ofstream fragFile(fragFilename);
+            fragFile << fragmentShader;
+            fragFile.close();
+
+            const auto& keywordSpace = mMaterialShaderVariants->getKeywordSpace();
+            for (int i = 0; i < 6; i++) {
+                auto shaderProgram = ShaderProgram::create(mDevice);
                 shaderProgram->addGLSLStage(
                     "assets/shaders/core/shader.vert",
                     VK_SHADER_STAGE_VERTEX_BIT,
@@ -385,32 +381,26 @@ namespace StarryEngine {
                     {},
                     "VertexShader_CubeFace" + std::to_string(i)
                 );
-                
-                // 创建临时文件保存片段着色器
-                std::string fragFilename = "temp_frag_" + std::to_string(i) + ".frag";
-                std::ofstream fragFile(fragFilename);
-                fragFile << fragmentShaders[i];
-                fragFile.close();
-                
                 shaderProgram->addGLSLStage(
                     fragFilename.c_str(),
                     VK_SHADER_STAGE_FRAGMENT_BIT,
                     "main",
-                    {},
+                    keywordSpace.getMacros(keywordSpace.computeKey({ faceKeywords[i] })),
                     "FragmentShader_CubeFace" + std::to_string(i)
                 );
-                
-                // 删除临时文件
-                std::remove(fragFilename.c_str());
+                mMultiMaterialShaders[i] = shaderProgram;
             }
-            
-            mMultiMaterialShaders[i] = shaderProgram;
-            
-            // 创建ShaderStageComponent并注册
+
+            // 删除临时文件
+            std::remove(fragFilename.c_str());
+        }
+
+        // 创建ShaderStageComponent并注册
+        for (int i = 0; i < 6; i++) {
             auto shaderComponent = std::make_shared<ShaderStageComponent>(
                 "CubeFaceShader" + std::to_string(i)
             );
-            shaderComponent->setShaderProgram(shaderProgram);
+            shaderComponent->setShaderProgram(mMultiMaterialShaders[i]);
             mComponentRegistry->registerComponent(
                 "CubeFaceShader" + std::to_string(i), 
                 shaderComponent
@@ -424,6 +414,7 @@ namespace StarryEngine {
         std::cout << "Creating multiple pipelines..." << std::endl;
         
         mMultiMaterialPipelines.resize(6);
+        resolveMaterialHandles();
         
         // 配置顶点输入组件（基于MultiMaterialVertex）
         auto vertexInputComponent = std::dynamic_pointer_cast<VertexInputComponent>(
@@ -436,6 +427,12 @@ namespace StarryEngine {
             if (mMultiMaterialVAO) {
                 vertexInputComponent->configureFromVertexBuffer(*mMultiMaterialVAO);
                 std::cout << "Configured vertex input from multi-material VAO" << std::endl;
+
+                // 用反射结果检查VAO布局与顶点着色器输入是否一致
+                auto errors = ShaderReflection::reflect(*mMultiMaterialShaders[0]).validateVertexInput(*vertexInputComponent);
+                for (const auto& error : errors) {
+                    std::cerr << "Vertex input mismatch: " << error << std::endl;
+                }
             } else {
                 throw std::runtime_error("Multi-material VAO not created");
             }
@@ -451,81 +448,555 @@ namespace StarryEngine {
             viewportComponent->setViewportScissor(viewport);
         }
         
-        // 为每个材质创建管线
+        // 六个材质管线在后台异步编译，就绪前用同布局的基础管线（后备管线）绘制
+        // 上次会话的管线已由预缓存清单预建时，这里直接共享，第一帧即可就绪
         for (int i = 0; i < 6; i++) {
+            mMultiMaterialPipelines[i] = VK_NULL_HANDLE;
             try {
-                // 创建新的PipelineBuilder实例（每个管线需要单独的）
-                auto pipelineBuilder = std::make_shared<PipelineBuilder>(
-                    mDevice->getHandle(),
-                    mComponentRegistry
-                );
-                
-                // 使用不同的光栅化状态来展示多样性
-                std::string rasterizationName = "Opaque";
-                if (i == 3) {  // 黄色面使用线框模式
-                    rasterizationName = "Wireframe";
+                mPendingPipelines.emplace_back(i, buildMaterialPipelineAsync(i));
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Failed to request pipeline for face " << i << ": " << e.what() << std::endl;
+                mMultiMaterialPipelines[i] = buildDefaultMaterialPipeline();
+            }
+        }
+    }
+
+    VkPipeline Application::buildDefaultMaterialPipeline() {
+        // 固定功能状态来自编译期预设，只有着色器和顶点输入经过注册表
+        PipelineBuilder pipelineBuilder(mDevice->getHandle(), mComponentRegistry);
+        return pipelineBuilder
+            .addComponent(PipelineComponentType::SHADER_STAGE, "BasicShader")
+            .addComponent(PipelineComponentType::VERTEX_INPUT, "BasicVertex")
+            .buildFromPreset(
+                DEFAULT_MATERIAL_PRESET,
+                mPipelineLayout->getHandle(),
+                mRenderPassResult->renderPass->getHandle(),
+                mRenderPassResult->pipelineNameToSubpassIndexMap["MainPipeline"]
+            );
+    }
+
+    const AsyncPipeline* Application::findPendingPipeline(int face) const {
+        // 同一面可能有多个请求，最新的在最后
+        for (auto it = mPendingPipelines.rbegin(); it != mPendingPipelines.rend(); ++it) {
+            if (it->first == face) {
+                return it->second.get();
+            }
+        }
+        return nullptr;
+    }
+
+    void Application::waitPendingPipelines() {
+        for (auto& [face, asyncPipeline] : mPendingPipelines) {
+            asyncPipeline->wait();
+        }
+        applyPendingPipelines();
+    }
+
+
+    std::vector<ComponentSelection> Application::getMaterialSelections(int face) const {
+        // 使用不同的光栅化状态来展示多样性
+        std::string rasterizationName = "Opaque";
+        if (face == 3) {  // 黄色面使用线框模式
+            rasterizationName = "Wireframe";
+        }
+        
+        // 使用不同的混合状态
+        std::string blendName = "None";
+        if (face == 4) {  // 紫色面使用alpha混合
+            blendName = "Alpha";
+        }
+        
+        // 支持扩展动态状态时，光栅化和混合的差异不再区分管线
+        const bool extended = mComponentRegistry->getComponent(PipelineComponentType::DYNAMIC_STATE, "Extended") != nullptr;
+
+        return {
+            {PipelineComponentType::SHADER_STAGE, "CubeFaceShader" + std::to_string(face)},
+            {PipelineComponentType::VERTEX_INPUT, "BasicVertex"},
+            {PipelineComponentType::INPUT_ASSEMBLY, "TriangleList"},
+            {PipelineComponentType::VIEWPORT_STATE, "Fullscreen"},
+            {PipelineComponentType::RASTERIZATION, rasterizationName},
+            {PipelineComponentType::MULTISAMPLE, "Default"},
+            {PipelineComponentType::DEPTH_STENCIL, "Enabled"},
+            {PipelineComponentType::COLOR_BLEND, blendName},
+            {PipelineComponentType::DYNAMIC_STATE, extended ? "Extended" : "Basic"}
+        };
+    }
+
+    std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>>
+        Application::getMaterialComponents(int face) const {
+        std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>> components;
+        for (const auto& selection : getMaterialSelections(face)) {
+            components[selection.type] = mComponentRegistry->getComponent(selection.type, selection.name);
+        }
+        return components;
+    }
+
+    void Application::resolveMaterialHandles() {
+        for (int face = 0; face < static_cast<int>(mMaterialHandles.size()); face++) {
+            auto& handles = mMaterialHandles[face];
+            handles = {};
+            for (const auto& selection : getMaterialSelections(face)) {
+                switch (selection.type) {
+                case PipelineComponentType::DYNAMIC_STATE:
+                    handles.dynamicState = mComponentRegistry->findHandle<DynamicStateComponent>(selection.name);
+                    break;
+                case PipelineComponentType::RASTERIZATION:
+                    handles.rasterization = mComponentRegistry->findHandle<RasterizationComponent>(selection.name);
+                    break;
+                case PipelineComponentType::DEPTH_STENCIL:
+                    handles.depthStencil = mComponentRegistry->findHandle<DepthStencilComponent>(selection.name);
+                    break;
+                case PipelineComponentType::COLOR_BLEND:
+                    handles.colorBlend = mComponentRegistry->findHandle<ColorBlendComponent>(selection.name);
+                    break;
+                case PipelineComponentType::INPUT_ASSEMBLY:
+                    handles.inputAssembly = mComponentRegistry->findHandle<InputAssemblyComponent>(selection.name);
+                    break;
+                case PipelineComponentType::VERTEX_INPUT:
+                    handles.vertexInput = mComponentRegistry->findHandle<VertexInputComponent>(selection.name);
+                    break;
+                default:
+                    break;
                 }
-                
-                // 使用不同的混合状态
-                std::string blendName = "None";
-                if (i == 4) {  // 紫色面使用alpha混合
-                    blendName = "Alpha";
+            }
+        }
+    }
+
+    void Application::applyMaterialDynamicState(RenderContext& context, int face) const {
+        const auto& handles = mMaterialHandles[face];
+        auto* dynamicState = mComponentRegistry->get(handles.dynamicState);
+        if (!dynamicState) {
+            return;
+        }
+        if (auto* rasterization = mComponentRegistry->get(handles.rasterization)) {
+            context.applyDynamicState(*dynamicState, *rasterization);
+        }
+        if (auto* depthStencil = mComponentRegistry->get(handles.depthStencil)) {
+            context.applyDynamicState(*dynamicState, *depthStencil);
+        }
+        if (auto* colorBlend = mComponentRegistry->get(handles.colorBlend)) {
+            context.applyDynamicState(*dynamicState, *colorBlend);
+        }
+        if (auto* inputAssembly = mComponentRegistry->get(handles.inputAssembly)) {
+            context.applyDynamicState(*dynamicState, *inputAssembly);
+        }
+        if (auto* vertexInput = mComponentRegistry->get(handles.vertexInput)) {
+            context.applyDynamicState(*dynamicState, *vertexInput);
+        }
+    }
+
+    void Application::runShaderObjectBenchmark() {
+        using Clock = std::chrono::high_resolution_clock;
+        constexpr int CREATE_ITERATIONS = 10;
+        constexpr int DRAW_ITERATIONS = 200;
+        constexpr int FACE_COUNT = 6;
+
+        auto toMicroseconds = [](Clock::duration duration, int count) {
+            return std::chrono::duration<double, std::micro>(duration).count() / count;
+        };
+
+        if (!mMultiMaterialVAO || !mMultiMaterialIBO || mMultiMaterialPipelines.size() < FACE_COUNT ||
+            std::find(mMultiMaterialPipelines.begin(), mMultiMaterialPipelines.end(), VK_NULL_HANDLE) !=
+            mMultiMaterialPipelines.end()) {
+            std::cerr << "Shader object benchmark skipped: material pipelines not available" << std::endl;
+            return;
+        }
+
+        std::cout << "=== Pipeline vs shader object benchmark ===" << std::endl;
+
+        // 创建耗时：整体管线不经过PipelineCache，避免命中缓存
+        VkRenderPass renderPass = mRenderPassResult->renderPass->getHandle();
+        uint32_t subpass = mRenderPassResult->pipelineNameToSubpassIndexMap["MainPipeline"];
+        Clock::duration pipelineCreateTime{};
+        Clock::duration shaderObjectCreateTime{};
+        std::vector<ShaderObject::Ptr> shaderObjects(FACE_COUNT);
+        for (int iteration = 0; iteration < CREATE_ITERATIONS; ++iteration) {
+            for (int face = 0; face < FACE_COUNT; ++face) {
+                PipelineBuilder builder(mDevice->getHandle(), mComponentRegistry);
+                VkGraphicsPipelineCreateInfo pipelineInfo = builder.addComponents(getMaterialSelections(face))
+                    .resolvePipelineCreateInfo(mPipelineLayout->getHandle(), renderPass, subpass);
+
+                auto start = Clock::now();
+                VkPipeline pipeline = VK_NULL_HANDLE;
+                if (vkCreateGraphicsPipelines(mDevice->getHandle(), VK_NULL_HANDLE, 1, &pipelineInfo,
+                    nullptr, &pipeline) != VK_SUCCESS) {
+                    throw std::runtime_error("Benchmark failed to create graphics pipeline");
                 }
-                
-                // 构建管线
-                mMultiMaterialPipelines[i] = pipelineBuilder
-                    ->addComponent(PipelineComponentType::SHADER_STAGE, "CubeFaceShader" + std::to_string(i))
-                    .addComponent(PipelineComponentType::VERTEX_INPUT, "BasicVertex")
-                    .addComponent(PipelineComponentType::INPUT_ASSEMBLY, "TriangleList")
-                    .addComponent(PipelineComponentType::VIEWPORT_STATE, "Fullscreen")
-                    .addComponent(PipelineComponentType::RASTERIZATION, rasterizationName)
-                    .addComponent(PipelineComponentType::MULTISAMPLE, "Default")
-                    .addComponent(PipelineComponentType::DEPTH_STENCIL, "Enabled")
-                    .addComponent(PipelineComponentType::COLOR_BLEND, blendName)
-                    .addComponent(PipelineComponentType::DYNAMIC_STATE, "Basic")
-                    .buildGraphicsPipeline(
-                        mPipelineLayout->getHandle(),  // 使用原来的布局
-                        mRenderPassResult->renderPass->getHandle(),
-                        mRenderPassResult->pipelineNameToSubpassIndexMap["MainPipeline"]
-                    );
-                
-                std::cout << "Created pipeline for face " << i << " ("
-                          << rasterizationName << ", " << blendName << ")" << std::endl;
+                vkDestroyPipeline(mDevice->getHandle(), pipeline, nullptr);
+                pipelineCreateTime += Clock::now() - start;
+
+                start = Clock::now();
+                shaderObjects[face] = ShaderObject::create(mDevice, mMultiMaterialShaders[face],
+                    mPipelineLayout->getDescriptorSetLayouts());
+                shaderObjectCreateTime += Clock::now() - start;
+            }
+        }
+
+        // 录制开销：每次绘制都重新绑定并设置该面的状态
+        // 两种方式的材质状态都在计时前取好，循环内不做注册表查找和容器构建
+        struct FaceState {
+            const DynamicStateComponent* dynamicState = nullptr;
+            const RasterizationComponent* rasterization = nullptr;
+            const DepthStencilComponent* depthStencil = nullptr;
+            const ColorBlendComponent* colorBlend = nullptr;
+            const InputAssemblyComponent* inputAssembly = nullptr;
+            const VertexInputComponent* vertexInput = nullptr;
+        };
+        std::array<FaceState, FACE_COUNT> faceStates{};
+        // 组件表只在此处使用，解析后的引用依赖它保持存活
+        std::vector<std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>>> components;
+        std::array<RenderContext::GraphicsState, FACE_COUNT> graphicsStates{};
+        components.reserve(FACE_COUNT);
+        for (int face = 0; face < FACE_COUNT; ++face) {
+            const auto& handles = mMaterialHandles[face];
+            FaceState& state = faceStates[face];
+            state.dynamicState = mComponentRegistry->get(handles.dynamicState);
+            state.rasterization = mComponentRegistry->get(handles.rasterization);
+            state.depthStencil = mComponentRegistry->get(handles.depthStencil);
+            state.colorBlend = mComponentRegistry->get(handles.colorBlend);
+            state.inputAssembly = mComponentRegistry->get(handles.inputAssembly);
+            state.vertexInput = mComponentRegistry->get(handles.vertexInput);
+            if (!state.dynamicState || !state.rasterization || !state.depthStencil || !state.colorBlend ||
+                !state.inputAssembly || !state.vertexInput) {
+                std::cerr << "Shader object benchmark skipped: material components not available" << std::endl;
+                return;
+            }
+            components.push_back(getMaterialComponents(face));
+            graphicsStates[face] = RenderContext::resolveGraphicsState(components.back());
+        }
+        auto VBO = mMultiMaterialVAO->getBufferHandles();
+        VkBuffer IBO = mMultiMaterialIBO->getBuffer();
+        VkDescriptorSet descriptorSet = mDescriptorManager->getDescriptorSet(0, 0);
+
+        auto pipelineCommandBuffer = CommandBuffer::create(mDevice, mCommandPool);
+        pipelineCommandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        RenderContext pipelineContext(mDevice, pipelineCommandBuffer->getHandle(), 0);
+        passBeginInfo.reset()
+            .addClearColor({ 0.08f, 0.08f, 0.12f, 1.0f })
+            .addClearDepth({ 1.0f, 0 })
+            .update(renderPass, mSwapchainFramebuffers[0], mExtent);
+        pipelineContext.beginRenderPass(&passBeginInfo.getRenderPassBeginInfo(), VK_SUBPASS_CONTENTS_INLINE);
+        pipelineContext.bindVertexBuffers(VBO);
+        pipelineContext.bindIndexBuffer(IBO);
+        auto* viewport = mComponentRegistry->get(mFullscreenViewport);
+        const VkViewport fullscreenViewport = viewport->getViewports()[0];
+        const VkRect2D fullscreenScissor = viewport->getScissors()[0];
+        auto start = Clock::now();
+        for (int iteration = 0; iteration < DRAW_ITERATIONS; ++iteration) {
+            for (int face = 0; face < FACE_COUNT; ++face) {
+                const FaceState& state = faceStates[face];
+                pipelineContext.bindGraphicsPipeline(mMultiMaterialPipelines[face]);
+                pipelineContext.setViewport(fullscreenViewport);
+                pipelineContext.setScissor(fullscreenScissor);
+                pipelineContext.applyDynamicState(*state.dynamicState, *state.rasterization);
+                pipelineContext.applyDynamicState(*state.dynamicState, *state.depthStencil);
+                pipelineContext.applyDynamicState(*state.dynamicState, *state.colorBlend);
+                pipelineContext.applyDynamicState(*state.dynamicState, *state.inputAssembly);
+                pipelineContext.applyDynamicState(*state.dynamicState, *state.vertexInput);
+                pipelineContext.bindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, descriptorSet, 0,
+                    mPipelineLayout->getHandle());
+                pipelineContext.drawIndexed(6, 1, face * 6, 0, 0);
+            }
+        }
+        Clock::duration pipelineDrawTime = Clock::now() - start;
+        pipelineContext.endRenderPass();
+        pipelineCommandBuffer->end();
+
+        // 着色器对象须在动态渲染中使用；颜色附件为空视图，写入被丢弃
+        auto shaderObjectCommandBuffer = CommandBuffer::create(mDevice, mCommandPool);
+        shaderObjectCommandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        RenderContext shaderObjectContext(mDevice, shaderObjectCommandBuffer->getHandle(), 0);
+        VkRenderingAttachmentInfo colorAttachment{};
+        colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        colorAttachment.imageView = VK_NULL_HANDLE;
+        colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        VkRenderingInfo renderingInfo{};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        renderingInfo.renderArea = { {0, 0}, mExtent };
+        renderingInfo.layerCount = 1;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachments = &colorAttachment;
+        shaderObjectContext.beginRendering(renderingInfo);
+        shaderObjectContext.bindVertexBuffers(VBO);
+        shaderObjectContext.bindIndexBuffer(IBO);
+        start = Clock::now();
+        for (int iteration = 0; iteration < DRAW_ITERATIONS; ++iteration) {
+            for (int face = 0; face < FACE_COUNT; ++face) {
+                shaderObjectContext.bindShaderObject(*shaderObjects[face]);
+                shaderObjectContext.applyGraphicsState(graphicsStates[face]);
+                shaderObjectContext.bindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, descriptorSet, 0,
+                    mPipelineLayout->getHandle());
+                shaderObjectContext.drawIndexed(6, 1, face * 6, 0, 0);
+            }
+        }
+        Clock::duration shaderObjectDrawTime = Clock::now() - start;
+        shaderObjectContext.endRendering();
+        shaderObjectCommandBuffer->end();
+
+        const int createCount = CREATE_ITERATIONS * FACE_COUNT;
+        const int drawCount = DRAW_ITERATIONS * FACE_COUNT;
+        std::cout << "  Create (avg per material): pipeline " << toMicroseconds(pipelineCreateTime, createCount)
+            << " us, shader object " << toMicroseconds(shaderObjectCreateTime, createCount) << " us" << std::endl;
+        std::cout << "  Record (avg per draw): pipeline " << toMicroseconds(pipelineDrawTime, drawCount)
+            << " us, shader object " << toMicroseconds(shaderObjectDrawTime, drawCount) << " us" << std::endl;
+    }
+
+    void Application::runDescriptorTemplateBenchmark() {
+        using Clock = std::chrono::high_resolution_clock;
+        constexpr uint32_t UPDATE_COUNT = 10000;
+        constexpr uint32_t SET_COUNT = 64;
+        constexpr uint32_t BINDING_COUNT = 4;
+
+        if (mMatrixUniformBuffers.size() < 2 || mColorUniformBuffers.size() < 2) {
+            std::cerr << "Descriptor template benchmark skipped: uniform buffers not available" << std::endl;
+            return;
+        }
+
+        std::cout << "=== Descriptor write vs update template benchmark ===" << std::endl;
+
+        // 材质类描述符集：4个Uniform Buffer，轮流更新SET_COUNT个集
+        std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
+        for (uint32_t binding = 0; binding < BINDING_COUNT; ++binding) {
+            layoutBindings.push_back({ binding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL_GRAPHICS, nullptr });
+        }
+        auto setLayout = mLayoutCache->getDescriptorSetLayout(layoutBindings);
+        VkDescriptorSetLayout layout = setLayout->getHandle();
+
+        auto pool = DescriptorPool::create(mDevice,
+            { { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, SET_COUNT * BINDING_COUNT } }, SET_COUNT);
+        std::vector<VkDescriptorSetLayout> layouts(SET_COUNT, layout);
+        std::vector<VkDescriptorSet> sets(SET_COUNT);
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = pool->getHandle();
+        allocInfo.descriptorSetCount = SET_COUNT;
+        allocInfo.pSetLayouts = layouts.data();
+        if (vkAllocateDescriptorSets(mDevice->getHandle(), &allocInfo, sets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("Benchmark failed to allocate descriptor sets");
+        }
+
+        const std::vector<uint32_t> bindings = { 0, 1, 2, 3 };
+        const std::vector<VkBuffer> buffers = {
+            mMatrixUniformBuffers[0]->getBuffer(), mColorUniformBuffers[0]->getBuffer(),
+            mMatrixUniformBuffers[1]->getBuffer(), mColorUniformBuffers[1]->getBuffer() };
+
+        // 模板数据：与entries顺序一致的紧密排列结构
+        struct MaterialDescriptorData {
+            VkDescriptorBufferInfo uniforms[BINDING_COUNT];
+        };
+        MaterialDescriptorData packed{};
+        for (uint32_t i = 0; i < BINDING_COUNT; ++i) {
+            packed.uniforms[i] = { buffers[i], 0, VK_WHOLE_SIZE };
+        }
+
+        DescriptorWriter writer(mDevice);
+        VkDescriptorUpdateTemplate updateTemplate = writer.getUpdateTemplate(layout, {
+            { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER }, { 1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER },
+            { 2, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER }, { 3, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER } });
+        VkDescriptorUpdateTemplate batchTemplate = writer.getBatchTemplate(layout, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, bindings);
+
+        auto run = [&](auto&& update) {
+            // 预热一轮，模板创建和驱动的首次路径不计入
+            for (uint32_t i = 0; i < SET_COUNT; ++i) {
+                update(sets[i]);
+            }
+            auto start = Clock::now();
+            for (uint32_t i = 0; i < UPDATE_COUNT; ++i) {
+                update(sets[i % SET_COUNT]);
+            }
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        };
+
+        const double writeTime = run([&](VkDescriptorSet set) {
+            writer.updateUniformBuffers(set, bindings, buffers);
+        });
+        const double batchTemplateTime = run([&](VkDescriptorSet set) {
+            writer.updateUniformBuffers(set, batchTemplate, bindings, buffers);
+        });
+        const double packedTemplateTime = run([&](VkDescriptorSet set) {
+            writer.updateWithTemplate(set, updateTemplate, packed);
+        });
+
+        auto report = [&](const char* name, double seconds) {
+            std::cout << "  " << name << ": " << seconds * 1000.0 << " ms, "
+                << static_cast<uint64_t>(UPDATE_COUNT * BINDING_COUNT / seconds) << " writes/s, "
+                << seconds * 1e9 / UPDATE_COUNT << " ns per set" << std::endl;
+        };
+        std::cout << "  " << UPDATE_COUNT << " set updates, " << BINDING_COUNT << " bindings each" << std::endl;
+        report("vkUpdateDescriptorSets (write structs)", writeTime);
+        report("update template (vector arguments)", batchTemplateTime);
+        report("update template (packed struct)", packedTemplateTime);
+    }
+
+    VkPipeline Application::buildMaterialPipeline(int face) {
+        // 创建新的PipelineBuilder实例（每个管线需要单独的）
+        auto pipelineBuilder = std::make_shared<PipelineBuilder>(
+            mDevice->getHandle(),
+            mComponentRegistry
+        );
+
+        // 构建管线
+        return pipelineBuilder
+            ->addComponents(getMaterialSelections(face))
+            .buildGraphicsPipeline(
+                mPipelineLayout->getHandle(),  // 使用原来的布局
+                mRenderPassResult->renderPass->getHandle(),
+                mRenderPassResult->pipelineNameToSubpassIndexMap["MainPipeline"]
+            );
+    }
+
+    AsyncPipeline::Ptr Application::buildMaterialPipelineAsync(int face) {
+        PipelineBuilder pipelineBuilder(mDevice->getHandle(), mComponentRegistry);
+        return pipelineBuilder
+            .addComponents(getMaterialSelections(face))
+            .buildGraphicsPipelineAsync(
+                mPipelineLayout->getHandle(),
+                mRenderPassResult->renderPass->getHandle(),
+                mRenderPassResult->pipelineNameToSubpassIndexMap["MainPipeline"]
+            );
+    }
+
+    void Application::createShaderHotReloader() {
+        if (!enableShaderHotReload) {
+            return;
+        }
+
+        mShaderHotReloader = ShaderHotReloader::create(mDevice);
+        mShaderHotReloader->addWatchDirectory("assets/shaders");
+
+        // 只有从文件加载的阶段会被重新编译，字符串源码的程序登记后不受影响
+        mShaderHotReloader->watchProgram(mShaderProgram);
+        for (const auto& program : mMultiMaterialShaders) {
+            mShaderHotReloader->watchProgram(program);
+        }
+        mShaderHotReloader->start();
+    }
+
+    void Application::applyShaderReloads() {
+        if (!mShaderHotReloader) {
+            return;
+        }
+
+        auto reloaded = mShaderHotReloader->applyPendingReloads();
+        if (reloaded.empty()) {
+            return;
+        }
+
+        // 基础管线同时是后备管线，着色器更新后同步重建，失败时保留旧管线
+        if (mGraphicsPipeline != VK_NULL_HANDLE &&
+            std::find(reloaded.begin(), reloaded.end(), mShaderProgram) != reloaded.end()) {
+            try {
+                VkPipeline pipeline = buildBasePipeline();
+                mRetiredPipelines.emplace_back(mGraphicsPipeline, mFrameCounter);
+                mGraphicsPipeline = pipeline;
+                mPipelineCache->setFallbackPipeline(mPipelineLayout->getHandle(), mGraphicsPipeline);
             }
             catch (const std::exception& e) {
-                std::cerr << "Failed to create pipeline for face " << i << ": " << e.what() << std::endl;
-                // 尝试使用默认管线
-                try {
-                    auto pipelineBuilder = std::make_shared<PipelineBuilder>(
-                        mDevice->getHandle(),
-                        mComponentRegistry
-                    );
-                    
-                    mMultiMaterialPipelines[i] = pipelineBuilder
-                        ->addComponent(PipelineComponentType::SHADER_STAGE, "BasicShader")
-                        .addComponent(PipelineComponentType::VERTEX_INPUT, "BasicVertex")
-                        .addComponent(PipelineComponentType::INPUT_ASSEMBLY, "TriangleList")
-                        .addComponent(PipelineComponentType::VIEWPORT_STATE, "Fullscreen")
-                        .addComponent(PipelineComponentType::RASTERIZATION, "Opaque")
-                        .addComponent(PipelineComponentType::MULTISAMPLE, "Default")
-                        .addComponent(PipelineComponentType::DEPTH_STENCIL, "Enabled")
-                        .addComponent(PipelineComponentType::COLOR_BLEND, "None")
-                        .addComponent(PipelineComponentType::DYNAMIC_STATE, "Basic")
-                        .buildGraphicsPipeline(
-                            mPipelineLayout->getHandle(),
-                            mRenderPassResult->renderPass->getHandle(),
-                            mRenderPassResult->pipelineNameToSubpassIndexMap["MainPipeline"]
-                        );
-                    
-                    std::cout << "Created default pipeline for face " << i << " as fallback" << std::endl;
-                } catch (const std::exception& e2) {
-                    std::cerr << "Failed to create fallback pipeline for face " << i << ": " << e2.what() << std::endl;
-                    throw;
+                std::cerr << "Failed to rebuild base graphics pipeline: " << e.what() << std::endl;
+            }
+        }
+
+        // 只重建使用了更新程序的管线，旧管线延迟到在途帧结束后销毁
+        for (int face = 0; face < static_cast<int>(mMultiMaterialPipelines.size()); face++) {
+            auto shaderComponent = std::dynamic_pointer_cast<ShaderStageComponent>(
+                mComponentRegistry->getComponent(PipelineComponentType::SHADER_STAGE, "CubeFaceShader" + std::to_string(face)));
+            if (!shaderComponent ||
+                std::find(reloaded.begin(), reloaded.end(), shaderComponent->getShaderProgram()) == reloaded.end()) {
+                continue;
+            }
+
+            // 后台编译，完成前继续使用旧管线绘制
+            try {
+                for (auto& pending : mPendingPipelines) {
+                    if (pending.first == face) {
+                        pending.first = -1;
+                    }
+                }
+                mPendingPipelines.emplace_back(face, buildMaterialPipelineAsync(face));
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Failed to rebuild pipeline for face " << face << ": " << e.what() << std::endl;
+            }
+        }
+    }
+
+    VkPipeline Application::buildBasePipeline() {
+        // 选择会累积，重建时先清空上一次的选择
+        return mPipelineBuilder
+            ->clearSelections()
+            .addComponent(PipelineComponentType::SHADER_STAGE, "CustomShader")
+            .addComponent(PipelineComponentType::VERTEX_INPUT, "BasicVertex")
+            .addComponent(PipelineComponentType::INPUT_ASSEMBLY, "TriangleList")
+            .addComponent(PipelineComponentType::VIEWPORT_STATE, "Fullscreen")
+            .addComponent(PipelineComponentType::RASTERIZATION, "Opaque")
+            .addComponent(PipelineComponentType::MULTISAMPLE, "Default")
+            .addComponent(PipelineComponentType::DEPTH_STENCIL, "Enabled")
+            .addComponent(PipelineComponentType::COLOR_BLEND, "None")
+            .addComponent(PipelineComponentType::DYNAMIC_STATE, "Basic")
+            .buildGraphicsPipeline(
+                mPipelineLayout->getHandle(),
+                mRenderPassResult->renderPass->getHandle(),
+                mRenderPassResult->pipelineNameToSubpassIndexMap["MainPipeline"]
+            );
+    }
+
+    void Application::applyPendingPipelines() {
+        auto it = mPendingPipelines.begin();
+        while (it != mPendingPipelines.end()) {
+            auto& [face, asyncPipeline] = *it;
+            if (asyncPipeline->isPending()) {
+                if (face >= 0) {
+                    VkPipeline interim = asyncPipeline->takeInterimPipeline();
+                    if (interim != VK_NULL_HANDLE) {
+                        if (mMultiMaterialPipelines[face] != VK_NULL_HANDLE) {
+                            mRetiredPipelines.emplace_back(mMultiMaterialPipelines[face], mFrameCounter);
+                        }
+                        mMultiMaterialPipelines[face] = interim;
+                    }
+                }
+                ++it;
+                continue;
+            }
+
+            if (face >= 0 && asyncPipeline->isReady()) {
+                if (mMultiMaterialPipelines[face] != VK_NULL_HANDLE) {
+                    mRetiredPipelines.emplace_back(mMultiMaterialPipelines[face], mFrameCounter);
                 }
+                mMultiMaterialPipelines[face] = asyncPipeline->takePipeline();
+                std::cout << "Pipeline ready for face " << face << std::endl;
             }
+            else if (face >= 0) {
+                std::cerr << "Failed to build pipeline for face " << face << ": "
+                    << asyncPipeline->getError() << std::endl;
+                // 首次编译失败时没有旧管线可用，改用默认管线
+                if (mMultiMaterialPipelines[face] == VK_NULL_HANDLE) {
+                    try {
+                        mMultiMaterialPipelines[face] = buildDefaultMaterialPipeline();
+                        std::cout << "Created default pipeline for face " << face << " as fallback" << std::endl;
+                    }
+                    catch (const std::exception& e) {
+                        std::cerr << "Failed to create fallback pipeline for face " << face << ": " << e.what() << std::endl;
+                    }
+                }
+            }
+            it = mPendingPipelines.erase(it);
         }
     }
 
+    void Application::destroyRetiredPipelines(bool force) {
+        auto it = mRetiredPipelines.begin();
+        while (it != mRetiredPipelines.end()) {
+            if (force || mFrameCounter - it->second >= MAX_FRAMES_IN_FLIGHT) {
+                PipelineBuilder::releasePipeline(mDevice->getHandle(), it->first);
+                it = mRetiredPipelines.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
 
     void Application::registerDefaultComponents() {
         mComponentRegistry = std::make_shared<ComponentRegistry>();
@@ -550,7 +1021,7 @@ namespace StarryEngine {
 
         // 4. 视口状态组件
         auto fullscreenViewport = std::make_shared<ViewportComponent>("Fullscreen");
-        mComponentRegistry->registerComponent("Fullscreen", fullscreenViewport);
+        mFullscreenViewport = mComponentRegistry->registerComponent("Fullscreen", fullscreenViewport);
         mComponentRegistry->setDefaultComponent(PipelineComponentType::VIEWPORT_STATE, "Fullscreen");
 
         // 5. 光栅化组件
@@ -608,6 +1079,15 @@ namespace StarryEngine {
         auto noDynamic = std::make_shared<DynamicStateComponent>("None");
         mComponentRegistry->registerComponent("None", noDynamic);
 
+        // 扩展动态状态：光栅化、深度、混合等差异改为绘制时设置，材质之间不再因此产生新管线
+        if (mDevice->getOptionalFeatures().extendedDynamicState) {
+            auto extendedDynamic = std::make_shared<DynamicStateComponent>("Extended");
+            extendedDynamic->addViewportScissorStates()
+                .addLineWidthState()
+                .addExtendedDynamicStates(*mDevice);
+            mComponentRegistry->registerComponent("Extended", extendedDynamic);
+        }
+
         mComponentRegistry->setDefaultComponent(PipelineComponentType::DYNAMIC_STATE, "Basic");
     }
 
@@ -695,10 +1175,12 @@ namespace StarryEngine {
 
         mDescriptorManager = std::make_shared<DescriptorManager>(mDevice);
 
-        // 定义描述符集布局 - set 0只有一个binding用于矩阵
-        mDescriptorManager->beginSetLayout(0);
-        mDescriptorManager->addUniformBuffer(0, VK_SHADER_STAGE_VERTEX_BIT, 1);
-        mDescriptorManager->endSetLayout();
+        // 描述符集布局由着色器反射生成（所有面共用同一个顶点着色器，合并全部程序的阶段）
+        ShaderReflection reflection;
+        for (const auto& program : mMultiMaterialShaders) {
+            reflection.merge(ShaderReflection::reflect(*program));
+        }
+        reflection.configureDescriptorManager(*mDescriptorManager);
 
         // 分配描述符集
         mDescriptorManager->allocateSets(MAX_FRAMES_IN_FLIGHT);
@@ -758,29 +1240,20 @@ namespace StarryEngine {
             auto descriptorSetLayouts = mDescriptorManager->getLayoutHandles();
 
             // 5. 创建管线布局
-            mPipelineLayout = PipelineLayout::create(
-                mDevice,
-                descriptorSetLayouts
-            );
+            mPipelineLayout = mLayoutCache->getPipelineLayout(descriptorSetLayouts);
+
+            // 预缓存清单按名称和兼容性哈希引用布局与渲染通道
+            mPipelinePrecache->registerPipelineLayout("Main", mPipelineLayout->getHandle());
+            mPipelinePrecache->registerRenderPass(mRenderPassResult->renderPass->getHandle());
+            mPipelinePrecache->registerPreset("DefaultMaterial", DEFAULT_MATERIAL_PRESET);
 
             // 创建基础管线（可选，我们主要用多材质管线）
             try {
-                mGraphicsPipeline = mPipelineBuilder
-                    ->addComponent(PipelineComponentType::SHADER_STAGE, "CustomShader")
-                    .addComponent(PipelineComponentType::VERTEX_INPUT, "BasicVertex")
-                    .addComponent(PipelineComponentType::INPUT_ASSEMBLY, "TriangleList")
-                    .addComponent(PipelineComponentType::VIEWPORT_STATE, "Fullscreen")
-                    .addComponent(PipelineComponentType::RASTERIZATION, "Opaque")
-                    .addComponent(PipelineComponentType::MULTISAMPLE, "Default")
-                    .addComponent(PipelineComponentType::DEPTH_STENCIL, "Enabled")
-                    .addComponent(PipelineComponentType::COLOR_BLEND, "None")
-                    .addComponent(PipelineComponentType::DYNAMIC_STATE, "Basic")
-                    .buildGraphicsPipeline(
-                        mPipelineLayout->getHandle(),
-                        mRenderPassResult->renderPass->getHandle(),
-                        mRenderPassResult->pipelineNameToSubpassIndexMap["MainPipeline"]
-                    );
+                mGraphicsPipeline = buildBasePipeline();
                 std::cout << "Created base graphics pipeline" << std::endl;
+
+                // 同布局的异步管线编译完成前用基础管线绘制
+                mPipelineCache->setFallbackPipeline(mPipelineLayout->getHandle(), mGraphicsPipeline);
             } catch (const std::exception& e) {
                 std::cerr << "Failed to create base graphics pipeline: " << e.what() << std::endl;
                 mGraphicsPipeline = VK_NULL_HANDLE; // 这不是关键错误
@@ -836,9 +1309,7 @@ namespace StarryEngine {
 
         context.beginRenderPass(&passBeginInfo.getRenderPassBeginInfo(), VK_SUBPASS_CONTENTS_INLINE);
 
-        auto viewport = std::dynamic_pointer_cast<ViewportComponent>(
-            mComponentRegistry->getComponent(PipelineComponentType::VIEWPORT_STATE, "Fullscreen")
-        );
+        auto* viewport = mComponentRegistry->get(mFullscreenViewport);
         context.setViewport(viewport->getViewports()[0]);
         context.setScissor(viewport->getScissors()[0]);
 
@@ -854,11 +1325,23 @@ namespace StarryEngine {
             
             // 绘制立方体，每个面使用不同的管线
             for (int face = 0; face < 6; face++) {
-                if (face < mMultiMaterialPipelines.size() && 
-                    mMultiMaterialPipelines[face] != VK_NULL_HANDLE) {
+                const AsyncPipeline* pendingPipeline = nullptr;
+                if (static_cast<size_t>(face) < mMultiMaterialPipelines.size() &&
+                    mMultiMaterialPipelines[face] == VK_NULL_HANDLE) {
+                    pendingPipeline = findPendingPipeline(face);
+                }
+
+                if (static_cast<size_t>(face) < mMultiMaterialPipelines.size() &&
+                    (mMultiMaterialPipelines[face] != VK_NULL_HANDLE || pendingPipeline)) {
                     
-                    // 绑定这个面的管线
-                    context.bindGraphicsPipeline(mMultiMaterialPipelines[face]);
+                    // 绑定这个面的管线；仍在编译时绑定后备管线，没有后备管线则跳过这个面的绘制
+                    if (pendingPipeline) {
+                        context.bindGraphicsPipeline(*pendingPipeline);
+                    }
+                    else {
+                        context.bindGraphicsPipeline(mMultiMaterialPipelines[face]);
+                    }
+                    applyMaterialDynamicState(context, face);
                     
                     // 绑定描述符集（矩阵）
                     context.bindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, 
@@ -883,6 +1366,13 @@ namespace StarryEngine {
 
     void Application::drawFrame() {
         mRenderer->getBackendAs<VulkanBackend>()->beginFrame();
+        mFrameCounter++;
+
+        // 帧边界：回收旧管线并应用已编译完成的着色器
+        destroyRetiredPipelines();
+        applyShaderReloads();
+        applyPendingPipelines();
+
         uint32_t frameIndex = mRenderer->getBackendAs<VulkanBackend>()->getCurrentFrameIndex();
         uint32_t imageIndex = mRenderer->getBackendAs<VulkanBackend>()->getCurrentImageIndex();
         updateUniformBuffer(frameIndex);
@@ -945,17 +1435,52 @@ namespace StarryEngine {
     void Application::cleanup() {
         cleanupSwapchain();
 
+        if (mShaderHotReloader) {
+            mShaderHotReloader->stop();
+            mShaderHotReloader.reset();
+        }
+        for (auto& [face, asyncPipeline] : mPendingPipelines) {
+            asyncPipeline->wait();
+        }
+        mPendingPipelines.clear();
+        destroyRetiredPipelines(true);
+
+        if (auto shaderCache = ShaderUtils::GetShaderCache()) {
+            if (enableCacheStats) {
+                auto stats = shaderCache->getStats();
+                std::cout << "Shader cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+                    << stats.entryCount << " entries (" << stats.totalBytes << " bytes)" << std::endl;
+            }
+            ShaderUtils::SetShaderCache(nullptr);
+        }
+        ShaderUtils::SetShaderPack(nullptr);
+
+        // 统计信息只在调试构建输出；注册表不存在时不为此创建
+        if (enableCacheStats) {
+            if (auto includeResolver = ShaderUtils::GetIncludeResolver()) {
+                auto stats = includeResolver->getStats();
+                std::cout << "Shader includes: " << stats.reads << " file reads, " << stats.hits
+                    << " cached, " << stats.cachedFiles << " files" << std::endl;
+            }
+            if (auto moduleRegistry = ShaderModuleRegistry::find(mDevice->getHandle())) {
+                auto moduleStats = moduleRegistry->getStats();
+                std::cout << "Shader modules: " << moduleStats.created << " created, " << moduleStats.reused
+                    << " reused, " << moduleStats.liveModules << " live" << std::endl;
+            }
+        }
+
         // 清理多材质管线
         for (auto& pipeline : mMultiMaterialPipelines) {
-            if (pipeline != VK_NULL_HANDLE) {
-                vkDestroyPipeline(mDevice->getHandle(), pipeline, nullptr);
-            }
+            PipelineBuilder::releasePipeline(mDevice->getHandle(), pipeline);
         }
         mMultiMaterialPipelines.clear();
 
         // 清理基础管线
         if (mGraphicsPipeline != VK_NULL_HANDLE) {
-            vkDestroyPipeline(mDevice->getHandle(), mGraphicsPipeline, nullptr);
+            if (mPipelineCache) {
+                mPipelineCache->setFallbackPipeline(mPipelineLayout->getHandle(), VK_NULL_HANDLE);
+            }
+            PipelineBuilder::releasePipeline(mDevice->getHandle(), mGraphicsPipeline);
             mGraphicsPipeline = VK_NULL_HANDLE;
         }
         
@@ -963,6 +1488,63 @@ namespace StarryEngine {
             mPipelineLayout.reset();
         }
 
+        mBindlessTable.reset();
+
+        if (mLayoutCache) {
+            if (enableCacheStats) {
+                auto layoutStats = mLayoutCache->getStats();
+                std::cout << "Layouts: " << layoutStats.setLayoutsCreated << " set layouts created, "
+                    << layoutStats.setLayoutsReused << " reused; " << layoutStats.pipelineLayoutsCreated
+                    << " pipeline layouts created, " << layoutStats.pipelineLayoutsReused << " reused" << std::endl;
+            }
+            mLayoutCache->cleanup();
+            mLayoutCache.reset();
+        }
+
+        if (mPipelineLibrary) {
+            if (enableCacheStats) {
+                auto libraryStats = mPipelineLibrary->getStats();
+                std::cout << "Pipeline library: " << libraryStats.partsCreated << " parts created, "
+                    << libraryStats.partsReused << " reused, " << libraryStats.fastLinks << " fast links, "
+                    << libraryStats.optimizedLinks << " optimized links" << std::endl;
+            }
+            mPipelineLibrary.reset();
+        }
+
+        if (mPipelinePrecache) {
+            if (enableCacheStats) {
+                std::cout << "Pipeline precache: " << mPipelinePrecache->getEntryCount() << " manifest entries" << std::endl;
+            }
+            if (!mPipelinePrecache->save()) {
+                std::cerr << "Failed to save pipeline manifest" << std::endl;
+            }
+            mPipelinePrecache->cleanup();
+            mPipelinePrecache.reset();
+        }
+
+        if (mPipelineFeedback) {
+            if (enableCacheStats) {
+                std::cout << "Pipeline feedback: " << mPipelineFeedback->getRecordCount() << " creations recorded"
+                    << (mPipelineFeedback->isFeedbackSupported() ? "" : " (driver feedback unavailable)") << std::endl;
+            }
+            if (!mPipelineFeedback->writeJson("cache/pipeline_feedback.json")) {
+                std::cerr << "Failed to write pipeline feedback" << std::endl;
+            }
+            mPipelineFeedback.reset();
+        }
+
+        if (mPipelineCache) {
+            if (enableCacheStats) {
+                auto pipelineStats = mPipelineCache->getSharedPipelineStats();
+                std::cout << "Pipelines: " << pipelineStats.created << " created, " << pipelineStats.reused
+                    << " reused, " << pipelineStats.livePipelines << " live" << std::endl;
+            }
+            if (!mPipelineCache->save()) {
+                std::cerr << "Failed to save pipeline cache" << std::endl;
+            }
+            mPipelineCache.reset();
+        }
+
         // 清理多材质资源
         mMultiMaterialVAO.reset();
         mMultiMaterialIBO.reset();
@@ -971,6 +1553,7 @@ namespace StarryEngine {
             program.reset();
         }
         mMultiMaterialShaders.clear();
+        mMaterialShaderVariants.reset();
 
         // 清理uniform buffers
         mMatrixUniformBuffers.clear();
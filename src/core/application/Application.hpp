@@ -16,12 +16,21 @@
 #include "../../renderer/backends/vulkan/renderPass/RenderPassBeginInfo.hpp" 
 #include "../../renderer/backends/vulkan/pipeline/Pipeline.hpp"
 #include "../../renderer/backends/vulkan/pipeline/NewPipelineBuilder.hpp"
+#include "../../renderer/backends/vulkan/pipeline/PipelineCache.hpp"
+#include "../../renderer/backends/vulkan/pipeline/LayoutCache.hpp"
+#include "../../renderer/backends/vulkan/descriptor/BindlessTable.hpp"
+#include "../../renderer/backends/vulkan/pipeline/PipelineFeedback.hpp"
+#include "../../renderer/backends/vulkan/pipeline/PipelinePrecache.hpp"
 
 #include "../../renderer/resource/models/mesh/Mesh.hpp"
 #include "../../renderer/resource/models/ModelLoader.hpp"
 #include "../../renderer/resource/models/geometry/shape/Cube.hpp"
 #include "../../renderer/resource/shaders/ShaderBuilder.hpp"
 #include "../../renderer/resource/shaders/ShaderProgram.hpp"
+#include "../../renderer/resource/shaders/ShaderObject.hpp"
+#include "../../renderer/resource/shaders/ShaderVariants.hpp"
+#include "../../renderer/resource/shaders/ShaderHotReloader.hpp"
+#include "../../renderer/resource/shaders/ShaderReflection.hpp"
 #include "../../renderer/resource/buffers/UniformBuffer.hpp"
 #include "../../renderer/resource/buffers/VertexArrayBuffer.hpp"
 #include "../../renderer/resource/buffers/IndexBuffer.hpp"
@@ -59,6 +68,34 @@ namespace StarryEngine {
         void createMultiMaterialCube();
         void createMultipleShaders();
         void createMultiplePipelines();
+        std::vector<ComponentSelection> getMaterialSelections(int face) const;
+        std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>> getMaterialComponents(int face) const;
+        // 按名称解析每个面的材质组件句柄，之后每帧只按句柄访问
+        void resolveMaterialHandles();
+        // 扩展动态状态下，按面的材质组件录制光栅化/深度/混合等动态状态
+        void applyMaterialDynamicState(RenderContext& context, int face) const;
+        VkPipeline buildMaterialPipeline(int face);
+        AsyncPipeline::Ptr buildMaterialPipelineAsync(int face);
+        void applyPendingPipelines();
+        // 材质管线编译失败时使用的默认管线
+        VkPipeline buildDefaultMaterialPipeline();
+        // 基础管线（CustomShader），同布局的异步管线编译完成前作为后备管线
+        VkPipeline buildBasePipeline();
+        // 该面最新的编译中请求，没有时返回nullptr
+        const AsyncPipeline* findPendingPipeline(int face) const;
+        // 等待所有编译中的管线并应用结果（基准测试前调用）
+        void waitPendingPipelines();
+
+        // 对比整体管线与着色器对象的创建耗时和每次绘制的录制开销（设置STARRY_SHADER_OBJECT_BENCHMARK时运行）
+        void runShaderObjectBenchmark();
+
+        // 对比逐次构建写入结构与描述符更新模板的描述符集更新吞吐（设置STARRY_DESCRIPTOR_TEMPLATE_BENCHMARK时运行）
+        void runDescriptorTemplateBenchmark();
+
+        // 着色器热重载
+        void createShaderHotReloader();
+        void applyShaderReloads();
+        void destroyRetiredPipelines(bool force = false);
 
         // 组件注册方法
         void registerDefaultComponents();
@@ -97,6 +134,7 @@ namespace StarryEngine {
 
         // 着色器
         ShaderProgram::Ptr mShaderProgram;
+        ShaderHotReloader::Ptr mShaderHotReloader;
         Mesh mMesh;
         std::shared_ptr<ModelLoader> loader;
 
@@ -109,6 +147,12 @@ namespace StarryEngine {
         // 管线构建系统
         std::shared_ptr<ComponentRegistry> mComponentRegistry;
         std::shared_ptr<PipelineBuilder> mPipelineBuilder;
+        PipelineCache::Ptr mPipelineCache;  // 设备级管线缓存，持有强引用使其存活到退出
+        LayoutCache::Ptr mLayoutCache;  // 设备级布局缓存
+        BindlessTable::Ptr mBindlessTable;  // 设备支持描述符索引时非空
+        PipelineLibrary::Ptr mPipelineLibrary;  // 设备支持图形管线库时非空
+        PipelineFeedback::Ptr mPipelineFeedback;  // 管线创建记录，退出时写入JSON
+        PipelinePrecache::Ptr mPipelinePrecache;  // 管线键清单，退出时写入，启动时预建
 
         // 管线和布局
         VkPipeline mGraphicsPipeline = VK_NULL_HANDLE;
@@ -119,12 +163,27 @@ namespace StarryEngine {
         IndexBuffer::Ptr mMultiMaterialIBO;
         uint32_t mMultiMaterialIndexCount;
         std::vector<ShaderProgram::Ptr> mMultiMaterialShaders;
+        ShaderVariantLibrary::Ptr mMaterialShaderVariants;  // 各面片段着色器的关键字变体
         std::vector<VkPipeline> mMultiMaterialPipelines;
+
+        // 每帧访问的组件句柄（注册时取得，录制命令时不按名称查找）
+        struct MaterialComponentHandles {
+            ComponentHandle<DynamicStateComponent> dynamicState;
+            ComponentHandle<RasterizationComponent> rasterization;
+            ComponentHandle<DepthStencilComponent> depthStencil;
+            ComponentHandle<ColorBlendComponent> colorBlend;
+            ComponentHandle<InputAssemblyComponent> inputAssembly;
+            ComponentHandle<VertexInputComponent> vertexInput;
+        };
+        ComponentHandle<ViewportComponent> mFullscreenViewport;
+        std::array<MaterialComponentHandles, 6> mMaterialHandles;
+        // 被热重载替换的旧管线，等待在途帧结束后销毁
+        std::vector<std::pair<VkPipeline, uint64_t>> mRetiredPipelines;
+        // 在后台编译的材质管线：启动时的首次编译和热重载的重建（面索引为-1表示已被更新的请求取代）
+        // 有临时管线（管线库快速链接）时先换上临时管线，优化链接完成后再替换
+        std::vector<std::pair<int, AsyncPipeline::Ptr>> mPendingPipelines;
+        uint64_t mFrameCounter = 0;
         std::vector<std::vector<UniformBuffer::Ptr>> mMaterialColorBuffers;
-        
-        // 材质相关描述符
-        std::shared_ptr<DescriptorManager> mMaterialDescriptorManager;
-        std::shared_ptr<PipelineLayout> mMaterialPipelineLayout;
     };
 
 } // namespace StarryEngine
\ No newline at end of file
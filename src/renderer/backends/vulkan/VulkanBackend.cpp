@@ -1,5 +1,7 @@
 #define VMA_IMPLEMENTATION
 #include "VulkanBackend.hpp"
+#include "descriptor/BindlessTable.hpp"
+#include "descriptor/TransientDescriptorAllocator.hpp"
 
 
 namespace StarryEngine {
@@ -63,6 +65,14 @@ namespace StarryEngine {
         mCurrentFrameContext->inFlightFence->block();
         mCurrentFrameContext->inFlightFence->resetFence();
 
+        // 该帧的命令已执行完毕，临时描述符集整体回收
+        mCurrentFrameContext->transientDescriptors->reset();
+
+        // 无绑定资源表中延迟释放的槽位已不再被飞行中的帧引用时回收
+        if (auto bindless = BindlessTable::find(mVulkanCore->getLogicalDeviceHandle())) {
+            bindless->advanceFrame();
+        }
+
         // 获取交换链图像
         VkResult result = vkAcquireNextImageKHR(
             mVulkanCore->getLogicalDeviceHandle(),
@@ -90,6 +100,9 @@ namespace StarryEngine {
         // 开始命令缓冲区
         mCurrentFrameContext->mainCommandBuffer->reset();
         mCurrentFrameContext->mainCommandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        if (mCurrentFrameContext->renderContext) {
+            mCurrentFrameContext->renderContext->reset();
+        }
     }
 
     VkCommandBuffer VulkanBackend::getCommandBuffer() {
@@ -168,6 +181,7 @@ namespace StarryEngine {
             frame.imageAvailableSemaphore = Semaphore::create(mVulkanCore->getLogicalDevice());
             frame.renderFinishedSemaphore = Semaphore::create(mVulkanCore->getLogicalDevice());
             frame.inFlightFence = Fence::create(mVulkanCore->getLogicalDevice(), true);
+            frame.transientDescriptors = TransientDescriptorAllocator::create(mVulkanCore->getLogicalDevice());
             frame.mainCommandBuffer = CommandBuffer::create(
                 mVulkanCore->getLogicalDevice(),
                 mWindowContext->getCommandPool()
@@ -191,6 +205,8 @@ namespace StarryEngine {
             frame.imageAvailableSemaphore.reset();
             frame.renderFinishedSemaphore.reset();
             frame.inFlightFence.reset();
+            frame.renderContext.reset();
+            frame.transientDescriptors.reset();
             frame.mainCommandBuffer.reset();
         }
         mFrameContexts.clear();
@@ -0,0 +1,348 @@
+#include "BindlessTable.hpp"
+#include "../vulkanCore/VulkanCore.hpp"
+#include "../pipeline/LayoutCache.hpp"
+#include "../../../utils/Hash.hpp"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace StarryEngine {
+
+    namespace {
+        std::mutex sBindlessMutex;
+        std::unordered_map<VkDevice, std::weak_ptr<BindlessTable>> sBindlessTables;
+
+        uint64_t packHead(uint32_t slot, uint32_t tag) {
+            return (static_cast<uint64_t>(tag) << 32) | slot;
+        }
+        uint32_t headSlot(uint64_t head) { return static_cast<uint32_t>(head); }
+        uint32_t headTag(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+    }
+
+    // ==================== 槽位分配 ====================
+
+    BindlessTable::SlotAllocator::SlotAllocator(uint32_t capacity)
+        : mCapacity(capacity),
+        mNext(std::make_unique<std::atomic<uint32_t>[]>(capacity)),
+        mHead(packHead(END, 0)) {
+    }
+
+    uint32_t BindlessTable::SlotAllocator::allocate() {
+        // 优先复用空闲链表中的槽位
+        uint64_t head = mHead.load(std::memory_order_acquire);
+        while (headSlot(head) != END) {
+            const uint32_t slot = headSlot(head);
+            const uint32_t next = mNext[slot].load(std::memory_order_relaxed);
+            if (mHead.compare_exchange_weak(head, packHead(next, headTag(head) + 1),
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+                mLiveCount.fetch_add(1, std::memory_order_relaxed);
+                return slot;
+            }
+        }
+
+        // 链表为空：取一个从未使用过的槽位
+        uint32_t slot = mNextUnused.load(std::memory_order_relaxed);
+        while (slot < mCapacity) {
+            if (mNextUnused.compare_exchange_weak(slot, slot + 1, std::memory_order_relaxed)) {
+                mLiveCount.fetch_add(1, std::memory_order_relaxed);
+                return slot;
+            }
+        }
+        return INVALID_INDEX;
+    }
+
+    void BindlessTable::SlotAllocator::free(uint32_t slot) {
+        uint64_t head = mHead.load(std::memory_order_relaxed);
+        do {
+            mNext[slot].store(headSlot(head), std::memory_order_relaxed);
+        } while (!mHead.compare_exchange_weak(head, packHead(slot, headTag(head) + 1),
+            std::memory_order_release, std::memory_order_relaxed));
+        mLiveCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // ==================== 资源表 ====================
+
+    BindlessTable::Ptr BindlessTable::acquire(const LogicalDevice::Ptr& logicalDevice) {
+        return acquire(logicalDevice, Config{});
+    }
+
+    BindlessTable::Ptr BindlessTable::acquire(const LogicalDevice::Ptr& logicalDevice, const Config& config) {
+        if (!logicalDevice->getOptionalFeatures().descriptorIndexing) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(sBindlessMutex);
+        auto& weak = sBindlessTables[logicalDevice->getHandle()];
+        if (auto table = weak.lock()) {
+            return table;
+        }
+        auto table = std::make_shared<BindlessTable>(logicalDevice, config);
+        weak = table;
+        return table;
+    }
+
+    BindlessTable::Ptr BindlessTable::find(VkDevice device) {
+        std::lock_guard<std::mutex> lock(sBindlessMutex);
+        auto it = sBindlessTables.find(device);
+        return it != sBindlessTables.end() ? it->second.lock() : nullptr;
+    }
+
+    BindlessTable::BindlessTable(const LogicalDevice::Ptr& logicalDevice, const Config& config)
+        : mLogicalDevice(logicalDevice) {
+        // 容量受绑定后更新池的设备限制约束
+        VkPhysicalDeviceDescriptorIndexingProperties indexingProperties{};
+        indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+        VkPhysicalDeviceProperties2 properties{};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &indexingProperties;
+        vkGetPhysicalDeviceProperties2(logicalDevice->getPhysicalDevice()->getHandle(), &properties);
+
+        const std::array<uint32_t, static_cast<size_t>(Binding::Count)> capacities = {
+            std::min({ config.maxSampledImages,
+                indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+                indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages }),
+            std::min({ config.maxSamplers,
+                indexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+                indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers }),
+            std::min({ config.maxStorageBuffers,
+                indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers }),
+        };
+        const std::array<VkDescriptorType, static_cast<size_t>(Binding::Count)> types = {
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            VK_DESCRIPTOR_TYPE_SAMPLER,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        };
+
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        std::vector<VkDescriptorBindingFlags> bindingFlags;
+        std::vector<VkDescriptorPoolSize> poolSizes;
+        for (uint32_t i = 0; i < capacities.size(); ++i) {
+            if (capacities[i] == 0) {
+                throw std::runtime_error("BindlessTable: device reports no update-after-bind descriptors");
+            }
+            VkDescriptorSetLayoutBinding binding{};
+            binding.binding = i;
+            binding.descriptorType = types[i];
+            binding.descriptorCount = capacities[i];
+            binding.stageFlags = VK_SHADER_STAGE_ALL;
+            bindings.push_back(binding);
+            bindingFlags.push_back(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT);
+            poolSizes.push_back({ types[i], capacities[i] });
+            mSlots[i] = std::make_unique<SlotAllocator>(capacities[i]);
+        }
+
+        mLayout = LayoutCache::acquire(logicalDevice)->getDescriptorSetLayout(
+            bindings, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT, bindingFlags);
+        mPool = DescriptorPool::create(logicalDevice, poolSizes, 1,
+            VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT);
+
+        VkDescriptorSetLayout layout = mLayout->getHandle();
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = mPool->getHandle();
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
+        if (vkAllocateDescriptorSets(logicalDevice->getHandle(), &allocInfo, &mDescriptorSet) != VK_SUCCESS) {
+            throw std::runtime_error("BindlessTable: failed to allocate descriptor set");
+        }
+
+        std::cout << "Bindless table: " << capacities[0] << " images, " << capacities[1] << " samplers, "
+            << capacities[2] << " storage buffers" << std::endl;
+    }
+
+    BindlessTable::~BindlessTable() {
+        // 共享采样器（含尚在延迟回收中的）由本表销毁
+        for (const auto& [key, entry] : mSharedSamplers) {
+            vkDestroySampler(mLogicalDevice->getHandle(), entry.sampler, nullptr);
+        }
+        for (const auto& pending : mPendingReleases) {
+            if (pending.sampler != VK_NULL_HANDLE) {
+                vkDestroySampler(mLogicalDevice->getHandle(), pending.sampler, nullptr);
+            }
+        }
+        mSharedSamplers.clear();
+        mSharedSamplerKeys.clear();
+
+        // 描述符集随池一起销毁
+        mDescriptorSet = VK_NULL_HANDLE;
+        mPool.reset();
+    }
+
+    uint32_t BindlessTable::registerSampledImage(VkImageView imageView, VkImageLayout imageLayout) {
+        uint32_t index = mSlots[static_cast<size_t>(Binding::SampledImage)]->allocate();
+        if (index == INVALID_INDEX) {
+            std::cerr << "BindlessTable: sampled image array is full" << std::endl;
+            return INVALID_INDEX;
+        }
+
+        VkDescriptorImageInfo imageInfo{ VK_NULL_HANDLE, imageView, imageLayout };
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstBinding = static_cast<uint32_t>(Binding::SampledImage);
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        write.pImageInfo = &imageInfo;
+        writeDescriptor(write);
+        return index;
+    }
+
+    uint32_t BindlessTable::registerSampler(VkSampler sampler) {
+        uint32_t index = mSlots[static_cast<size_t>(Binding::Sampler)]->allocate();
+        if (index == INVALID_INDEX) {
+            std::cerr << "BindlessTable: sampler array is full" << std::endl;
+            return INVALID_INDEX;
+        }
+
+        VkDescriptorImageInfo imageInfo{ sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED };
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstBinding = static_cast<uint32_t>(Binding::Sampler);
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+        write.pImageInfo = &imageInfo;
+        writeDescriptor(write);
+        return index;
+    }
+
+    uint32_t BindlessTable::registerStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+        uint32_t index = mSlots[static_cast<size_t>(Binding::StorageBuffer)]->allocate();
+        if (index == INVALID_INDEX) {
+            std::cerr << "BindlessTable: storage buffer array is full" << std::endl;
+            return INVALID_INDEX;
+        }
+
+        VkDescriptorBufferInfo bufferInfo{ buffer, offset, range };
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstBinding = static_cast<uint32_t>(Binding::StorageBuffer);
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = &bufferInfo;
+        writeDescriptor(write);
+        return index;
+    }
+
+    uint64_t BindlessTable::hashSamplerInfo(const VkSamplerCreateInfo& createInfo) {
+        return Hasher()
+            .add(createInfo.flags)
+            .add(createInfo.magFilter).add(createInfo.minFilter).add(createInfo.mipmapMode)
+            .add(createInfo.addressModeU).add(createInfo.addressModeV).add(createInfo.addressModeW)
+            .add(createInfo.mipLodBias)
+            .add(createInfo.anisotropyEnable).add(createInfo.maxAnisotropy)
+            .add(createInfo.compareEnable).add(createInfo.compareOp)
+            .add(createInfo.minLod).add(createInfo.maxLod)
+            .add(createInfo.borderColor).add(createInfo.unnormalizedCoordinates)
+            .get();
+    }
+
+    BindlessTable::SharedSampler BindlessTable::acquireSampler(const VkSamplerCreateInfo& createInfo) {
+        // 扩展结构无法按值比较，不参与共享
+        if (createInfo.pNext != nullptr) {
+            return {};
+        }
+
+        const uint64_t key = hashSamplerInfo(createInfo);
+        std::lock_guard<std::mutex> lock(mSamplerMutex);
+        auto it = mSharedSamplers.find(key);
+        if (it != mSharedSamplers.end()) {
+            it->second.refCount++;
+            return { it->second.sampler, it->second.index };
+        }
+
+        VkSampler sampler = VK_NULL_HANDLE;
+        if (vkCreateSampler(mLogicalDevice->getHandle(), &createInfo, nullptr, &sampler) != VK_SUCCESS) {
+            std::cerr << "BindlessTable: failed to create shared sampler" << std::endl;
+            return {};
+        }
+        const uint32_t index = registerSampler(sampler);
+        if (index == INVALID_INDEX) {
+            vkDestroySampler(mLogicalDevice->getHandle(), sampler, nullptr);
+            return {};
+        }
+
+        mSharedSamplers[key] = { sampler, index, 1 };
+        mSharedSamplerKeys[index] = key;
+        return { sampler, index };
+    }
+
+    void BindlessTable::releaseSampler(uint32_t index) noexcept {
+        if (index == INVALID_INDEX) {
+            return;
+        }
+        try {
+            VkSampler sampler = VK_NULL_HANDLE;
+            {
+                std::lock_guard<std::mutex> lock(mSamplerMutex);
+                auto keyIt = mSharedSamplerKeys.find(index);
+                if (keyIt == mSharedSamplerKeys.end()) {
+                    return;
+                }
+                auto it = mSharedSamplers.find(keyIt->second);
+                if (--it->second.refCount > 0) {
+                    return;
+                }
+                sampler = it->second.sampler;
+                mSharedSamplers.erase(it);
+                mSharedSamplerKeys.erase(keyIt);
+            }
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            mPendingReleases.push_back({ Binding::Sampler, index, mFrame, sampler });
+        }
+        catch (...) {
+            // 记录失败时槽位和采样器泄漏，不影响正确性
+        }
+    }
+
+    void BindlessTable::writeDescriptor(VkWriteDescriptorSet& write) {
+        write.dstSet = mDescriptorSet;
+        std::lock_guard<std::mutex> lock(mMutex);
+        vkUpdateDescriptorSets(mLogicalDevice->getHandle(), 1, &write, 0, nullptr);
+    }
+
+    void BindlessTable::release(Binding binding, uint32_t index) noexcept {
+        if (index == INVALID_INDEX || binding >= Binding::Count) {
+            return;
+        }
+        try {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mPendingReleases.push_back({ binding, index, mFrame });
+        }
+        catch (...) {
+            // 记录失败时槽位泄漏，不影响正确性
+        }
+    }
+
+    void BindlessTable::advanceFrame() {
+        std::vector<PendingRelease> ready;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFrame++;
+            auto split = std::partition(mPendingReleases.begin(), mPendingReleases.end(),
+                [this](const PendingRelease& pending) { return pending.frame + MAX_FRAMES_IN_FLIGHT > mFrame; });
+            ready.assign(split, mPendingReleases.end());
+            mPendingReleases.erase(split, mPendingReleases.end());
+        }
+        for (const auto& pending : ready) {
+            if (pending.sampler != VK_NULL_HANDLE) {
+                vkDestroySampler(mLogicalDevice->getHandle(), pending.sampler, nullptr);
+            }
+            mSlots[static_cast<size_t>(pending.binding)]->free(pending.index);
+        }
+    }
+
+    uint32_t BindlessTable::getCapacity(Binding binding) const {
+        return mSlots[static_cast<size_t>(binding)]->getCapacity();
+    }
+
+    uint32_t BindlessTable::getLiveCount(Binding binding) const {
+        return mSlots[static_cast<size_t>(binding)]->getLiveCount();
+    }
+
+} // namespace StarryEngine
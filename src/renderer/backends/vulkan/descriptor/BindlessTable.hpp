@@ -0,0 +1,138 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include "../vulkanCore/LogicalDevice.hpp"
+#include "DescriptorPool.hpp"
+#include "DescriptorSetLayout.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace StarryEngine {
+
+    // 无绑定资源表：一个描述符集中包含采样图像、采样器和存储缓冲三个大数组
+    // 数组为绑定后可更新、部分绑定，资源创建时分配槽位并写入，着色器按整数索引访问
+    // 整帧只绑定一次，切换材质不再需要切换描述符集（见assets/shaders/common/bindless.glsl）
+    class BindlessTable {
+    public:
+        using Ptr = std::shared_ptr<BindlessTable>;
+
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        // 数组在描述符集中的绑定号
+        enum class Binding : uint32_t {
+            SampledImage = 0,
+            Sampler = 1,
+            StorageBuffer = 2,
+            Count
+        };
+
+        // 各数组的容量上限（实际容量不超过设备的绑定后更新限制）
+        struct Config {
+            uint32_t maxSampledImages = 16384;
+            uint32_t maxSamplers = 1024;
+            uint32_t maxStorageBuffers = 16384;
+        };
+
+        // 获取设备对应的资源表（同一设备返回同一实例）；设备未启用描述符索引时返回nullptr
+        static Ptr acquire(const LogicalDevice::Ptr& logicalDevice);
+        static Ptr acquire(const LogicalDevice::Ptr& logicalDevice, const Config& config);
+
+        // 查找设备已有的资源表，不存在时返回nullptr
+        static Ptr find(VkDevice device);
+
+        BindlessTable(const LogicalDevice::Ptr& logicalDevice, const Config& config);
+        ~BindlessTable();
+
+        BindlessTable(const BindlessTable&) = delete;
+        BindlessTable& operator=(const BindlessTable&) = delete;
+
+        // 分配槽位并写入描述符，数组已满时返回INVALID_INDEX；线程安全
+        uint32_t registerSampledImage(VkImageView imageView,
+            VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        uint32_t registerSampler(VkSampler sampler);
+        uint32_t registerStorageBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+
+        // 共享采样器：按创建参数去重，相同参数的纹理共用同一个采样器和槽位
+        // 采样器由本表创建和销毁，调用方不得销毁；失败时返回{VK_NULL_HANDLE, INVALID_INDEX}
+        struct SharedSampler {
+            VkSampler sampler = VK_NULL_HANDLE;
+            uint32_t index = INVALID_INDEX;
+        };
+        SharedSampler acquireSampler(const VkSamplerCreateInfo& createInfo);
+        // 引用计数归零后与release()一样延迟回收槽位，并销毁采样器
+        void releaseSampler(uint32_t index) noexcept;
+
+        // 释放槽位：飞行中的帧可能仍在读取，advanceFrame()经过MAX_FRAMES_IN_FLIGHT帧后才可复用
+        void release(Binding binding, uint32_t index) noexcept;
+
+        // 帧边界（该帧围栏信号后）调用，回收已不被任何飞行帧引用的槽位
+        void advanceFrame();
+
+        VkDescriptorSetLayout getLayout() const { return mLayout->getHandle(); }
+        const DescriptorSetLayout::Ptr& getLayoutObject() const { return mLayout; }
+        VkDescriptorSet getDescriptorSet() const { return mDescriptorSet; }
+
+        uint32_t getCapacity(Binding binding) const;
+        uint32_t getLiveCount(Binding binding) const;
+
+    private:
+        // 无锁槽位分配：空闲链表（带版本号的栈顶防止ABA）加上从未使用过的槽位的递增计数
+        class SlotAllocator {
+        public:
+            explicit SlotAllocator(uint32_t capacity);
+
+            uint32_t allocate();
+            void free(uint32_t slot);
+
+            uint32_t getCapacity() const { return mCapacity; }
+            uint32_t getLiveCount() const { return mLiveCount.load(std::memory_order_relaxed); }
+
+        private:
+            static constexpr uint32_t END = UINT32_MAX;
+
+            uint32_t mCapacity;
+            std::unique_ptr<std::atomic<uint32_t>[]> mNext;
+            std::atomic<uint64_t> mHead;          // 低32位为槽位，高32位为版本号
+            std::atomic<uint32_t> mNextUnused{ 0 };
+            std::atomic<uint32_t> mLiveCount{ 0 };
+        };
+
+        struct PendingRelease {
+            Binding binding;
+            uint32_t index;
+            uint64_t frame;
+            VkSampler sampler = VK_NULL_HANDLE;  // 共享采样器随槽位一起销毁
+        };
+
+        struct SharedSamplerEntry {
+            VkSampler sampler = VK_NULL_HANDLE;
+            uint32_t index = INVALID_INDEX;
+            uint32_t refCount = 0;
+        };
+
+        static uint64_t hashSamplerInfo(const VkSamplerCreateInfo& createInfo);
+
+        void writeDescriptor(VkWriteDescriptorSet& write);
+
+        LogicalDevice::Ptr mLogicalDevice;
+        DescriptorSetLayout::Ptr mLayout;
+        DescriptorPool::Ptr mPool;
+        VkDescriptorSet mDescriptorSet = VK_NULL_HANDLE;
+
+        std::array<std::unique_ptr<SlotAllocator>, static_cast<size_t>(Binding::Count)> mSlots;
+
+        // vkUpdateDescriptorSets写同一描述符集须外部同步；延迟释放列表也由它保护
+        std::mutex mMutex;
+        std::vector<PendingRelease> mPendingReleases;
+        uint64_t mFrame = 0;
+
+        // 共享采样器：创建参数哈希 -> 采样器，槽位 -> 创建参数哈希
+        std::mutex mSamplerMutex;
+        std::unordered_map<uint64_t, SharedSamplerEntry> mSharedSamplers;
+        std::unordered_map<uint32_t, uint64_t> mSharedSamplerKeys;
+    };
+
+} // namespace StarryEngine
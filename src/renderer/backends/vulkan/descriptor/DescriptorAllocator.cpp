@@ -2,6 +2,7 @@
 #include "../vulkanCore/VulkanCore.hpp"
 #include <stdexcept>
 #include <algorithm>
+#include <iostream>
 
 namespace StarryEngine {
 
@@ -10,25 +11,18 @@ namespace StarryEngine {
     }
 
     DescriptorAllocator::~DescriptorAllocator() {
-        // 清理所有分配的描述符集
-        for (auto set : mAllocatedSets) {
-            auto pool = findPoolForSet(set);
-            if (pool != VK_NULL_HANDLE) {
-                vkFreeDescriptorSets(mLogicalDevice->getHandle(), pool, 1, &set);
-            }
-        }
-        mAllocatedSets.clear();
-        mSetToPoolMap.clear();
+        // 销毁池时其中的描述符集一并释放
+        mSetToPool.clear();
+        mReusablePools.clear();
         mPools.clear();
     }
 
     void DescriptorAllocator::initialize(const DescriptorTracker& requirements) {
-        auto poolSizes = requirements.getPoolSizes();
-        uint32_t maxSets = requirements.getTotalSetCount();
+        mRatios.merge(requirements);
+        mNextPoolSets = std::clamp(std::max(mNextPoolSets, requirements.getTotalSetCount()), 1u, MAX_POOL_SETS);
 
-        if (!poolSizes.empty() && maxSets > 0) {
-            auto pool = createPool(poolSizes, maxSets, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT);
-            mPools.push_back(pool);  
+        if (mCurrentPool == NO_POOL && requirements.getTotalSetCount() > 0) {
+            growPool(0, nullptr);
         }
     }
 
@@ -37,11 +31,29 @@ namespace StarryEngine {
     }
 
     std::vector<VkDescriptorSet> DescriptorAllocator::allocate(VkDescriptorSetLayout layout, uint32_t count) {
+        return allocate(layout, count, nullptr);
+    }
+
+    VkDescriptorSet DescriptorAllocator::allocate(const std::shared_ptr<DescriptorSetLayout>& layout) {
+        return allocate(layout, 1)[0];
+    }
+
+    std::vector<VkDescriptorSet> DescriptorAllocator::allocate(
+        const std::shared_ptr<DescriptorSetLayout>& layout,
+        uint32_t count) {
+        auto bindings = layout->getBindings();
+        return allocate(layout->getHandle(), count, &bindings);
+    }
+
+    std::vector<VkDescriptorSet> DescriptorAllocator::allocate(
+        VkDescriptorSetLayout layout,
+        uint32_t count,
+        const std::vector<VkDescriptorSetLayoutBinding>* bindings) {
         if (count == 0) return {};
 
-        auto pool = findAvailablePool(layout, count);
-        if (!pool) {
-            throw std::runtime_error("No available pool for descriptor set allocation");
+        // 实际分配的布局决定后续新池的类型比例
+        if (bindings) {
+            mRatios.addLayout(*bindings, count);
         }
 
         std::vector<VkDescriptorSetLayout> layouts(count, layout);
@@ -49,50 +61,65 @@ namespace StarryEngine {
 
         VkDescriptorSetAllocateInfo allocInfo{};
         allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.descriptorPool = pool->getHandle();
         allocInfo.descriptorSetCount = count;
         allocInfo.pSetLayouts = layouts.data();
 
-        VkResult result = vkAllocateDescriptorSets(
-            mLogicalDevice->getHandle(),
-            &allocInfo,
-            descriptorSets.data()
-        );
+        uint32_t poolIndex = mCurrentPool;
+        bool freshPool = false;
+        while (true) {
+            if (poolIndex == NO_POOL) {
+                poolIndex = growPool(count, bindings);
+                freshPool = true;
+            }
 
-        if (result != VK_SUCCESS) {
-            throw std::runtime_error("Failed to allocate descriptor sets!");
+            allocInfo.descriptorPool = mPools[poolIndex].pool->getHandle();
+            VkResult result = vkAllocateDescriptorSets(
+                mLogicalDevice->getHandle(),
+                &allocInfo,
+                descriptorSets.data()
+            );
+
+            if (result == VK_SUCCESS) {
+                break;
+            }
+            if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL) {
+                throw std::runtime_error("Failed to allocate descriptor sets: VkResult = " + std::to_string(result));
+            }
+            if (freshPool) {
+                // 按本次请求创建的空池仍然放不下，换池无济于事
+                throw std::runtime_error("Failed to allocate descriptor sets: layout does not fit a new pool");
+            }
+            poolIndex = retireCurrentPool();
         }
 
         // 记录分配
+        mPools[poolIndex].liveSets += count;
         for (auto set : descriptorSets) {
-            mAllocatedSets.push_back(set);
-            mSetToPoolMap[set] = pool->getHandle();
+            mSetToPool[set] = poolIndex;
         }
 
         return descriptorSets;
     }
 
-    VkDescriptorSet DescriptorAllocator::allocate(const std::shared_ptr<DescriptorSetLayout>& layout) {
-        return allocate(layout->getHandle());
-    }
+    void DescriptorAllocator::free(VkDescriptorSet descriptorSet) {
+        auto it = mSetToPool.find(descriptorSet);
+        if (it == mSetToPool.end()) {
+            return;
+        }
+        const uint32_t poolIndex = it->second;
+        mSetToPool.erase(it);
 
-    std::vector<VkDescriptorSet> DescriptorAllocator::allocate(
-        const std::shared_ptr<DescriptorSetLayout>& layout,
-        uint32_t count) {
-        return allocate(layout->getHandle(), count);
-    }
+        auto& entry = mPools[poolIndex];
+        if (entry.freeable) {
+            vkFreeDescriptorSets(mLogicalDevice->getHandle(), entry.pool->getHandle(), 1, &descriptorSet);
+        }
+        entry.liveSets--;
 
-    void DescriptorAllocator::free(VkDescriptorSet descriptorSet) {
-        auto pool = findPoolForSet(descriptorSet);
-        if (pool != VK_NULL_HANDLE) {
-            vkFreeDescriptorSets(mLogicalDevice->getHandle(), pool, 1, &descriptorSet);
-
-            // 从记录中移除
-            mAllocatedSets.erase(
-                std::remove(mAllocatedSets.begin(), mAllocatedSets.end(), descriptorSet),
-                mAllocatedSets.end()
-            );
-            mSetToPoolMap.erase(descriptorSet);
+        // 退役池清空后重置，重新作为可用池
+        if (entry.retired && entry.liveSets == 0) {
+            vkResetDescriptorPool(mLogicalDevice->getHandle(), entry.pool->getHandle(), 0);
+            entry.retired = false;
+            mReusablePools.push_back(poolIndex);
         }
     }
 
@@ -103,17 +130,26 @@ namespace StarryEngine {
     }
 
     void DescriptorAllocator::reset() {
-        for (auto& pool : mPools) {
-            vkResetDescriptorPool(mLogicalDevice->getHandle(), pool->getHandle(), 0);
+        mReusablePools.clear();
+        if (mCurrentPool == NO_POOL && !mPools.empty()) {
+            mCurrentPool = 0;
+        }
+        for (uint32_t i = 0; i < mPools.size(); ++i) {
+            auto& entry = mPools[i];
+            vkResetDescriptorPool(mLogicalDevice->getHandle(), entry.pool->getHandle(), 0);
+            entry.liveSets = 0;
+            entry.retired = false;
+            if (i != mCurrentPool) {
+                mReusablePools.push_back(i);
+            }
         }
 
         // 清空分配记录
-        mAllocatedSets.clear();
-        mSetToPoolMap.clear();
+        mSetToPool.clear();
     }
 
     void DescriptorAllocator::addPool(const std::shared_ptr<DescriptorPool>& pool) {
-        mPools.push_back(pool);
+        addPoolEntry(pool, true);
     }
 
     void DescriptorAllocator::addPool(const DescriptorTracker& requirements, VkDescriptorPoolCreateFlags flags) {
@@ -122,8 +158,22 @@ namespace StarryEngine {
 
         if (!poolSizes.empty() && maxSets > 0) {
             auto pool = createPool(poolSizes, maxSets, flags);
-            mPools.push_back(pool); 
+            addPoolEntry(pool, (flags & VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT) != 0);
+        }
+    }
+
+    std::vector<std::shared_ptr<DescriptorPool>> DescriptorAllocator::getPools() const {
+        std::vector<std::shared_ptr<DescriptorPool>> pools;
+        pools.reserve(mPools.size());
+        for (const auto& entry : mPools) {
+            pools.push_back(entry.pool);
         }
+        return pools;
+    }
+
+    size_t DescriptorAllocator::getRetiredPoolCount() const {
+        return std::count_if(mPools.begin(), mPools.end(),
+            [](const PoolEntry& entry) { return entry.retired; });
     }
 
     // 私有方法实现
@@ -134,22 +184,66 @@ namespace StarryEngine {
         return DescriptorPool::create(mLogicalDevice, poolSizes, maxSets, flags);
     }
 
-    std::shared_ptr<DescriptorPool> DescriptorAllocator::findAvailablePool(VkDescriptorSetLayout layout, uint32_t count) {
-        // 简化实现：总是返回第一个池
-        // 实际项目中可以实现更复杂的池选择逻辑
-        if (mPools.empty()) {
-            // 如果没有池，创建一个默认池
-            DescriptorTracker defaultTracker;
-            defaultTracker.addBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 10, 10);
-            defaultTracker.addBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 10, 10);
-            initialize(defaultTracker);
+    uint32_t DescriptorAllocator::growPool(uint32_t count, const std::vector<VkDescriptorSetLayoutBinding>* bindings) {
+        if (mRatios.getTotalSetCount() == 0) {
+            // 还没有任何需求信息时使用默认比例
+            mRatios.addBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1);
+            mRatios.addBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1);
+        }
+        if (mNextPoolSets == 0) {
+            mNextPoolSets = 16;
         }
 
-        return mPools[0];
+        const uint32_t maxSets = std::max(mNextPoolSets, count);
+        auto poolSizes = mRatios.getPoolSizes(maxSets);
+
+        // 保证本次请求的布局本身能放进新池
+        if (bindings) {
+            for (const auto& binding : *bindings) {
+                const uint32_t required = binding.descriptorCount * count;
+                auto it = std::find_if(poolSizes.begin(), poolSizes.end(),
+                    [&binding](const VkDescriptorPoolSize& size) { return size.type == binding.descriptorType; });
+                if (it == poolSizes.end()) {
+                    poolSizes.push_back({ binding.descriptorType, required });
+                }
+                else {
+                    it->descriptorCount = std::max(it->descriptorCount, required);
+                }
+            }
+        }
+
+        auto pool = createPool(poolSizes, maxSets, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT);
+        mNextPoolSets = std::min(mNextPoolSets * 2, MAX_POOL_SETS);
+
+        mPools.push_back({ pool, 0, true, false });
+        mCurrentPool = static_cast<uint32_t>(mPools.size() - 1);
+        return mCurrentPool;
     }
 
-    VkDescriptorPool DescriptorAllocator::findPoolForSet(VkDescriptorSet set) const {
-        auto it = mSetToPoolMap.find(set);
-        return (it != mSetToPoolMap.end()) ? it->second : VK_NULL_HANDLE;
+    uint32_t DescriptorAllocator::retireCurrentPool() {
+        // 空池也放不下说明比例不适合该布局，移出轮换直到reset()
+        if (mCurrentPool != NO_POOL && mPools[mCurrentPool].liveSets > 0) {
+            mPools[mCurrentPool].retired = true;
+        }
+
+        // 后进先出：最近清空的池优先复用
+        mCurrentPool = NO_POOL;
+        if (!mReusablePools.empty()) {
+            mCurrentPool = mReusablePools.back();
+            mReusablePools.pop_back();
+        }
+        return mCurrentPool;
+    }
+
+    uint32_t DescriptorAllocator::addPoolEntry(const std::shared_ptr<DescriptorPool>& pool, bool freeable) {
+        mPools.push_back({ pool, 0, freeable, false });
+        const uint32_t index = static_cast<uint32_t>(mPools.size() - 1);
+        if (mCurrentPool == NO_POOL) {
+            mCurrentPool = index;
+        }
+        else {
+            mReusablePools.push_back(index);
+        }
+        return index;
     }
-}
\ No newline at end of file
+}
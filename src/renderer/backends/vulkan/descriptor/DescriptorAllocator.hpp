@@ -10,16 +10,22 @@
 namespace StarryEngine {
     class LogicalDevice;
 
+    // 描述符池链：当前池耗尽（OUT_OF_POOL_MEMORY / FRAGMENTED_POOL）时退役并换用新池
+    // 新池按几何级数增长，各类型数量按已分配布局的平均比例分配
+    // 退役池中的集合全部释放后重置并回到可用列表
     class DescriptorAllocator {
     public:
         using Ptr = std::shared_ptr<DescriptorAllocator>;
 
+        // 新池的集合数上限
+        static constexpr uint32_t MAX_POOL_SETS = 4096;
+
         DescriptorAllocator(const std::shared_ptr<LogicalDevice>& logicalDevice);
         ~DescriptorAllocator();
 
         // === 核心：分配管理 ===
 
-        // 初始化分配器
+        // 初始化分配器：记录类型比例和首个池的大小，没有可用池时立即创建
         void initialize(const DescriptorTracker& requirements);
 
         // 分配单个描述符集
@@ -28,7 +34,7 @@ namespace StarryEngine {
         // 批量分配描述符集
         std::vector<VkDescriptorSet> allocate(VkDescriptorSetLayout layout, uint32_t count);
 
-        // 使用 DescriptorSetLayout 类分配
+        // 使用 DescriptorSetLayout 类分配（布局的绑定会计入新池的类型比例）
         VkDescriptorSet allocate(const std::shared_ptr<DescriptorSetLayout>& layout);
         std::vector<VkDescriptorSet> allocate(const std::shared_ptr<DescriptorSetLayout>& layout, uint32_t count);
 
@@ -41,7 +47,7 @@ namespace StarryEngine {
 
         // === 池管理 ===
 
-        // 添加现有的池
+        // 添加现有的池（需以FREE_DESCRIPTOR_SET标志创建）
         void addPool(const std::shared_ptr<DescriptorPool>& pool);
 
         // 使用 DescriptorTracker 创建并添加新池
@@ -49,29 +55,54 @@ namespace StarryEngine {
 
         // 获取池信息
         std::shared_ptr<DescriptorPool> getDefaultPool() const {
-            return mPools.empty() ? nullptr : mPools[0];
+            return mCurrentPool < mPools.size() ? mPools[mCurrentPool].pool : nullptr;
         }
-        const std::vector<std::shared_ptr<DescriptorPool>>& getPools() const { return mPools; }
+        std::vector<std::shared_ptr<DescriptorPool>> getPools() const;
 
         // === 统计信息 ===
-        size_t getAllocatedSetCount() const { return mAllocatedSets.size(); }
+        size_t getAllocatedSetCount() const { return mSetToPool.size(); }
         size_t getPoolCount() const { return mPools.size(); }
+        size_t getRetiredPoolCount() const;
 
     private:
+        static constexpr uint32_t NO_POOL = UINT32_MAX;
+
+        struct PoolEntry {
+            std::shared_ptr<DescriptorPool> pool;
+            uint32_t liveSets = 0;
+            bool freeable = false;   // 以FREE_DESCRIPTOR_SET标志创建，可单独释放集合
+            bool retired = false;    // 已耗尽，不再用于新分配
+        };
+
+        std::vector<VkDescriptorSet> allocate(
+            VkDescriptorSetLayout layout,
+            uint32_t count,
+            const std::vector<VkDescriptorSetLayoutBinding>* bindings);
+
         std::shared_ptr<DescriptorPool> createPool(
             const std::vector<VkDescriptorPoolSize>& poolSizes,
             uint32_t maxSets,
             VkDescriptorPoolCreateFlags flags = 0);
 
-        std::shared_ptr<DescriptorPool> findAvailablePool(VkDescriptorSetLayout layout, uint32_t count = 1);
-        VkDescriptorPool findPoolForSet(VkDescriptorSet set) const;
+        // 按学到的比例创建下一个池并设为当前池，至少能容纳count个给定布局的集合
+        uint32_t growPool(uint32_t count, const std::vector<VkDescriptorSetLayoutBinding>* bindings);
+
+        // 当前池耗尽：退役并切换到可复用的池，没有时返回NO_POOL
+        uint32_t retireCurrentPool();
+
+        uint32_t addPoolEntry(const std::shared_ptr<DescriptorPool>& pool, bool freeable);
 
     private:
         std::shared_ptr<LogicalDevice> mLogicalDevice;
-        std::vector<std::shared_ptr<DescriptorPool>> mPools;
+        std::vector<PoolEntry> mPools;
+        uint32_t mCurrentPool = NO_POOL;
+        std::vector<uint32_t> mReusablePools;  // 未退役且非当前的池
+
+        // 新池的类型比例和大小
+        DescriptorTracker mRatios;
+        uint32_t mNextPoolSets = 0;
 
-        // 跟踪分配的描述符集和它们的池
-        std::unordered_map<VkDescriptorSet, VkDescriptorPool> mSetToPoolMap;
-        std::vector<VkDescriptorSet> mAllocatedSets;
+        // 描述符集到所在池下标，释放时O(1)查找
+        std::unordered_map<VkDescriptorSet, uint32_t> mSetToPool;
     };
-}
\ No newline at end of file
+}
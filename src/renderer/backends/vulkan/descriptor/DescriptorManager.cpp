@@ -1,5 +1,6 @@
 #include "DescriptorManager.hpp"
 #include "../vulkanCore/VulkanCore.hpp"
+#include "../pipeline/LayoutCache.hpp"
 #include <stdexcept>
 
 namespace StarryEngine {
@@ -24,6 +25,9 @@ namespace StarryEngine {
             }
         }
 
+        // 重建布局后旧模板不再适用
+        std::erase_if(mBatchTemplates, [setIndex](const BatchTemplate& entry) { return entry.setIndex == setIndex; });
+
         mLayouts[setIndex] = std::make_shared<DescriptorSetLayout>(mLogicalDevice);
         mCurrentSetIndex = setIndex;
         mIsBuildingLayout = true;
@@ -74,14 +78,24 @@ namespace StarryEngine {
         layout->addBinding(binding, VK_DESCRIPTOR_TYPE_SAMPLER, stageFlags, count);
     }
 
+    void DescriptorManager::addBinding(uint32_t binding, VkDescriptorType type, VkShaderStageFlags stageFlags, uint32_t count) {
+        if (!mIsBuildingLayout) {
+            throw std::runtime_error("Not currently building a layout. Call beginSetLayout() first.");
+        }
+
+        auto layout = getCurrentLayout();
+        layout->addBinding(binding, type, stageFlags, count);
+    }
+
     void DescriptorManager::endSetLayout() {
         if (!mIsBuildingLayout) {
             throw std::runtime_error("Not currently building a layout. Call beginSetLayout() first.");
         }
 
+        // 绑定相同的布局在设备内共享同一个句柄
         auto layout = getCurrentLayout();
         if (!layout->isBuilt()) {
-            layout->build();
+            mLayouts[mCurrentSetIndex] = LayoutCache::acquire(mLogicalDevice)->getDescriptorSetLayout(layout->getBindings());
         }
 
         mIsBuildingLayout = false;
@@ -202,7 +216,7 @@ namespace StarryEngine {
         validateFrameIndex(frameIndex);
 
         auto set = getDescriptorSet(setIndex, frameIndex);
-        mWriter->updateUniformBuffers(set, bindings, buffers, offsets, ranges);
+        mWriter->updateUniformBuffers(set, getBatchTemplate(setIndex, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, bindings), bindings, buffers, offsets, ranges);
     }
 
     void DescriptorManager::writeCombinedImageSamplerDescriptors(uint32_t setIndex, uint32_t frameIndex,
@@ -219,7 +233,7 @@ namespace StarryEngine {
         validateFrameIndex(frameIndex);
 
         auto set = getDescriptorSet(setIndex, frameIndex);
-        mWriter->updateCombinedImageSamplers(set, bindings, imageViews, samplers, imageLayouts);
+        mWriter->updateCombinedImageSamplers(set, getBatchTemplate(setIndex, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, bindings), bindings, imageViews, samplers, imageLayouts);
     }
 
     // === 批量更新所有帧 ===
@@ -367,6 +381,7 @@ namespace StarryEngine {
     void DescriptorManager::cleanup() {
         freeSets();
         mAllocator.reset();
+        mBatchTemplates.clear();
         mWriter.reset();
         mLayouts.clear();
         mRequirements.reset();
@@ -375,6 +390,21 @@ namespace StarryEngine {
 
     // === 私有方法 ===
 
+    VkDescriptorUpdateTemplate DescriptorManager::getBatchTemplate(uint32_t setIndex, VkDescriptorType type,
+        const std::vector<uint32_t>& bindings) {
+        VkDescriptorSetLayout layout = getLayout(setIndex);
+        for (const auto& entry : mBatchTemplates) {
+            if (entry.layout == layout && entry.type == type && entry.bindings == bindings) {
+                return entry.updateTemplate;
+            }
+        }
+
+        // 模板的生命周期仍由DescriptorWriter管理
+        VkDescriptorUpdateTemplate updateTemplate = mWriter->getBatchTemplate(layout, type, bindings);
+        mBatchTemplates.push_back({ setIndex, layout, type, bindings, updateTemplate });
+        return updateTemplate;
+    }
+
     void DescriptorManager::validateSetIndex(uint32_t setIndex) const {
         if (mLayouts.find(setIndex) == mLayouts.end()) {
             throw std::runtime_error("Set layout not found: " + std::to_string(setIndex));
@@ -25,6 +25,8 @@ namespace StarryEngine {
         void addStorageBuffer(uint32_t binding, VkShaderStageFlags stageFlags, uint32_t count = 1);
         void addImage(uint32_t binding, VkShaderStageFlags stageFlags, uint32_t count = 1);
         void addSampler(uint32_t binding, VkShaderStageFlags stageFlags, uint32_t count = 1);
+        // 通用绑定（反射生成布局时使用）
+        void addBinding(uint32_t binding, VkDescriptorType type, VkShaderStageFlags stageFlags, uint32_t count = 1);
         void endSetLayout();
 
         // === 分配阶段 ===
@@ -60,7 +62,7 @@ namespace StarryEngine {
 
         void updateSampler(uint32_t setIndex, uint32_t binding, uint32_t frameIndex, VkSampler sampler);
 
-        // 批量更新多个 Binding（同一帧）
+        // 批量更新多个 Binding（同一帧），通过该Set布局的缓存更新模板一次写入
         void writeUniformBufferDescriptors(uint32_t setIndex, uint32_t frameIndex,
             const std::vector<uint32_t>& bindings,
             const std::vector<VkBuffer>& buffers,
@@ -107,6 +109,15 @@ namespace StarryEngine {
             std::vector<VkDescriptorSet> descriptorSets;
         };
 
+        // 批量写入使用的更新模板，按（布局, 描述符类型, binding列表）缓存
+        struct BatchTemplate {
+            uint32_t setIndex;
+            VkDescriptorSetLayout layout;
+            VkDescriptorType type;
+            std::vector<uint32_t> bindings;
+            VkDescriptorUpdateTemplate updateTemplate;
+        };
+
     private:
         std::shared_ptr<LogicalDevice> mLogicalDevice;
         std::shared_ptr<DescriptorAllocator> mAllocator;
@@ -114,6 +125,7 @@ namespace StarryEngine {
 
         std::unordered_map<uint32_t, std::shared_ptr<DescriptorSetLayout>> mLayouts;
         std::unordered_map<uint32_t, SetInstance> mSets;
+        std::vector<BatchTemplate> mBatchTemplates;  // 条目很少，线性查找即可，命中时无哈希、无锁、无分配
         DescriptorTracker mRequirements;
 
         uint32_t mCurrentSetIndex = 0;
@@ -124,5 +136,7 @@ namespace StarryEngine {
         void validateAllocated() const;
         void validateFrameIndex(uint32_t frameIndex) const;
         std::shared_ptr<DescriptorSetLayout> getCurrentLayout() const;
+        VkDescriptorUpdateTemplate getBatchTemplate(uint32_t setIndex, VkDescriptorType type,
+            const std::vector<uint32_t>& bindings);
     };
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include"DescriptorTracker.hpp"
+#include <algorithm>
 
 namespace StarryEngine {
 
@@ -27,6 +28,21 @@ namespace StarryEngine {
         return poolSizes;
     }
 
+    // 按比例缩放的池大小配置
+    std::vector<VkDescriptorPoolSize> DescriptorTracker::getPoolSizes(uint32_t setCount) const {
+        std::vector<VkDescriptorPoolSize> poolSizes;
+        if (mTotalSets == 0) {
+            return poolSizes;
+        }
+        for (const auto& [type, count] : mTypeCounts) {
+            if (count > 0) {
+                uint64_t scaled = (static_cast<uint64_t>(count) * setCount + mTotalSets - 1) / mTotalSets;
+                poolSizes.push_back({ type, static_cast<uint32_t>(std::min<uint64_t>(scaled, UINT32_MAX)) });
+            }
+        }
+        return poolSizes;
+    }
+
     // 重置统计
     void DescriptorTracker::reset() {
         mTypeCounts.clear();
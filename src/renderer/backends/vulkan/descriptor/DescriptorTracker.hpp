@@ -16,6 +16,9 @@ namespace StarryEngine {
         void reset();
 
         std::vector<VkDescriptorPoolSize> getPoolSizes() const;
+
+        // 按每个集合的平均描述符数量缩放到setCount个集合（向上取整）
+        std::vector<VkDescriptorPoolSize> getPoolSizes(uint32_t setCount) const;
         uint32_t getTotalSetCount() const { return mTotalSets; }
     private:
         std::unordered_map<VkDescriptorType, uint32_t> mTypeCounts;
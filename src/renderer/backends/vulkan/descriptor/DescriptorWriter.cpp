@@ -1,5 +1,7 @@
 #include "DescriptorWriter.hpp"
 #include "../vulkanCore/VulkanCore.hpp"
+#include "../../../utils/Hash.hpp"
+#include <array>
 #include <stdexcept>
 
 namespace StarryEngine {
@@ -8,6 +10,10 @@ namespace StarryEngine {
         : mLogicalDevice(logicalDevice) {
     }
 
+    DescriptorWriter::~DescriptorWriter() {
+        cleanup();
+    }
+
     // 单个 Binding 更新实现
     void DescriptorWriter::updateUniformBuffer(
         VkDescriptorSet set,
@@ -93,8 +99,11 @@ namespace StarryEngine {
             throw std::runtime_error("Bindings and buffers count mismatch");
         }
 
+        // 预留容量：写入结构保存的是bufferInfos元素的地址，扩容会使其失效
         std::vector<VkWriteDescriptorSet> writes;
         std::vector<VkDescriptorBufferInfo> bufferInfos;
+        writes.reserve(bindings.size());
+        bufferInfos.reserve(bindings.size());
 
         for (size_t i = 0; i < bindings.size(); ++i) {
             VkDescriptorBufferInfo bufferInfo{};
@@ -135,6 +144,8 @@ namespace StarryEngine {
 
         std::vector<VkWriteDescriptorSet> writes;
         std::vector<VkDescriptorImageInfo> imageInfos;
+        writes.reserve(bindings.size());
+        imageInfos.reserve(bindings.size());
 
         for (size_t i = 0; i < bindings.size(); ++i) {
             VkDescriptorImageInfo imageInfo{};
@@ -162,6 +173,191 @@ namespace StarryEngine {
         }
     }
 
+    void DescriptorWriter::updateUniformBuffers(
+        VkDescriptorSet set,
+        VkDescriptorUpdateTemplate batchTemplate,
+        const std::vector<uint32_t>& bindings,
+        const std::vector<VkBuffer>& buffers,
+        const std::vector<VkDeviceSize>& offsets,
+        const std::vector<VkDeviceSize>& ranges) {
+
+        if (bindings.size() != buffers.size()) {
+            throw std::runtime_error("Bindings and buffers count mismatch");
+        }
+        if (bindings.empty()) {
+            return;
+        }
+
+        std::array<VkDescriptorBufferInfo, MAX_INLINE_BATCH> inlineInfos;
+        std::vector<VkDescriptorBufferInfo> heapInfos;
+        VkDescriptorBufferInfo* bufferInfos = inlineInfos.data();
+        if (bindings.size() > MAX_INLINE_BATCH) {
+            heapInfos.resize(bindings.size());
+            bufferInfos = heapInfos.data();
+        }
+
+        for (size_t i = 0; i < bindings.size(); ++i) {
+            bufferInfos[i].buffer = buffers[i];
+            bufferInfos[i].offset = (i < offsets.size()) ? offsets[i] : 0;
+            bufferInfos[i].range = (i < ranges.size()) ? ranges[i] : VK_WHOLE_SIZE;
+        }
+
+        updateWithTemplate(set, batchTemplate, static_cast<const void*>(bufferInfos));
+    }
+
+    void DescriptorWriter::updateCombinedImageSamplers(
+        VkDescriptorSet set,
+        VkDescriptorUpdateTemplate batchTemplate,
+        const std::vector<uint32_t>& bindings,
+        const std::vector<VkImageView>& imageViews,
+        const std::vector<VkSampler>& samplers,
+        const std::vector<VkImageLayout>& imageLayouts) {
+
+        if (bindings.size() != imageViews.size() || bindings.size() != samplers.size()) {
+            throw std::runtime_error("Bindings, imageViews and samplers count mismatch");
+        }
+        if (bindings.empty()) {
+            return;
+        }
+
+        std::array<VkDescriptorImageInfo, MAX_INLINE_BATCH> inlineInfos;
+        std::vector<VkDescriptorImageInfo> heapInfos;
+        VkDescriptorImageInfo* imageInfos = inlineInfos.data();
+        if (bindings.size() > MAX_INLINE_BATCH) {
+            heapInfos.resize(bindings.size());
+            imageInfos = heapInfos.data();
+        }
+
+        for (size_t i = 0; i < bindings.size(); ++i) {
+            imageInfos[i].sampler = samplers[i];
+            imageInfos[i].imageView = imageViews[i];
+            imageInfos[i].imageLayout = (i < imageLayouts.size()) ? imageLayouts[i] : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+
+        updateWithTemplate(set, batchTemplate, static_cast<const void*>(imageInfos));
+    }
+
+    // 描述符更新模板实现
+    namespace {
+        size_t getTemplateStride(VkDescriptorType type) {
+            switch (type) {
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                return sizeof(VkDescriptorBufferInfo);
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                return sizeof(VkDescriptorImageInfo);
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                return sizeof(VkBufferView);
+            default:
+                throw std::runtime_error("Descriptor type not supported by update templates");
+            }
+        }
+    }
+
+    size_t DescriptorWriter::getTemplateDataSize(const std::vector<TemplateEntry>& entries) {
+        size_t size = 0;
+        for (const auto& entry : entries) {
+            size += getTemplateStride(entry.type) * entry.count;
+        }
+        return size;
+    }
+
+    VkDescriptorUpdateTemplate DescriptorWriter::getUpdateTemplate(
+        VkDescriptorSetLayout layout,
+        const std::vector<TemplateEntry>& entries) {
+
+        if (entries.empty()) {
+            throw std::runtime_error("Descriptor update template needs at least one entry");
+        }
+
+        Hasher hasher;
+        hasher.add(reinterpret_cast<uint64_t>(layout));
+        for (const auto& entry : entries) {
+            hasher.add(entry.binding).add(entry.type).add(entry.count);
+        }
+        const uint64_t key = hasher.get();
+
+        std::lock_guard<std::mutex> lock(mTemplateMutex);
+        auto it = mTemplates.find(key);
+        if (it != mTemplates.end()) {
+            return it->second;
+        }
+
+        std::vector<VkDescriptorUpdateTemplateEntry> templateEntries;
+        templateEntries.reserve(entries.size());
+        size_t offset = 0;
+        for (const auto& entry : entries) {
+            const size_t stride = getTemplateStride(entry.type);
+            VkDescriptorUpdateTemplateEntry templateEntry{};
+            templateEntry.dstBinding = entry.binding;
+            templateEntry.dstArrayElement = 0;
+            templateEntry.descriptorCount = entry.count;
+            templateEntry.descriptorType = entry.type;
+            templateEntry.offset = offset;
+            templateEntry.stride = stride;
+            templateEntries.push_back(templateEntry);
+            offset += stride * entry.count;
+        }
+
+        VkDescriptorUpdateTemplateCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(templateEntries.size());
+        createInfo.pDescriptorUpdateEntries = templateEntries.data();
+        createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        createInfo.descriptorSetLayout = layout;
+
+        VkDescriptorUpdateTemplate updateTemplate = VK_NULL_HANDLE;
+        if (vkCreateDescriptorUpdateTemplate(mLogicalDevice->getHandle(), &createInfo, nullptr, &updateTemplate) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create descriptor update template");
+        }
+        mTemplates.emplace(key, updateTemplate);
+        return updateTemplate;
+    }
+
+    VkDescriptorUpdateTemplate DescriptorWriter::getBatchTemplate(
+        VkDescriptorSetLayout layout,
+        VkDescriptorType type,
+        const std::vector<uint32_t>& bindings) {
+
+        std::vector<TemplateEntry> entries;
+        entries.reserve(bindings.size());
+        for (uint32_t binding : bindings) {
+            entries.push_back({ binding, type, 1 });
+        }
+        return getUpdateTemplate(layout, entries);
+    }
+
+    void DescriptorWriter::updateWithTemplate(
+        VkDescriptorSet set,
+        VkDescriptorUpdateTemplate updateTemplate,
+        const void* data) {
+
+        if (updateTemplate == VK_NULL_HANDLE || data == nullptr) {
+            throw std::runtime_error("Invalid descriptor update template or data");
+        }
+        vkUpdateDescriptorSetWithTemplate(mLogicalDevice->getHandle(), set, updateTemplate, data);
+    }
+
+    uint32_t DescriptorWriter::getTemplateCount() const {
+        std::lock_guard<std::mutex> lock(mTemplateMutex);
+        return static_cast<uint32_t>(mTemplates.size());
+    }
+
+    void DescriptorWriter::cleanup() {
+        std::lock_guard<std::mutex> lock(mTemplateMutex);
+        for (auto& [key, updateTemplate] : mTemplates) {
+            vkDestroyDescriptorUpdateTemplate(mLogicalDevice->getHandle(), updateTemplate, nullptr);
+        }
+        mTemplates.clear();
+    }
+
     // 内部通用方法
     void DescriptorWriter::updateSingleBindingInternal(
         VkDescriptorSet set,
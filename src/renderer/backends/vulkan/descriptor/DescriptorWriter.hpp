@@ -1,6 +1,9 @@
 #pragma once
 #include <vulkan/vulkan.h>
 #include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace StarryEngine {
@@ -10,7 +13,21 @@ namespace StarryEngine {
     public:
         using Ptr = std::shared_ptr<DescriptorWriter>;
 
+        // 更新模板中的一项；数据中每项占count个信息结构，各项按顺序紧密排列
+        struct TemplateEntry {
+            uint32_t binding;
+            VkDescriptorType type;
+            uint32_t count = 1;
+        };
+
+        // 模板批量更新时栈上信息缓冲的容量，超出时退回堆分配
+        static constexpr size_t MAX_INLINE_BATCH = 16;
+
         DescriptorWriter(const std::shared_ptr<LogicalDevice>& logicalDevice);
+        ~DescriptorWriter();
+
+        DescriptorWriter(const DescriptorWriter&) = delete;
+        DescriptorWriter& operator=(const DescriptorWriter&) = delete;
 
         // === 核心：单个 Binding 更新 ===
 
@@ -69,9 +86,64 @@ namespace StarryEngine {
             const std::vector<VkSampler>& samplers,
             const std::vector<VkImageLayout>& imageLayouts = {});
 
+        // 通过getBatchTemplate得到的模板批量更新：数据紧密排列在栈上后一次写入，不再构建写入结构
+        void updateUniformBuffers(
+            VkDescriptorSet set,
+            VkDescriptorUpdateTemplate batchTemplate,
+            const std::vector<uint32_t>& bindings,
+            const std::vector<VkBuffer>& buffers,
+            const std::vector<VkDeviceSize>& offsets = {},
+            const std::vector<VkDeviceSize>& ranges = {});
+
+        void updateCombinedImageSamplers(
+            VkDescriptorSet set,
+            VkDescriptorUpdateTemplate batchTemplate,
+            const std::vector<uint32_t>& bindings,
+            const std::vector<VkImageView>& imageViews,
+            const std::vector<VkSampler>& samplers,
+            const std::vector<VkImageLayout>& imageLayouts = {});
+
+        // === 描述符更新模板 ===
+
+        // 获取布局上按entries顺序更新的模板，首次使用时创建，之后按布局和项缓存
+        // 缓冲类为VkDescriptorBufferInfo，图像/采样器类为VkDescriptorImageInfo，纹素缓冲为VkBufferView
+        VkDescriptorUpdateTemplate getUpdateTemplate(
+            VkDescriptorSetLayout layout,
+            const std::vector<TemplateEntry>& entries);
+
+        // 单一描述符类型、每个binding一项的批量模板（调用方应自行缓存返回值，此处每次都要哈希加锁）
+        VkDescriptorUpdateTemplate getBatchTemplate(
+            VkDescriptorSetLayout layout,
+            VkDescriptorType type,
+            const std::vector<uint32_t>& bindings);
+
+        // 从紧密排列的数据更新整个描述符集（data布局须与创建模板时的entries一致）
+        void updateWithTemplate(
+            VkDescriptorSet set,
+            VkDescriptorUpdateTemplate updateTemplate,
+            const void* data);
+
+        // 以结构体作为数据，例如 struct { VkDescriptorBufferInfo camera; VkDescriptorImageInfo albedo; }
+        template<class T>
+        void updateWithTemplate(VkDescriptorSet set, VkDescriptorUpdateTemplate updateTemplate, const T& data) {
+            static_assert(std::is_trivially_copyable_v<T>, "Template data must be a plain struct of descriptor infos");
+            updateWithTemplate(set, updateTemplate, static_cast<const void*>(&data));
+        }
+
+        // entries对应的紧密排列数据大小（字节）
+        static size_t getTemplateDataSize(const std::vector<TemplateEntry>& entries);
+
+        uint32_t getTemplateCount() const;
+
+        // 销毁缓存的模板
+        void cleanup();
+
     private:
         std::shared_ptr<LogicalDevice> mLogicalDevice;
 
+        mutable std::mutex mTemplateMutex;
+        std::unordered_map<uint64_t, VkDescriptorUpdateTemplate> mTemplates;  // 键为布局和各项的哈希
+
         // 内部通用更新方法
         void updateSingleBindingInternal(
             VkDescriptorSet set,
@@ -0,0 +1,94 @@
+#include "TransientDescriptorAllocator.hpp"
+#include "../vulkanCore/VulkanCore.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace StarryEngine {
+
+    TransientDescriptorAllocator::TransientDescriptorAllocator(const std::shared_ptr<LogicalDevice>& logicalDevice,
+        uint32_t setsPerPool,
+        const std::vector<VkDescriptorPoolSize>& poolRatios)
+        : mLogicalDevice(logicalDevice),
+        mPoolRatios(poolRatios),
+        mSetsPerPool(std::clamp(setsPerPool, 1u, MAX_SETS_PER_POOL)) {
+        if (mPoolRatios.empty()) {
+            mPoolRatios = {
+                { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2 },
+                { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 },
+                { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 },
+                { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 },
+                { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1 },
+                { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1 },
+            };
+        }
+        mPools.push_back(createPool());
+    }
+
+    TransientDescriptorAllocator::~TransientDescriptorAllocator() {
+        mPools.clear();
+    }
+
+    VkDescriptorSet TransientDescriptorAllocator::allocate(VkDescriptorSetLayout layout) {
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
+
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        bool freshPool = false;
+        while (true) {
+            allocInfo.descriptorPool = mPools[mCurrentPool]->getHandle();
+            VkResult result = vkAllocateDescriptorSets(mLogicalDevice->getHandle(), &allocInfo, &descriptorSet);
+            if (result == VK_SUCCESS) {
+                break;
+            }
+            if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL) {
+                throw std::runtime_error("Failed to allocate transient descriptor set: VkResult = " +
+                    std::to_string(result));
+            }
+            if (freshPool) {
+                // 新建的空池也放不下，说明布局超出了池的类型比例
+                throw std::runtime_error("Transient descriptor set layout does not fit the pool ratios");
+            }
+
+            // 当前池用尽：换到本帧的下一个池，没有则新建
+            if (mCurrentPool + 1 == mPools.size()) {
+                mPools.push_back(createPool());
+                freshPool = true;
+            }
+            mCurrentPool++;
+        }
+
+        mAllocatedSets++;
+        return descriptorSet;
+    }
+
+    VkDescriptorSet TransientDescriptorAllocator::allocate(const std::shared_ptr<DescriptorSetLayout>& layout) {
+        return allocate(layout->getHandle());
+    }
+
+    void TransientDescriptorAllocator::reset() {
+        if (mCurrentPool > 0) {
+            // 上一帧需要多个池：合并为一个容量相当的池
+            mSetsPerPool = std::min(mSetsPerPool * static_cast<uint32_t>(mCurrentPool + 1), MAX_SETS_PER_POOL);
+            mPools.clear();
+            mPools.push_back(createPool());
+        }
+        else {
+            vkResetDescriptorPool(mLogicalDevice->getHandle(), mPools[0]->getHandle(), 0);
+        }
+        mCurrentPool = 0;
+        mAllocatedSets = 0;
+    }
+
+    std::shared_ptr<DescriptorPool> TransientDescriptorAllocator::createPool() const {
+        std::vector<VkDescriptorPoolSize> poolSizes;
+        poolSizes.reserve(mPoolRatios.size());
+        for (const auto& ratio : mPoolRatios) {
+            uint64_t count = static_cast<uint64_t>(ratio.descriptorCount) * mSetsPerPool;
+            poolSizes.push_back({ ratio.type, static_cast<uint32_t>(std::min<uint64_t>(count, UINT32_MAX)) });
+        }
+        return DescriptorPool::create(mLogicalDevice, poolSizes, mSetsPerPool);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <memory>
+#include <vector>
+#include "DescriptorPool.hpp"
+#include "DescriptorSetLayout.hpp"
+
+namespace StarryEngine {
+    class LogicalDevice;
+
+    // 单帧临时描述符集的线性分配器：每个飞行帧一个
+    // 池不带FREE_DESCRIPTOR_SET标志，集合不能单独释放，帧围栏信号后由reset()整体回收
+    // 一帧用掉多个池时，下次reset()合并为一个更大的池，稳定后每帧只需一次vkResetDescriptorPool
+    class TransientDescriptorAllocator {
+    public:
+        using Ptr = std::shared_ptr<TransientDescriptorAllocator>;
+
+        static constexpr uint32_t DEFAULT_SETS_PER_POOL = 256;
+        static constexpr uint32_t MAX_SETS_PER_POOL = 16384;
+
+        // poolRatios中的descriptorCount为每个集合的平均描述符数量，为空时使用默认比例
+        static Ptr create(const std::shared_ptr<LogicalDevice>& logicalDevice,
+            uint32_t setsPerPool = DEFAULT_SETS_PER_POOL,
+            const std::vector<VkDescriptorPoolSize>& poolRatios = {}) {
+            return std::make_shared<TransientDescriptorAllocator>(logicalDevice, setsPerPool, poolRatios);
+        }
+
+        TransientDescriptorAllocator(const std::shared_ptr<LogicalDevice>& logicalDevice,
+            uint32_t setsPerPool,
+            const std::vector<VkDescriptorPoolSize>& poolRatios);
+        ~TransientDescriptorAllocator();
+
+        TransientDescriptorAllocator(const TransientDescriptorAllocator&) = delete;
+        TransientDescriptorAllocator& operator=(const TransientDescriptorAllocator&) = delete;
+
+        // 分配只在本帧使用的描述符集
+        VkDescriptorSet allocate(VkDescriptorSetLayout layout);
+        VkDescriptorSet allocate(const std::shared_ptr<DescriptorSetLayout>& layout);
+
+        // 回收本帧的全部集合；调用前该帧的命令缓冲必须已执行完毕
+        void reset();
+
+        // === 统计信息 ===
+        uint32_t getAllocatedSetCount() const { return mAllocatedSets; }
+        size_t getPoolCount() const { return mPools.size(); }
+        uint32_t getSetsPerPool() const { return mSetsPerPool; }
+
+    private:
+        std::shared_ptr<DescriptorPool> createPool() const;
+
+    private:
+        std::shared_ptr<LogicalDevice> mLogicalDevice;
+        std::vector<VkDescriptorPoolSize> mPoolRatios;
+        uint32_t mSetsPerPool;
+
+        std::vector<std::shared_ptr<DescriptorPool>> mPools;
+        size_t mCurrentPool = 0;
+        uint32_t mAllocatedSets = 0;
+    };
+}
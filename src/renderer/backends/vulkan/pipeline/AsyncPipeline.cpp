@@ -0,0 +1,61 @@
+#include "AsyncPipeline.hpp"
+#include "NewPipelineBuilder.hpp"
+
+namespace StarryEngine {
+    AsyncPipeline::AsyncPipeline(VkDevice device, VkPipelineLayout pipelineLayout)
+        : mDevice(device), mPipelineLayout(pipelineLayout) {
+    }
+
+    AsyncPipeline::~AsyncPipeline() {
+        // 编译任务持有本对象的引用，析构时任务一定已经结束
+        if (mPipeline != VK_NULL_HANDLE) {
+            PipelineBuilder::releasePipeline(mDevice, mPipeline);
+            mPipeline = VK_NULL_HANDLE;
+        }
+        PipelineBuilder::releasePipeline(mDevice, mInterimPipeline.exchange(VK_NULL_HANDLE));
+    }
+
+    void AsyncPipeline::wait() const {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return getStatus() != Status::Pending; });
+    }
+
+    std::string AsyncPipeline::getError() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mError;
+    }
+
+    VkPipeline AsyncPipeline::takePipeline() {
+        wait();
+        std::lock_guard<std::mutex> lock(mMutex);
+        VkPipeline pipeline = mPipeline;
+        mPipeline = VK_NULL_HANDLE;
+        return pipeline;
+    }
+
+    VkPipeline AsyncPipeline::takeInterimPipeline() {
+        return mInterimPipeline.exchange(VK_NULL_HANDLE);
+    }
+
+    void AsyncPipeline::setInterim(VkPipeline pipeline) {
+        mInterimPipeline.store(pipeline, std::memory_order_release);
+    }
+
+    void AsyncPipeline::complete(VkPipeline pipeline) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mPipeline = pipeline;
+            mStatus.store(Status::Ready, std::memory_order_release);
+        }
+        mCondition.notify_all();
+    }
+
+    void AsyncPipeline::fail(const std::string& error) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mError = error;
+            mStatus.store(Status::Failed, std::memory_order_release);
+        }
+        mCondition.notify_all();
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace StarryEngine {
+    // 异步编译中的管线句柄：请求时立即返回，真正的VkPipeline在工作线程上创建
+    // 未就绪时RenderContext会改用同一布局注册的后备管线，或跳过绘制
+    class AsyncPipeline {
+    public:
+        using Ptr = std::shared_ptr<AsyncPipeline>;
+
+        enum class Status {
+            Pending,
+            Ready,
+            Failed
+        };
+
+        AsyncPipeline(VkDevice device, VkPipelineLayout pipelineLayout);
+
+        // 释放持有的管线（共享管线只减少引用计数）
+        ~AsyncPipeline();
+
+        AsyncPipeline(const AsyncPipeline&) = delete;
+        AsyncPipeline& operator=(const AsyncPipeline&) = delete;
+
+        Status getStatus() const { return mStatus.load(std::memory_order_acquire); }
+        bool isReady() const { return getStatus() == Status::Ready; }
+        bool isPending() const { return getStatus() == Status::Pending; }
+
+        // 就绪后返回最终管线；编译期间有临时管线（管线库快速链接的结果）时返回临时管线，否则返回VK_NULL_HANDLE
+        VkPipeline getPipeline() const { return isReady() ? mPipeline : mInterimPipeline.load(std::memory_order_acquire); }
+
+        // 是否已有可绑定的管线（最终或临时）
+        bool isUsable() const { return getPipeline() != VK_NULL_HANDLE; }
+        VkPipelineLayout getPipelineLayout() const { return mPipelineLayout; }
+
+        // 阻塞直到编译结束（成功或失败）
+        void wait() const;
+
+        // 失败原因（仅Failed状态有效）
+        std::string getError() const;
+
+        // 取走管线所有权，之后由调用方通过PipelineBuilder::releasePipeline释放
+        VkPipeline takePipeline();
+
+        // 取走临时管线所有权（没有时返回VK_NULL_HANDLE），由调用方通过PipelineBuilder::releasePipeline释放
+        // 未取走的临时管线随本对象析构释放
+        VkPipeline takeInterimPipeline();
+
+    private:
+        friend class PipelineBuilder;
+        void setInterim(VkPipeline pipeline);
+        void complete(VkPipeline pipeline);
+        void fail(const std::string& error);
+
+    private:
+        VkDevice mDevice;
+        VkPipelineLayout mPipelineLayout;
+        VkPipeline mPipeline = VK_NULL_HANDLE;  // 在mStatus变为Ready之前写入
+        std::atomic<Status> mStatus{ Status::Pending };
+        std::atomic<VkPipeline> mInterimPipeline{ VK_NULL_HANDLE };
+
+        mutable std::mutex mMutex;
+        mutable std::condition_variable mCondition;
+        std::string mError;
+    };
+}
@@ -0,0 +1,163 @@
+#include "LayoutCache.hpp"
+#include "../../../utils/Hash.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace StarryEngine {
+
+    namespace {
+        std::mutex sLayoutCacheMutex;
+        std::unordered_map<VkDevice, std::weak_ptr<LayoutCache>> sLayoutCaches;
+    }
+
+    LayoutCache::Ptr LayoutCache::acquire(const LogicalDevice::Ptr& logicalDevice) {
+        std::lock_guard<std::mutex> lock(sLayoutCacheMutex);
+        auto& weak = sLayoutCaches[logicalDevice->getHandle()];
+        if (auto cache = weak.lock()) {
+            return cache;
+        }
+        auto cache = std::make_shared<LayoutCache>(logicalDevice);
+        weak = cache;
+        return cache;
+    }
+
+    LayoutCache::Ptr LayoutCache::find(VkDevice device) {
+        std::lock_guard<std::mutex> lock(sLayoutCacheMutex);
+        auto it = sLayoutCaches.find(device);
+        return it != sLayoutCaches.end() ? it->second.lock() : nullptr;
+    }
+
+    LayoutCache::LayoutCache(const LogicalDevice::Ptr& logicalDevice)
+        : mLogicalDevice(logicalDevice) {
+    }
+
+    LayoutCache::~LayoutCache() {
+        cleanup();
+    }
+
+    void LayoutCache::cleanup() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPipelineLayouts.clear();
+        mSetLayouts.clear();
+        mSetLayoutHashes.clear();
+        mPipelineLayoutHashes.clear();
+    }
+
+    DescriptorSetLayout::Ptr LayoutCache::getDescriptorSetLayout(
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayoutCreateFlags flags,
+        const std::vector<VkDescriptorBindingFlags>& bindingFlags) {
+        if (!bindingFlags.empty() && bindingFlags.size() != bindings.size()) {
+            throw std::runtime_error("LayoutCache: binding flag count does not match binding count");
+        }
+
+        // 规范化：按绑定号排序，标志随绑定一起移动
+        std::vector<size_t> order(bindings.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+            [&bindings](size_t a, size_t b) { return bindings[a].binding < bindings[b].binding; });
+
+        std::vector<VkDescriptorSetLayoutBinding> sortedBindings;
+        std::vector<VkDescriptorBindingFlags> sortedFlags;
+        Hasher hasher;
+        hasher.add(flags).add(static_cast<uint32_t>(bindings.size()));
+        for (size_t index : order) {
+            const auto& binding = bindings[index];
+            sortedBindings.push_back(binding);
+            hasher.add(binding.binding).add(binding.descriptorType).add(binding.descriptorCount).add(binding.stageFlags);
+            if (binding.pImmutableSamplers) {
+                for (uint32_t i = 0; i < binding.descriptorCount; ++i) {
+                    hasher.add(reinterpret_cast<uint64_t>(binding.pImmutableSamplers[i]));
+                }
+            }
+            if (!bindingFlags.empty()) {
+                sortedFlags.push_back(bindingFlags[index]);
+                hasher.add(bindingFlags[index]);
+            }
+        }
+        const uint64_t key = hasher.get();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mSetLayouts.find(key);
+        if (it != mSetLayouts.end()) {
+            mStats.setLayoutsReused++;
+            return it->second;
+        }
+
+        auto layout = std::make_shared<DescriptorSetLayout>(mLogicalDevice);
+        for (const auto& binding : sortedBindings) {
+            layout->addBinding(binding.binding, binding.descriptorType, binding.stageFlags,
+                binding.descriptorCount, binding.pImmutableSamplers);
+        }
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+        bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        bindingFlagsInfo.bindingCount = static_cast<uint32_t>(sortedFlags.size());
+        bindingFlagsInfo.pBindingFlags = sortedFlags.data();
+        layout->build(flags, sortedFlags.empty() ? nullptr : &bindingFlagsInfo);
+
+        mSetLayouts[key] = layout;
+        mSetLayoutHashes[layout->getHandle()] = key;
+        mStats.setLayoutsCreated++;
+        return layout;
+    }
+
+    PipelineLayout::Ptr LayoutCache::getPipelineLayout(
+        const std::vector<VkDescriptorSetLayout>& setLayouts,
+        const std::vector<VkPushConstantRange>& pushConstantRanges) {
+        // 集合布局的顺序即集合编号，保持原样；推送常量范围按偏移排序
+        auto sortedRanges = pushConstantRanges;
+        std::sort(sortedRanges.begin(), sortedRanges.end(),
+            [](const VkPushConstantRange& a, const VkPushConstantRange& b) {
+                return a.offset != b.offset ? a.offset < b.offset : a.stageFlags < b.stageFlags;
+            });
+
+        Hasher hasher;
+        hasher.add(static_cast<uint32_t>(setLayouts.size()));
+        for (VkDescriptorSetLayout setLayout : setLayouts) {
+            hasher.add(reinterpret_cast<uint64_t>(setLayout));
+        }
+        hasher.add(static_cast<uint32_t>(sortedRanges.size()));
+        for (const auto& range : sortedRanges) {
+            hasher.add(range.stageFlags).add(range.offset).add(range.size);
+        }
+        const uint64_t key = hasher.get();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mPipelineLayouts.find(key);
+        if (it != mPipelineLayouts.end()) {
+            mStats.pipelineLayoutsReused++;
+            return it->second;
+        }
+
+        auto layout = PipelineLayout::create(mLogicalDevice, setLayouts, sortedRanges);
+        mPipelineLayouts[key] = layout;
+
+        // 内容哈希：集合布局取其内容哈希，不是本缓存创建的集合布局只能用句柄
+        Hasher contentHasher;
+        contentHasher.add(static_cast<uint32_t>(setLayouts.size()));
+        for (VkDescriptorSetLayout setLayout : setLayouts) {
+            auto setIt = mSetLayoutHashes.find(setLayout);
+            contentHasher.add(setIt != mSetLayoutHashes.end() ? setIt->second : reinterpret_cast<uint64_t>(setLayout));
+        }
+        contentHasher.add(static_cast<uint32_t>(sortedRanges.size()));
+        for (const auto& range : sortedRanges) {
+            contentHasher.add(range.stageFlags).add(range.offset).add(range.size);
+        }
+        mPipelineLayoutHashes[layout->getHandle()] = contentHasher.get();
+        mStats.pipelineLayoutsCreated++;
+        return layout;
+    }
+
+    uint64_t LayoutCache::getContentHash(VkPipelineLayout pipelineLayout) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mPipelineLayoutHashes.find(pipelineLayout);
+        return it != mPipelineLayoutHashes.end() ? it->second : 0;
+    }
+
+    LayoutCache::Stats LayoutCache::getStats() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStats;
+    }
+
+} // namespace StarryEngine
@@ -0,0 +1,68 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include "../vulkanCore/LogicalDevice.hpp"
+#include "../descriptor/DescriptorSetLayout.hpp"
+#include "pipeline.hpp"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace StarryEngine {
+
+    // 设备级布局缓存：绑定列表相同的描述符集布局、集合布局与推送常量相同的管线布局共享同一个句柄
+    // 键与绑定/范围的声明顺序无关；布局兼容的管线因此使用同一个VkPipelineLayout，切换管线时无需重新绑定描述符集
+    class LayoutCache {
+    public:
+        using Ptr = std::shared_ptr<LayoutCache>;
+
+        struct Stats {
+            uint64_t setLayoutsCreated = 0;
+            uint64_t setLayoutsReused = 0;
+            uint64_t pipelineLayoutsCreated = 0;
+            uint64_t pipelineLayoutsReused = 0;
+        };
+
+        // 获取设备对应的缓存（同一设备返回同一实例）
+        static Ptr acquire(const LogicalDevice::Ptr& logicalDevice);
+
+        // 查找设备已有的缓存，不存在时返回nullptr
+        static Ptr find(VkDevice device);
+
+        LayoutCache(const LogicalDevice::Ptr& logicalDevice);
+        ~LayoutCache();
+
+        LayoutCache(const LayoutCache&) = delete;
+        LayoutCache& operator=(const LayoutCache&) = delete;
+
+        // 释放缓存持有的引用，仍被使用的布局在最后一个引用释放时销毁
+        void cleanup();
+
+        // bindingFlags为空或与bindings等长，非空时通过VkDescriptorSetLayoutBindingFlagsCreateInfo传入
+        DescriptorSetLayout::Ptr getDescriptorSetLayout(
+            const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+            VkDescriptorSetLayoutCreateFlags flags = 0,
+            const std::vector<VkDescriptorBindingFlags>& bindingFlags = {});
+
+        PipelineLayout::Ptr getPipelineLayout(
+            const std::vector<VkDescriptorSetLayout>& setLayouts,
+            const std::vector<VkPushConstantRange>& pushConstantRanges = {});
+
+        // 缓存创建的管线布局的内容哈希（由各集合布局的绑定和推送常量范围决定，与句柄无关）
+        // 不是本缓存创建的布局返回0
+        uint64_t getContentHash(VkPipelineLayout pipelineLayout) const;
+
+        Stats getStats() const;
+
+    private:
+        LogicalDevice::Ptr mLogicalDevice;
+
+        mutable std::mutex mMutex;
+        std::unordered_map<uint64_t, DescriptorSetLayout::Ptr> mSetLayouts;
+        std::unordered_map<uint64_t, PipelineLayout::Ptr> mPipelineLayouts;
+        std::unordered_map<VkDescriptorSetLayout, uint64_t> mSetLayoutHashes;    // 句柄到内容哈希
+        std::unordered_map<VkPipelineLayout, uint64_t> mPipelineLayoutHashes;
+        Stats mStats;
+    };
+
+} // namespace StarryEngine
@@ -1,4 +1,12 @@
 #include "NewPipelineBuilder.hpp"
+#include "PipelineCache.hpp"
+#include "PipelineFeedback.hpp"
+#include "PipelinePrecache.hpp"
+#include "LayoutCache.hpp"
+#include "../renderPass/RenderPass.hpp"
+#include "../../../utils/Hash.hpp"
+#include "../../../utils/ThreadPool.hpp"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <unordered_set>
@@ -68,20 +76,339 @@ namespace StarryEngine {
         VkGraphicsPipelineCreateInfo pipelineInfo = createPipelineCreateInfo(
             components, pipelineLayout, renderPass, subpass);
 
-        // 创建管线
+        VkPipeline pipeline = createPipeline(mDevice,
+            computeStateHash(mDevice, components, pipelineLayout, renderPass, subpass), pipelineInfo,
+            describeComponents(components));
+        recordForPrecache(mDevice, *mRegistry, mSelections, components, pipelineLayout, renderPass, subpass);
+
+        std::cout << "Successfully created graphics pipeline with "
+            << components.size() << " components" << std::endl;
+
+        return pipeline;
+    }
+
+    VkPipeline PipelineBuilder::createPipeline(
+        VkDevice device,
+        uint64_t stateHash,
+        const VkGraphicsPipelineCreateInfo& pipelineInfo,
+        const std::string& name) {
+        // 创建管线（状态相同的管线在设备内共享）
         VkPipeline pipeline = VK_NULL_HANDLE;
-        VkResult result = vkCreateGraphicsPipelines(mDevice, VK_NULL_HANDLE, 1,
-            &pipelineInfo, nullptr, &pipeline);
+        VkResult result;
+        if (auto pipelineCache = PipelineCache::find(device)) {
+            result = pipelineCache->acquireGraphicsPipeline(stateHash, pipelineInfo, pipeline, name);
+        }
+        else {
+            result = PipelineFeedback::createGraphicsPipeline(device, VK_NULL_HANDLE, pipelineInfo, pipeline,
+                name, stateHash);
+        }
 
         if (result != VK_SUCCESS) {
             throw std::runtime_error("Failed to create graphics pipeline: VkResult = " +
                 std::to_string(result));
         }
+        return pipeline;
+    }
 
-        std::cout << "Successfully created graphics pipeline with "
-            << components.size() << " components" << std::endl;
+    void PipelineBuilder::recordForPrecache(
+        VkDevice device,
+        const ComponentRegistry& registry,
+        const std::vector<ComponentSelection>& selections,
+        const std::unordered_map<PipelineComponentType,
+        std::shared_ptr<IPipelineStateComponent>>& components,
+        VkPipelineLayout pipelineLayout,
+        VkRenderPass renderPass,
+        uint32_t subpass,
+        const PipelineStatePreset* preset) {
+        if (auto precache = PipelinePrecache::find(device)) {
+            precache->record(registry, selections, components, pipelineLayout, renderPass, subpass, preset);
+        }
+    }
 
-        return pipeline;
+    std::string PipelineBuilder::describeComponents(
+        const std::unordered_map<PipelineComponentType,
+        std::shared_ptr<IPipelineStateComponent>>& components) {
+        std::vector<PipelineComponentType> types;
+        for (const auto& [type, component] : components) {
+            types.push_back(type);
+        }
+        std::sort(types.begin(), types.end());
+
+        std::string name;
+        for (auto type : types) {
+            if (!name.empty()) {
+                name += "/";
+            }
+            name += components.at(type)->getName();
+        }
+        return name;
+    }
+
+    AsyncPipeline::Ptr PipelineBuilder::buildGraphicsPipelineAsync(
+        VkPipelineLayout pipelineLayout,
+        VkRenderPass renderPass,
+        uint32_t subpass,
+        bool validate) {
+
+        if (validate && !validateSelections()) {
+            throw std::runtime_error("Pipeline component validation failed");
+        }
+
+        std::vector<std::string> warnings;
+        auto components = collectComponents(warnings);
+        for (const auto& warning : warnings) {
+            std::cout << "  ⚠ " << warning << std::endl;
+        }
+
+        // 异步构建在请求时记录，会话中途退出也能保留到清单
+        recordForPrecache(mDevice, *mRegistry, mSelections, components, pipelineLayout, renderPass, subpass);
+
+        // 在调用线程上复制组件并生成创建信息，工作线程不访问调用方可能继续修改的实例
+        // 同时持有着色器模块，热重载替换模块后旧模块在编译结束前不会被销毁
+        std::vector<ShaderModule::Ptr> shaderModules;
+        for (auto& [type, component] : components) {
+            component = component->clone();
+            if (auto shaderStage = std::dynamic_pointer_cast<ShaderStageComponent>(component)) {
+                if (auto program = shaderStage->getShaderProgram()) {
+                    shaderModules = program->getShaderModules();
+                }
+            }
+        }
+        VkGraphicsPipelineCreateInfo pipelineInfo = createPipelineCreateInfo(
+            components, pipelineLayout, renderPass, subpass);
+        const uint64_t stateHash = computeStateHash(mDevice, components, pipelineLayout, renderPass, subpass);
+        std::string name = describeComponents(components);
+
+        auto asyncPipeline = std::make_shared<AsyncPipeline>(mDevice, pipelineLayout);
+        auto pipelineLibrary = PipelineLibrary::find(mDevice);
+        if (pipelineLibrary) {
+            auto partHashes = computeLibraryPartHashes(mDevice, components, pipelineLayout, renderPass, subpass);
+            ThreadPool::getShared()->submit([asyncPipeline, pipelineLibrary, components = std::move(components),
+                shaderModules = std::move(shaderModules), pipelineInfo, stateHash, partHashes]() {
+                // 未变化的部分直接复用，通常只有着色器所在的部分需要编译
+                // 链接期间持有各部分的引用，链接出的管线另外持有引用，释放后不再使用的部分被销毁
+                PipelineLibrary::Parts parts{};
+                try {
+                    for (size_t i = 0; i < parts.size(); ++i) {
+                        parts[i] = pipelineLibrary->acquirePart(
+                            static_cast<PipelineLibrary::Part>(i), partHashes[i], pipelineInfo);
+                    }
+
+                    // 快速链接失败不影响优化链接
+                    try {
+                        asyncPipeline->setInterim(pipelineLibrary->link(parts, pipelineInfo.layout, false));
+                    }
+                    catch (const std::exception& e) {
+                        std::cerr << "Pipeline library fast link failed: " << e.what() << std::endl;
+                    }
+                    asyncPipeline->complete(pipelineLibrary->link(parts, pipelineInfo.layout, true, stateHash));
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "Async pipeline build failed: " << e.what() << std::endl;
+                    asyncPipeline->fail(e.what());
+                }
+                pipelineLibrary->releaseParts(parts);
+            });
+            return asyncPipeline;
+        }
+
+        ThreadPool::getShared()->submit([device = mDevice, asyncPipeline, components = std::move(components),
+            shaderModules = std::move(shaderModules), pipelineInfo, stateHash, name = std::move(name)]() {
+            try {
+                asyncPipeline->complete(createPipeline(device, stateHash, pipelineInfo, name));
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Async pipeline build failed: " << e.what() << std::endl;
+                asyncPipeline->fail(e.what());
+            }
+        });
+        return asyncPipeline;
+    }
+
+    std::vector<VkPipeline> PipelineBuilder::buildGraphicsPipelines(
+        const std::vector<PipelineBuildRequest>& requests,
+        bool validate) {
+        std::vector<VkPipeline> pipelines(requests.size(), VK_NULL_HANDLE);
+        if (requests.empty()) {
+            return pipelines;
+        }
+
+        // 工作线程只读取快照，调用方在批量构建期间修改注册表不会影响本批次
+        auto snapshot = mRegistry->snapshot();
+
+        // 验证在调用线程上完成（会输出日志）
+        std::vector<bool> valid(requests.size(), true);
+        for (size_t i = 0; i < requests.size(); ++i) {
+            if (validate && !validateSelections(*snapshot, requests[i].selections)) {
+                std::cerr << "Pipeline batch: validation failed for request " << i << std::endl;
+                valid[i] = false;
+            }
+        }
+
+        // 每个请求克隆自己的组件：apply()会改写组件内部的创建信息，共享实例不能并发使用
+        // 各线程独立调用vkCreateGraphicsPipelines，共用设备级VkPipelineCache
+        auto threadPool = ThreadPool::getShared();
+        std::vector<std::future<VkPipeline>> futures(requests.size());
+        for (size_t i = 0; i < requests.size(); ++i) {
+            if (!valid[i]) {
+                continue;
+            }
+            const PipelineBuildRequest* request = &requests[i];
+            futures[i] = threadPool->submit([device = mDevice, snapshot, request]() {
+                std::vector<std::string> warnings;
+                auto components = collectComponents(*snapshot, request->selections, warnings);
+                for (auto& [type, component] : components) {
+                    component = component->clone();
+                }
+
+                VkGraphicsPipelineCreateInfo pipelineInfo = createPipelineCreateInfo(
+                    components, request->pipelineLayout, request->renderPass, request->subpass);
+                VkPipeline pipeline = createPipeline(device,
+                    computeStateHash(device, components, request->pipelineLayout, request->renderPass, request->subpass),
+                    pipelineInfo, describeComponents(components));
+                recordForPrecache(device, *snapshot, request->selections, components,
+                    request->pipelineLayout, request->renderPass, request->subpass);
+                return pipeline;
+            });
+        }
+
+        size_t created = 0;
+        for (size_t i = 0; i < futures.size(); ++i) {
+            if (!futures[i].valid()) {
+                continue;
+            }
+            try {
+                pipelines[i] = futures[i].get();
+                created++;
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Pipeline batch: request " << i << " failed: " << e.what() << std::endl;
+            }
+        }
+
+        std::cout << "Pipeline batch: created " << created << "/" << requests.size()
+            << " graphics pipelines on " << threadPool->getThreadCount() << " threads" << std::endl;
+        return pipelines;
+    }
+
+    void PipelineBuilder::releasePipeline(VkDevice device, VkPipeline pipeline) {
+        if (pipeline == VK_NULL_HANDLE) {
+            return;
+        }
+        auto pipelineCache = PipelineCache::find(device);
+        if (!pipelineCache || !pipelineCache->releasePipeline(pipeline)) {
+            vkDestroyPipeline(device, pipeline, nullptr);
+        }
+        // 管线库链接出的管线释放后，不再被引用的库部分随之销毁
+        if (auto pipelineLibrary = PipelineLibrary::find(device)) {
+            pipelineLibrary->onPipelineReleased(pipeline);
+        }
+    }
+
+    uint64_t PipelineBuilder::computeStateHash(
+        VkPipelineLayout pipelineLayout,
+        VkRenderPass renderPass,
+        uint32_t subpass) const {
+        std::vector<std::string> warnings;
+        return computeStateHash(mDevice, collectComponents(warnings), pipelineLayout, renderPass, subpass);
+    }
+
+    const std::vector<VkDynamicState>& PipelineBuilder::getDynamicStates(
+        const std::unordered_map<PipelineComponentType,
+        std::shared_ptr<IPipelineStateComponent>>& components) {
+        static const std::vector<VkDynamicState> none;
+        auto it = components.find(PipelineComponentType::DYNAMIC_STATE);
+        auto dynamicState = it != components.end() ?
+            std::dynamic_pointer_cast<DynamicStateComponent>(it->second) : nullptr;
+        return dynamicState ? dynamicState->getDynamicStates() : none;
+    }
+
+    uint64_t PipelineBuilder::getLayoutKey(VkDevice device, VkPipelineLayout pipelineLayout) {
+        auto layoutCache = LayoutCache::find(device);
+        const uint64_t contentHash = layoutCache ? layoutCache->getContentHash(pipelineLayout) : 0;
+        return contentHash != 0 ? contentHash : reinterpret_cast<uint64_t>(pipelineLayout);
+    }
+
+    uint64_t PipelineBuilder::computeStateHash(
+        VkDevice device,
+        const std::unordered_map<PipelineComponentType,
+        std::shared_ptr<IPipelineStateComponent>>& components,
+        VkPipelineLayout pipelineLayout,
+        VkRenderPass renderPass,
+        uint32_t subpass) {
+        // 按类型排序，保证与选择顺序无关
+        std::vector<PipelineComponentType> types;
+        types.reserve(components.size());
+        for (const auto& [type, component] : components) {
+            types.push_back(type);
+        }
+        std::sort(types.begin(), types.end());
+
+        // 声明为动态的字段在绘制时设置，不参与哈希，只有动态字段不同的请求共用同一管线
+        const auto& dynamicStates = getDynamicStates(components);
+        Hasher hasher;
+        for (auto type : types) {
+            hasher.add(type).add(components.at(type)->getStaticHash(dynamicStates));
+        }
+
+        // 兼容的渲染通道可以共用管线，按兼容性哈希区分；未通过RenderPass创建的句柄按句柄区分
+        const uint64_t renderPassHash = RenderPass::GetCompatibilityHash(renderPass);
+        hasher.add(getLayoutKey(device, pipelineLayout))
+            .add(renderPassHash != 0 ? renderPassHash : reinterpret_cast<uint64_t>(renderPass))
+            .add(subpass);
+        return hasher.get();
+    }
+
+    std::array<uint64_t, PipelineLibrary::PART_COUNT> PipelineBuilder::computeLibraryPartHashes(
+        VkDevice device,
+        const std::unordered_map<PipelineComponentType,
+        std::shared_ptr<IPipelineStateComponent>>& components,
+        VkPipelineLayout pipelineLayout,
+        VkRenderPass renderPass,
+        uint32_t subpass) {
+        const auto& dynamicStates = getDynamicStates(components);
+        auto componentHash = [&components, &dynamicStates](PipelineComponentType type) -> uint64_t {
+            auto it = components.find(type);
+            return it != components.end() ? it->second->getStaticHash(dynamicStates) : 0;
+        };
+        auto stageHash = [&components](VkShaderStageFlags stageMask) -> uint64_t {
+            auto it = components.find(PipelineComponentType::SHADER_STAGE);
+            auto shaderStage = it != components.end() ?
+                std::dynamic_pointer_cast<ShaderStageComponent>(it->second) : nullptr;
+            return shaderStage ? shaderStage->getStageHash(stageMask) : 0;
+        };
+
+        // 动态状态作用于所有部分
+        const uint64_t dynamicHash = componentHash(PipelineComponentType::DYNAMIC_STATE);
+        const uint64_t renderPassHash = RenderPass::GetCompatibilityHash(renderPass);
+        const uint64_t renderPassKey = renderPassHash != 0 ? renderPassHash : reinterpret_cast<uint64_t>(renderPass);
+        // 部分长期缓存，布局按内容区分
+        const uint64_t layoutKey = getLayoutKey(device, pipelineLayout);
+
+        std::array<uint64_t, PipelineLibrary::PART_COUNT> hashes{};
+        hashes[static_cast<size_t>(PipelineLibrary::Part::VertexInput)] = Hasher()
+            .add(componentHash(PipelineComponentType::VERTEX_INPUT))
+            .add(componentHash(PipelineComponentType::INPUT_ASSEMBLY))
+            .add(dynamicHash)
+            .get();
+        hashes[static_cast<size_t>(PipelineLibrary::Part::PreRasterization)] = Hasher()
+            .add(stageHash(VK_SHADER_STAGE_ALL_GRAPHICS & ~VK_SHADER_STAGE_FRAGMENT_BIT))
+            .add(componentHash(PipelineComponentType::VIEWPORT_STATE))
+            .add(componentHash(PipelineComponentType::RASTERIZATION))
+            .add(dynamicHash).add(layoutKey).add(renderPassKey).add(subpass)
+            .get();
+        hashes[static_cast<size_t>(PipelineLibrary::Part::FragmentShader)] = Hasher()
+            .add(stageHash(VK_SHADER_STAGE_FRAGMENT_BIT))
+            .add(componentHash(PipelineComponentType::DEPTH_STENCIL))
+            .add(componentHash(PipelineComponentType::MULTISAMPLE))
+            .add(dynamicHash).add(layoutKey).add(renderPassKey).add(subpass)
+            .get();
+        hashes[static_cast<size_t>(PipelineLibrary::Part::FragmentOutput)] = Hasher()
+            .add(componentHash(PipelineComponentType::COLOR_BLEND))
+            .add(componentHash(PipelineComponentType::MULTISAMPLE))
+            .add(dynamicHash).add(renderPassKey).add(subpass)
+            .get();
+        return hashes;
     }
 
     VkPipeline PipelineBuilder::buildFromPreset(
@@ -102,10 +429,71 @@ namespace StarryEngine {
         return buildGraphicsPipeline(pipelineLayout, renderPass, subpass, true);
     }
 
+    VkPipeline PipelineBuilder::buildFromPreset(
+        const PipelineStatePreset& preset,
+        VkPipelineLayout pipelineLayout,
+        VkRenderPass renderPass,
+        uint32_t subpass) {
+        PresetPipelineCreateInfo presetInfo(preset);
+
+        // 预设之外只需要这几类组件
+        std::vector<PipelineComponentType> runtimeTypes = {
+            PipelineComponentType::SHADER_STAGE,
+            PipelineComponentType::VERTEX_INPUT
+        };
+        if (!presetInfo.hasDynamicViewport()) {
+            runtimeTypes.push_back(PipelineComponentType::VIEWPORT_STATE);
+        }
+
+        std::vector<ComponentSelection> selections;
+        for (auto type : runtimeTypes) {
+            auto it = std::find_if(mSelections.begin(), mSelections.end(),
+                [type](const ComponentSelection& selection) { return selection.type == type; });
+            selections.push_back(it != mSelections.end() ? *it : ComponentSelection(type));
+        }
+
+        std::vector<std::string> warnings;
+        auto components = collectComponents(*mRegistry, selections, warnings);
+        for (const auto& warning : warnings) {
+            std::cout << "  ⚠ " << warning << std::endl;
+        }
+
+        const std::vector<VkDynamicState> dynamicStates(preset.dynamicStates.states.begin(),
+            preset.dynamicStates.states.begin() + preset.dynamicStates.count);
+
+        VkGraphicsPipelineCreateInfo& pipelineInfo = presetInfo.get();
+        pipelineInfo.layout = pipelineLayout;
+        pipelineInfo.renderPass = renderPass;
+        pipelineInfo.subpass = subpass;
+
+        // 与组件路径的状态哈希区分开，避免两种构建方式误共享
+        Hasher hasher;
+        hasher.add("preset").add(preset.hash());
+        for (auto type : runtimeTypes) {
+            const auto& component = components.at(type);
+            component->apply(pipelineInfo);
+            hasher.add(type).add(component->getStaticHash(dynamicStates));
+        }
+        const uint64_t renderPassHash = RenderPass::GetCompatibilityHash(renderPass);
+        hasher.add(getLayoutKey(mDevice, pipelineLayout))
+            .add(renderPassHash != 0 ? renderPassHash : reinterpret_cast<uint64_t>(renderPass))
+            .add(subpass);
+
+        VkPipeline pipeline = createPipeline(mDevice, hasher.get(), pipelineInfo, describeComponents(components) + "[preset]");
+        recordForPrecache(mDevice, *mRegistry, selections, components, pipelineLayout, renderPass, subpass, &preset);
+        return pipeline;
+    }
+
     bool PipelineBuilder::validateSelections() const {
+        return validateSelections(*mRegistry, mSelections);
+    }
+
+    bool PipelineBuilder::validateSelections(
+        const ComponentRegistry& registry,
+        const std::vector<ComponentSelection>& selections) {
         // 检查是否有重复的组件类型
         std::unordered_set<PipelineComponentType> seenTypes;
-        for (const auto& selection : mSelections) {
+        for (const auto& selection : selections) {
             if (!seenTypes.insert(selection.type).second) {
                 std::cout << "Error: Duplicate component type: "
                     << GetComponentTypeName(selection.type) << std::endl;
@@ -127,7 +515,7 @@ namespace StarryEngine {
         for (auto type : requiredTypes) {
             if (seenTypes.find(type) == seenTypes.end()) {
                 // 尝试获取默认组件
-                auto defaultComponent = mRegistry->getDefaultComponent(type);
+                auto defaultComponent = registry.getDefaultComponent(type);
                 if (!defaultComponent) {
                     std::cout << "Error: Missing required component type: "
                         << GetComponentTypeName(type) << " and no default available" << std::endl;
@@ -190,27 +578,36 @@ namespace StarryEngine {
     std::unordered_map<PipelineComponentType,
         std::shared_ptr<IPipelineStateComponent>>
         PipelineBuilder::collectComponents(std::vector<std::string>& warnings) const {
+        return collectComponents(*mRegistry, mSelections, warnings);
+    }
+
+    std::unordered_map<PipelineComponentType,
+        std::shared_ptr<IPipelineStateComponent>>
+        PipelineBuilder::collectComponents(
+            const ComponentRegistry& registry,
+            const std::vector<ComponentSelection>& selections,
+            std::vector<std::string>& warnings) {
         std::unordered_map<PipelineComponentType,
             std::shared_ptr<IPipelineStateComponent>> components;
 
-        for (const auto& selection : mSelections) {
+        for (const auto& selection : selections) {
             std::shared_ptr<IPipelineStateComponent> component;
 
             if (!selection.name.empty()) {
                 // 尝试获取指定名称的组件
-                component = mRegistry->getComponent(selection.type, selection.name);
+                component = registry.getComponent(selection.type, selection.name);
 
                 if (!component) {
                     // 组件未找到，使用默认
                     warnings.push_back("Component not found: " +
                         std::string(GetComponentTypeName(selection.type)) +
                         "[" + selection.name + "], using default");
-                    component = mRegistry->getDefaultComponent(selection.type);
+                    component = registry.getDefaultComponent(selection.type);
                 }
             }
             else {
                 // 使用默认组件
-                component = mRegistry->getDefaultComponent(selection.type);
+                component = registry.getDefaultComponent(selection.type);
             }
 
             if (component) {
@@ -236,7 +633,7 @@ namespace StarryEngine {
         std::shared_ptr<IPipelineStateComponent>>&components,
         VkPipelineLayout pipelineLayout,
         VkRenderPass renderPass,
-        uint32_t subpass) const {
+        uint32_t subpass) {
 
         VkGraphicsPipelineCreateInfo pipelineInfo{};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -254,6 +651,14 @@ namespace StarryEngine {
         return pipelineInfo;
     }
 
+    VkGraphicsPipelineCreateInfo PipelineBuilder::resolvePipelineCreateInfo(
+        VkPipelineLayout pipelineLayout,
+        VkRenderPass renderPass,
+        uint32_t subpass) const {
+        std::vector<std::string> warnings;
+        return createPipelineCreateInfo(collectComponents(warnings), pipelineLayout, renderPass, subpass);
+    }
+
     std::string PipelineBuilder::getPipelineCreateInfo() const {
         std::stringstream ss;
         ss << "Pipeline Create Info:\n";
@@ -1,10 +1,14 @@
 #pragma once
 #include <vulkan/vulkan.h>
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include "AsyncPipeline.hpp"
+#include "PipelineLibrary.hpp"
+#include "PipelineStatePreset.hpp"
 #include "./pipelineStateComponent/ComponentRegistry.hpp"
 #include "./pipelineStateComponent/ColorBlendComponent.hpp"
 #include "./pipelineStateComponent/DepthStencilComponent.hpp"
@@ -27,6 +31,14 @@ namespace StarryEngine {
         }
     };
 
+    // 批量构建中的一条管线请求
+    struct PipelineBuildRequest {
+        std::vector<ComponentSelection> selections;
+        VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        uint32_t subpass = 0;
+    };
+
     class PipelineBuilder {
     public:
         PipelineBuilder(VkDevice device, std::shared_ptr<ComponentRegistry> registry);
@@ -41,12 +53,30 @@ namespace StarryEngine {
         PipelineBuilder& clearSelections();
 
         // 构建图形管线
+        // 设备已有PipelineCache时按有效状态哈希共享：状态相同的请求返回同一句柄并增加引用计数
+        // 返回的管线须通过releasePipeline释放，不能直接vkDestroyPipeline
         VkPipeline buildGraphicsPipeline(
             VkPipelineLayout pipelineLayout,
             VkRenderPass renderPass,
             uint32_t subpass = 0,
             bool validate = true);
 
+        // 批量构建：基于注册表的只读快照解析组件，在共享工作池上并行创建
+        // 返回值与requests一一对应，失败的请求为VK_NULL_HANDLE（错误输出到日志）
+        // 不使用当前builder的选择；不能在工作池线程中调用（会等待池中的任务）
+        std::vector<VkPipeline> buildGraphicsPipelines(
+            const std::vector<PipelineBuildRequest>& requests,
+            bool validate = true);
+
+        // 异步构建：在调用线程上验证并复制组件后立即返回，管线在共享工作池上创建
+        // 之后修改注册表中的组件不影响本次构建
+        // 设备支持管线库时按部分复用已编译的库，快速链接的结果先作为临时管线可用，优化链接完成后就绪
+        AsyncPipeline::Ptr buildGraphicsPipelineAsync(
+            VkPipelineLayout pipelineLayout,
+            VkRenderPass renderPass,
+            uint32_t subpass = 0,
+            bool validate = true);
+
         // 从预定义组合构建
         VkPipeline buildFromPreset(
             const std::string& presetName,
@@ -54,8 +84,30 @@ namespace StarryEngine {
             VkRenderPass renderPass,
             uint32_t subpass = 0);
 
+        // 从编译期预设构建：固定功能状态直接展开，不经过组件的虚函数和注册表查找
+        // 着色器阶段、顶点输入（以及预设未声明动态视口时的视口状态）取当前选择，未选择时取默认组件
+        // 预设哈希在编译期确定，与组件哈希一起作为共享键；返回的管线同样通过releasePipeline释放
+        VkPipeline buildFromPreset(
+            const PipelineStatePreset& preset,
+            VkPipelineLayout pipelineLayout,
+            VkRenderPass renderPass,
+            uint32_t subpass = 0);
+
+        // 释放buildGraphicsPipeline返回的管线（共享管线引用计数归零时才销毁）
+        static void releasePipeline(VkDevice device, VkPipeline pipeline);
+
+        // 当前选择解析后的有效状态哈希：组件内容、着色器模块哈希、布局、渲染通道和子通道
+        // 动态状态组件声明的字段（扩展动态状态）不计入，这些字段只在绘制时区分
+        uint64_t computeStateHash(
+            VkPipelineLayout pipelineLayout,
+            VkRenderPass renderPass,
+            uint32_t subpass = 0) const;
+
         // 验证组件选择
         bool validateSelections() const;
+        static bool validateSelections(
+            const ComponentRegistry& registry,
+            const std::vector<ComponentSelection>& selections);
 
         // 获取当前选择
         const std::vector<ComponentSelection>& getSelections() const { return mSelections; }
@@ -63,6 +115,13 @@ namespace StarryEngine {
         // 获取管线创建信息（用于调试）
         std::string getPipelineCreateInfo() const;
 
+        // 当前选择解析后的创建信息，不创建管线（用于基准测试等直接调用驱动的场合）
+        // 其中的指针指向注册表中的组件，组件修改或移除后失效
+        VkGraphicsPipelineCreateInfo resolvePipelineCreateInfo(
+            VkPipelineLayout pipelineLayout,
+            VkRenderPass renderPass,
+            uint32_t subpass = 0) const;
+
     private:
         VkDevice mDevice;
         std::shared_ptr<ComponentRegistry> mRegistry;
@@ -74,14 +133,70 @@ namespace StarryEngine {
         // 收集所有组件
         std::unordered_map<PipelineComponentType,
             std::shared_ptr<IPipelineStateComponent>> collectComponents(std::vector<std::string>& warnings) const;
+        static std::unordered_map<PipelineComponentType,
+            std::shared_ptr<IPipelineStateComponent>> collectComponents(
+                const ComponentRegistry& registry,
+                const std::vector<ComponentSelection>& selections,
+                std::vector<std::string>& warnings);
+
+        // 按状态哈希创建（或从设备缓存共享）管线，失败时抛出异常；name用于创建记录
+        static VkPipeline createPipeline(
+            VkDevice device,
+            uint64_t stateHash,
+            const VkGraphicsPipelineCreateInfo& pipelineInfo,
+            const std::string& name);
+
+        // 设备存在预缓存清单时记录本次创建的管线键（preset非空表示由buildFromPreset创建）
+        static void recordForPrecache(
+            VkDevice device,
+            const ComponentRegistry& registry,
+            const std::vector<ComponentSelection>& selections,
+            const std::unordered_map<PipelineComponentType,
+            std::shared_ptr<IPipelineStateComponent>>& components,
+            VkPipelineLayout pipelineLayout,
+            VkRenderPass renderPass,
+            uint32_t subpass,
+            const PipelineStatePreset* preset = nullptr);
+
+        // 组件名称按类型顺序拼接，作为创建记录中的管线名
+        static std::string describeComponents(
+            const std::unordered_map<PipelineComponentType,
+            std::shared_ptr<IPipelineStateComponent>>& components);
+
+        // 组件中DynamicStateComponent声明的动态状态（没有时为空）
+        static const std::vector<VkDynamicState>& getDynamicStates(
+            const std::unordered_map<PipelineComponentType,
+            std::shared_ptr<IPipelineStateComponent>>& components);
+
+        // 布局取LayoutCache中的内容哈希，不在缓存中时退回句柄
+        static uint64_t computeStateHash(
+            VkDevice device,
+            const std::unordered_map<PipelineComponentType,
+            std::shared_ptr<IPipelineStateComponent>>& components,
+            VkPipelineLayout pipelineLayout,
+            VkRenderPass renderPass,
+            uint32_t subpass);
+
+        // 布局的去重键：LayoutCache中的内容哈希，不在缓存中时退回句柄
+        // 销毁后句柄可能被新的不同布局重用，内容相同的布局则应共用管线
+        static uint64_t getLayoutKey(VkDevice device, VkPipelineLayout pipelineLayout);
+
+        // 管线库各部分的哈希，只包含影响该部分的组件（顺序同PipelineLibrary::Part）
+        static std::array<uint64_t, PipelineLibrary::PART_COUNT> computeLibraryPartHashes(
+            VkDevice device,
+            const std::unordered_map<PipelineComponentType,
+            std::shared_ptr<IPipelineStateComponent>>& components,
+            VkPipelineLayout pipelineLayout,
+            VkRenderPass renderPass,
+            uint32_t subpass);
 
         // 创建管线创建信息结构
-        VkGraphicsPipelineCreateInfo createPipelineCreateInfo(
+        static VkGraphicsPipelineCreateInfo createPipelineCreateInfo(
             const std::unordered_map<PipelineComponentType,
             std::shared_ptr<IPipelineStateComponent>>&components,
             VkPipelineLayout pipelineLayout,
             VkRenderPass renderPass,
-            uint32_t subpass) const;
+            uint32_t subpass);
     };
 
 } // namespace StarryEngine
\ No newline at end of file
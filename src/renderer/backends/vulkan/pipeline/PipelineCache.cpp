@@ -1,25 +1,60 @@
 #include "PipelineCache.hpp"
-#include <stdexcept>
+#include "PipelineFeedback.hpp"
+#include "../../../utils/Hash.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace StarryEngine {
+    namespace fs = std::filesystem;
 
-    PipelineCache::PipelineCache(VkDevice device) : mDevice(device) {
+    namespace {
+        std::mutex sCacheMutex;
+        std::unordered_map<VkDevice, std::weak_ptr<PipelineCache>> sCaches;
     }
 
-    PipelineCache::~PipelineCache() {
-        cleanup();
+    PipelineCache::Ptr PipelineCache::acquire(const LogicalDevice::Ptr& logicalDevice) {
+        std::lock_guard<std::mutex> lock(sCacheMutex);
+        auto& weak = sCaches[logicalDevice->getHandle()];
+        if (auto cache = weak.lock()) {
+            return cache;
+        }
+        auto cache = std::make_shared<PipelineCache>(logicalDevice);
+        weak = cache;
+        return cache;
     }
 
-    bool PipelineCache::initialize() {
+    PipelineCache::Ptr PipelineCache::find(VkDevice device) {
+        std::lock_guard<std::mutex> lock(sCacheMutex);
+        auto it = sCaches.find(device);
+        return it != sCaches.end() ? it->second.lock() : nullptr;
+    }
+
+    VkPipelineCache PipelineCache::getHandle(VkDevice device) {
+        auto cache = find(device);
+        return cache ? cache->getHandle() : VK_NULL_HANDLE;
+    }
+
+    PipelineCache::PipelineCache(const LogicalDevice::Ptr& logicalDevice)
+        : mLogicalDevice(logicalDevice), mDevice(logicalDevice->getHandle()) {
         VkPipelineCacheCreateInfo createInfo = {};
         createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 
-        VkResult result = vkCreatePipelineCache(mDevice, &createInfo, nullptr, &mPipelineCache);
-        return result == VK_SUCCESS;
+        if (vkCreatePipelineCache(mDevice, &createInfo, nullptr, &mPipelineCache) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create pipeline cache!");
+        }
+    }
+
+    PipelineCache::~PipelineCache() {
+        cleanup();
     }
 
     void PipelineCache::cleanup() {
+        std::lock_guard<std::mutex> lock(mMutex);
         if (mPipelineCache != VK_NULL_HANDLE) {
             vkDestroyPipelineCache(mDevice, mPipelineCache, nullptr);
             mPipelineCache = VK_NULL_HANDLE;
@@ -35,33 +70,185 @@ namespace StarryEngine {
         for (auto& layout : mPipelineLayouts) {
             vkDestroyPipelineLayout(mDevice, layout.second, nullptr);
         }
+        for (auto& [stateHash, shared] : mSharedPipelines) {
+            vkDestroyPipeline(mDevice, shared.pipeline, nullptr);
+        }
 
         mGraphicsPipelines.clear();
         mComputePipelines.clear();
         mPipelineLayouts.clear();
+        mSharedPipelines.clear();
+        mSharedPipelineKeys.clear();
+        mFallbackPipelines.clear();
+    }
+
+    bool PipelineCache::isCompatible(const void* data, size_t size) const {
+        VkPipelineCacheHeaderVersionOne header{};
+        if (size < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+
+        const VkPhysicalDeviceProperties properties = mLogicalDevice->getPhysicalDevice()->getDeviceProperties();
+        return header.headerSize >= sizeof(header) && header.headerSize <= size
+            && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+            && header.vendorID == properties.vendorID
+            && header.deviceID == properties.deviceID
+            && std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+    bool PipelineCache::load(const std::string& path) {
+        mPath = path;
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+        const auto fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+
+        FileHeader header{};
+        if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            std::cerr << "PipelineCache: truncated file " << path << std::endl;
+            return false;
+        }
+        if (header.magic != FILE_MAGIC || header.version != FILE_VERSION
+            || header.dataSize != fileSize - sizeof(header)) {
+            std::cerr << "PipelineCache: ignoring incompatible file " << path << std::endl;
+            return false;
+        }
+
+        std::vector<char> data(header.dataSize);
+        if (!file.read(data.data(), data.size())
+            || hashBytes(data.data(), data.size()) != header.checksum) {
+            std::cerr << "PipelineCache: checksum mismatch in " << path << std::endl;
+            return false;
+        }
+
+        // 驱动或设备变化后旧数据无效，直接丢弃（部分驱动遇到不匹配的数据会崩溃）
+        if (!isCompatible(data.data(), data.size())) {
+            std::cout << "PipelineCache: " << path << " was created by a different device or driver, ignoring" << std::endl;
+            return false;
+        }
+
+        VkPipelineCacheCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = data.size();
+        createInfo.pInitialData = data.data();
+
+        VkPipelineCache loaded = VK_NULL_HANDLE;
+        if (vkCreatePipelineCache(mDevice, &createInfo, nullptr, &loaded) != VK_SUCCESS) {
+            std::cerr << "PipelineCache: driver rejected " << path << std::endl;
+            return false;
+        }
+
+        // 合并到已有缓存，加载前创建的管线数据不会丢失
+        const VkResult result = vkMergePipelineCaches(mDevice, mPipelineCache, 1, &loaded);
+        vkDestroyPipelineCache(mDevice, loaded, nullptr);
+        if (result != VK_SUCCESS) {
+            std::cerr << "PipelineCache: failed to merge " << path << std::endl;
+            return false;
+        }
+
+        std::cout << "PipelineCache: loaded " << data.size() << " bytes from " << path << std::endl;
+        return true;
+    }
+
+    bool PipelineCache::save() const {
+        if (mPath.empty()) {
+            return false;
+        }
+        return save(mPath);
+    }
+
+    bool PipelineCache::save(const std::string& path) const {
+        if (mPipelineCache == VK_NULL_HANDLE) {
+            return false;
+        }
+
+        size_t dataSize = 0;
+        if (vkGetPipelineCacheData(mDevice, mPipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) {
+            return false;
+        }
+        std::vector<char> data(dataSize);
+        if (vkGetPipelineCacheData(mDevice, mPipelineCache, &dataSize, data.data()) != VK_SUCCESS) {
+            std::cerr << "PipelineCache: failed to read cache data" << std::endl;
+            return false;
+        }
+        data.resize(dataSize);
+
+        FileHeader header{};
+        header.magic = FILE_MAGIC;
+        header.version = FILE_VERSION;
+        header.dataSize = data.size();
+        header.checksum = hashBytes(data.data(), data.size());
+
+        const fs::path finalPath = path;
+        std::error_code ec;
+        if (finalPath.has_parent_path()) {
+            fs::create_directories(finalPath.parent_path(), ec);
+        }
+
+        // 先写临时文件再重命名，中途退出不会留下半个缓存文件
+        const uint64_t writerId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        fs::path tempPath = finalPath;
+        tempPath += "." + hashToHex(writerId) + ".tmp";
+
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                std::cerr << "PipelineCache: failed to write " << tempPath.string() << std::endl;
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(data.data(), data.size());
+            file.flush();
+            if (!file) {
+                file.close();
+                fs::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        fs::rename(tempPath, finalPath, ec);
+        if (ec) {
+            std::cerr << "PipelineCache: failed to commit " << finalPath.string()
+                << ": " << ec.message() << std::endl;
+            fs::remove(tempPath, ec);
+            return false;
+        }
+        return true;
     }
 
     VkPipeline PipelineCache::getGraphicsPipeline(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mMutex);
         auto it = mGraphicsPipelines.find(name);
         return it != mGraphicsPipelines.end() ? it->second : VK_NULL_HANDLE;
     }
 
     VkPipeline PipelineCache::getComputePipeline(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mMutex);
         auto it = mComputePipelines.find(name);
         return it != mComputePipelines.end() ? it->second : VK_NULL_HANDLE;
     }
 
     VkPipelineLayout PipelineCache::getPipelineLayout(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mMutex);
         auto it = mPipelineLayouts.find(name);
         return it != mPipelineLayouts.end() ? it->second : VK_NULL_HANDLE;
     }
 
     bool PipelineCache::registerGraphicsPipeline(const std::string& name, const VkGraphicsPipelineCreateInfo& createInfo) {
         VkPipeline pipeline;
-        VkResult result = vkCreateGraphicsPipelines(mDevice, mPipelineCache, 1, &createInfo, nullptr, &pipeline);
+        VkResult result = PipelineFeedback::createGraphicsPipeline(mDevice, mPipelineCache, createInfo, pipeline, name);
 
         if (result == VK_SUCCESS) {
-            mGraphicsPipelines[name] = pipeline;
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto& slot = mGraphicsPipelines[name];
+            if (slot != VK_NULL_HANDLE) {
+                vkDestroyPipeline(mDevice, slot, nullptr);
+            }
+            slot = pipeline;
             return true;
         }
 
@@ -70,14 +257,104 @@ namespace StarryEngine {
 
     bool PipelineCache::registerComputePipeline(const std::string& name, const VkComputePipelineCreateInfo& createInfo) {
         VkPipeline pipeline;
-        VkResult result = vkCreateComputePipelines(mDevice, mPipelineCache, 1, &createInfo, nullptr, &pipeline);
+        VkResult result = PipelineFeedback::createComputePipeline(mDevice, mPipelineCache, createInfo, pipeline, name);
 
         if (result == VK_SUCCESS) {
-            mComputePipelines[name] = pipeline;
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto& slot = mComputePipelines[name];
+            if (slot != VK_NULL_HANDLE) {
+                vkDestroyPipeline(mDevice, slot, nullptr);
+            }
+            slot = pipeline;
             return true;
         }
 
         return false;
     }
 
-} // namespace StarryEngine
\ No newline at end of file
+    VkResult PipelineCache::acquireGraphicsPipeline(uint64_t stateHash,
+        const VkGraphicsPipelineCreateInfo& createInfo, VkPipeline& outPipeline, const std::string& name) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mSharedPipelines.find(stateHash);
+            if (it != mSharedPipelines.end()) {
+                it->second.refCount++;
+                mSharedReusedCount++;
+                outPipeline = it->second.pipeline;
+                return VK_SUCCESS;
+            }
+        }
+
+        // 在锁外创建管线（编译可能很慢）
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkResult result = PipelineFeedback::createGraphicsPipeline(mDevice, mPipelineCache, createInfo, pipeline,
+            name, stateHash);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto [it, inserted] = mSharedPipelines.try_emplace(stateHash);
+        if (!inserted) {
+            // 其他线程已创建了相同状态的管线
+            vkDestroyPipeline(mDevice, pipeline, nullptr);
+            mSharedReusedCount++;
+        }
+        else {
+            it->second.pipeline = pipeline;
+            mSharedPipelineKeys[pipeline] = stateHash;
+            mSharedCreatedCount++;
+        }
+        it->second.refCount++;
+        outPipeline = it->second.pipeline;
+        return VK_SUCCESS;
+    }
+
+    bool PipelineCache::releasePipeline(VkPipeline pipeline) {
+        VkPipeline destroyed = VK_NULL_HANDLE;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto keyIt = mSharedPipelineKeys.find(pipeline);
+            if (keyIt == mSharedPipelineKeys.end()) {
+                return false;
+            }
+            auto it = mSharedPipelines.find(keyIt->second);
+            if (--it->second.refCount == 0) {
+                destroyed = it->second.pipeline;
+                mSharedPipelines.erase(it);
+                mSharedPipelineKeys.erase(keyIt);
+            }
+        }
+
+        if (destroyed != VK_NULL_HANDLE) {
+            vkDestroyPipeline(mDevice, destroyed, nullptr);
+        }
+        return true;
+    }
+
+    PipelineCache::SharedPipelineStats PipelineCache::getSharedPipelineStats() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        SharedPipelineStats stats;
+        stats.created = mSharedCreatedCount;
+        stats.reused = mSharedReusedCount;
+        stats.livePipelines = mSharedPipelines.size();
+        return stats;
+    }
+
+    void PipelineCache::setFallbackPipeline(VkPipelineLayout pipelineLayout, VkPipeline pipeline) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (pipeline == VK_NULL_HANDLE) {
+            mFallbackPipelines.erase(pipelineLayout);
+        }
+        else {
+            mFallbackPipelines[pipelineLayout] = pipeline;
+        }
+    }
+
+    VkPipeline PipelineCache::getFallbackPipeline(VkPipelineLayout pipelineLayout) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mFallbackPipelines.find(pipelineLayout);
+        return it != mFallbackPipelines.end() ? it->second : VK_NULL_HANDLE;
+    }
+
+} // namespace StarryEngine
@@ -1,18 +1,49 @@
 #pragma once
 #include <vulkan/vulkan.h>
+#include "../vulkanCore/LogicalDevice.hpp"
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
 namespace StarryEngine {
 
+    // 设备级管线缓存：所有管线创建路径共享同一个VkPipelineCache
+    // 启动时从磁盘加载（校验厂商/设备/UUID），退出时原子写回
     class PipelineCache {
     public:
-        PipelineCache(VkDevice device);
+        using Ptr = std::shared_ptr<PipelineCache>;
+
+        struct SharedPipelineStats {
+            uint64_t created = 0;     // 实际创建的管线数
+            uint64_t reused = 0;      // 命中已有管线的次数
+            size_t livePipelines = 0; // 当前存活的共享管线数
+        };
+
+        // 获取设备对应的缓存（同一设备返回同一实例）
+        static Ptr acquire(const LogicalDevice::Ptr& logicalDevice);
+
+        // 查找设备已有的缓存，不存在时返回nullptr（供只持有VkDevice的调用方使用）
+        static Ptr find(VkDevice device);
+
+        // 设备缓存的句柄，不存在时返回VK_NULL_HANDLE
+        static VkPipelineCache getHandle(VkDevice device);
+
+        PipelineCache(const LogicalDevice::Ptr& logicalDevice);
         ~PipelineCache();
 
-        bool initialize();
         void cleanup();
 
+        VkPipelineCache getHandle() const { return mPipelineCache; }
+
+        // 从磁盘合并缓存数据，并记录save()的目标路径
+        // 文件不存在、损坏或来自其他设备/驱动时返回false（缓存保持可用）
+        bool load(const std::string& path);
+
+        // 写回load()指定的路径（先写临时文件再重命名）
+        bool save() const;
+        bool save(const std::string& path) const;
+
         VkPipeline getGraphicsPipeline(const std::string& name);
         VkPipeline getComputePipeline(const std::string& name);
         VkPipelineLayout getPipelineLayout(const std::string& name);
@@ -20,13 +51,57 @@ namespace StarryEngine {
         bool registerGraphicsPipeline(const std::string& name, const VkGraphicsPipelineCreateInfo& createInfo);
         bool registerComputePipeline(const std::string& name, const VkComputePipelineCreateInfo& createInfo);
 
+        // 按有效状态哈希共享管线：命中时增加引用计数并返回已有句柄，否则创建新管线
+        // 线程安全；创建在锁外进行，并发创建同一状态时只保留一个；name只用于创建记录
+        VkResult acquireGraphicsPipeline(uint64_t stateHash, const VkGraphicsPipelineCreateInfo& createInfo,
+            VkPipeline& outPipeline, const std::string& name = "");
+
+        // 减少引用计数，归零时销毁；不是由acquireGraphicsPipeline创建的管线返回false
+        bool releasePipeline(VkPipeline pipeline);
+
+        SharedPipelineStats getSharedPipelineStats() const;
+
+        // 后备管线：异步管线未就绪时，RenderContext改用相同布局的后备管线绘制
+        // 后备管线由调用方持有，销毁前须以VK_NULL_HANDLE取消注册
+        void setFallbackPipeline(VkPipelineLayout pipelineLayout, VkPipeline pipeline);
+        VkPipeline getFallbackPipeline(VkPipelineLayout pipelineLayout) const;
+
     private:
+        // 文件头，数据部分为vkGetPipelineCacheData的原始输出
+        struct FileHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t dataSize;
+            uint64_t checksum;
+        };
+
+        static constexpr uint32_t FILE_MAGIC = 0x434C5053; // "SPLC"
+        static constexpr uint32_t FILE_VERSION = 1;
+
+        // 校验驱动数据头是否与当前物理设备匹配
+        bool isCompatible(const void* data, size_t size) const;
+
+    private:
+        LogicalDevice::Ptr mLogicalDevice;
         VkDevice mDevice;
         VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
+        std::string mPath;
 
+        struct SharedPipeline {
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            uint32_t refCount = 0;
+        };
+
+        mutable std::mutex mMutex;
         std::unordered_map<std::string, VkPipeline> mGraphicsPipelines;
         std::unordered_map<std::string, VkPipeline> mComputePipelines;
         std::unordered_map<std::string, VkPipelineLayout> mPipelineLayouts;
+
+        std::unordered_map<uint64_t, SharedPipeline> mSharedPipelines;
+        std::unordered_map<VkPipeline, uint64_t> mSharedPipelineKeys;
+        std::unordered_map<VkPipelineLayout, VkPipeline> mFallbackPipelines;
+        uint64_t mSharedCreatedCount = 0;
+        uint64_t mSharedReusedCount = 0;
     };
 
-} // namespace StarryEngine
\ No newline at end of file
+} // namespace StarryEngine
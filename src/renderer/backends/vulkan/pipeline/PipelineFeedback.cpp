@@ -0,0 +1,238 @@
+#include "PipelineFeedback.hpp"
+#include "../../../utils/Hash.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace StarryEngine {
+
+    namespace {
+        std::mutex sFeedbackMutex;
+        std::unordered_map<VkDevice, std::weak_ptr<PipelineFeedback>> sFeedbacks;
+
+        std::string escapeJson(const std::string& value) {
+            std::string out;
+            out.reserve(value.size());
+            for (char c : value) {
+                switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        out += ' ';
+                    }
+                    else {
+                        out += c;
+                    }
+                }
+            }
+            return out;
+        }
+
+        const char* getStageName(VkShaderStageFlagBits stage) {
+            switch (stage) {
+            case VK_SHADER_STAGE_VERTEX_BIT: return "vertex";
+            case VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT: return "tessellation_control";
+            case VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT: return "tessellation_evaluation";
+            case VK_SHADER_STAGE_GEOMETRY_BIT: return "geometry";
+            case VK_SHADER_STAGE_FRAGMENT_BIT: return "fragment";
+            case VK_SHADER_STAGE_COMPUTE_BIT: return "compute";
+            default: return "other";
+            }
+        }
+    }
+
+    PipelineFeedback::Ptr PipelineFeedback::acquire(const LogicalDevice::Ptr& logicalDevice) {
+        std::lock_guard<std::mutex> lock(sFeedbackMutex);
+        auto& weak = sFeedbacks[logicalDevice->getHandle()];
+        if (auto feedback = weak.lock()) {
+            return feedback;
+        }
+        auto feedback = std::make_shared<PipelineFeedback>(logicalDevice);
+        weak = feedback;
+        return feedback;
+    }
+
+    PipelineFeedback::Ptr PipelineFeedback::find(VkDevice device) {
+        std::lock_guard<std::mutex> lock(sFeedbackMutex);
+        auto it = sFeedbacks.find(device);
+        return it != sFeedbacks.end() ? it->second.lock() : nullptr;
+    }
+
+    PipelineFeedback::PipelineFeedback(const LogicalDevice::Ptr& logicalDevice)
+        : mLogicalDevice(logicalDevice), mDevice(logicalDevice->getHandle()),
+        mFeedbackSupported(logicalDevice->getOptionalFeatures().pipelineCreationFeedback) {
+    }
+
+    VkResult PipelineFeedback::createGraphicsPipeline(VkDevice device, VkPipelineCache pipelineCache,
+        const VkGraphicsPipelineCreateInfo& createInfo, VkPipeline& outPipeline,
+        const std::string& name, uint64_t componentHash) {
+        auto feedback = find(device);
+        auto createFunction = [device, pipelineCache, &outPipeline](const VkGraphicsPipelineCreateInfo& info) {
+            return vkCreateGraphicsPipelines(device, pipelineCache, 1, &info, nullptr, &outPipeline);
+        };
+        if (!feedback) {
+            return createFunction(createInfo);
+        }
+        return feedback->create(createInfo, createInfo.stageCount, createInfo.pStages,
+            createFunction, name, componentHash);
+    }
+
+    VkResult PipelineFeedback::createComputePipeline(VkDevice device, VkPipelineCache pipelineCache,
+        const VkComputePipelineCreateInfo& createInfo, VkPipeline& outPipeline,
+        const std::string& name, uint64_t componentHash) {
+        auto feedback = find(device);
+        auto createFunction = [device, pipelineCache, &outPipeline](const VkComputePipelineCreateInfo& info) {
+            return vkCreateComputePipelines(device, pipelineCache, 1, &info, nullptr, &outPipeline);
+        };
+        if (!feedback) {
+            return createFunction(createInfo);
+        }
+        return feedback->create(createInfo, 1, &createInfo.stage, createFunction, name, componentHash);
+    }
+
+    template<typename CreateInfo, typename CreateFunction>
+    VkResult PipelineFeedback::create(const CreateInfo& createInfo, uint32_t stageCount,
+        const VkPipelineShaderStageCreateInfo* stages, CreateFunction&& createFunction,
+        const std::string& name, uint64_t componentHash) {
+        VkPipelineCreationFeedback pipelineFeedback{};
+        std::vector<VkPipelineCreationFeedback> stageFeedbacks(stageCount);
+        VkPipelineCreationFeedbackCreateInfo feedbackInfo{};
+        feedbackInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO;
+        feedbackInfo.pPipelineCreationFeedback = &pipelineFeedback;
+        feedbackInfo.pipelineStageCreationFeedbackCount = stageCount;
+        feedbackInfo.pPipelineStageCreationFeedbacks = stageFeedbacks.empty() ? nullptr : stageFeedbacks.data();
+
+        // 反馈结构插在调用方pNext链的最前面，不修改调用方的创建信息
+        CreateInfo info = createInfo;
+        if (mFeedbackSupported) {
+            feedbackInfo.pNext = info.pNext;
+            info.pNext = &feedbackInfo;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        VkResult result = createFunction(info);
+        const auto wallTime = std::chrono::steady_clock::now() - start;
+
+        Record record;
+        record.name = name;
+        record.componentHash = componentHash;
+        record.result = result;
+        record.wallTimeNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(wallTime).count());
+        if (mFeedbackSupported && result == VK_SUCCESS) {
+            record.feedbackValid = (pipelineFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) != 0;
+            record.cacheHit = (pipelineFeedback.flags &
+                VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT) != 0;
+            record.basePipelineAccelerated = (pipelineFeedback.flags &
+                VK_PIPELINE_CREATION_FEEDBACK_BASE_PIPELINE_ACCELERATION_BIT) != 0;
+            record.driverDurationNs = pipelineFeedback.duration;
+            for (uint32_t i = 0; i < stageCount; ++i) {
+                StageRecord stage;
+                stage.stage = stages[i].stage;
+                stage.valid = (stageFeedbacks[i].flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) != 0;
+                stage.cacheHit = (stageFeedbacks[i].flags &
+                    VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT) != 0;
+                stage.durationNs = stageFeedbacks[i].duration;
+                record.stages.push_back(stage);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRecords.push_back(std::move(record));
+        return result;
+    }
+
+    std::vector<PipelineFeedback::Record> PipelineFeedback::getRecords() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mRecords;
+    }
+
+    size_t PipelineFeedback::getRecordCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mRecords.size();
+    }
+
+    void PipelineFeedback::clear() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRecords.clear();
+    }
+
+    std::string PipelineFeedback::toJson() const {
+        auto records = getRecords();
+
+        std::ostringstream out;
+        out << "{\n  \"feedbackSupported\": " << (mFeedbackSupported ? "true" : "false") << ",\n";
+        out << "  \"pipelines\": [";
+        for (size_t i = 0; i < records.size(); ++i) {
+            const auto& record = records[i];
+            out << (i == 0 ? "\n" : ",\n");
+            out << "    {\"name\": \"" << escapeJson(record.name) << "\""
+                << ", \"componentHash\": \"" << hashToHex(record.componentHash) << "\""
+                << ", \"result\": " << static_cast<int32_t>(record.result)
+                << ", \"wallTimeNs\": " << record.wallTimeNs
+                << ", \"feedbackValid\": " << (record.feedbackValid ? "true" : "false")
+                << ", \"cacheHit\": " << (record.cacheHit ? "true" : "false")
+                << ", \"basePipelineAccelerated\": " << (record.basePipelineAccelerated ? "true" : "false")
+                << ", \"driverDurationNs\": " << record.driverDurationNs
+                << ", \"stages\": [";
+            for (size_t j = 0; j < record.stages.size(); ++j) {
+                const auto& stage = record.stages[j];
+                out << (j == 0 ? "" : ", ")
+                    << "{\"stage\": \"" << getStageName(stage.stage) << "\""
+                    << ", \"valid\": " << (stage.valid ? "true" : "false")
+                    << ", \"cacheHit\": " << (stage.cacheHit ? "true" : "false")
+                    << ", \"durationNs\": " << stage.durationNs << "}";
+            }
+            out << "]}";
+        }
+        out << (records.empty() ? "]\n}\n" : "\n  ]\n}\n");
+        return out.str();
+    }
+
+    bool PipelineFeedback::writeJson(const std::string& path) const {
+        const std::string json = toJson();
+
+        const fs::path finalPath = path;
+        std::error_code ec;
+        if (finalPath.has_parent_path()) {
+            fs::create_directories(finalPath.parent_path(), ec);
+        }
+
+        const uint64_t writerId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        fs::path tempPath = finalPath;
+        tempPath += "." + hashToHex(writerId) + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                std::cerr << "PipelineFeedback: failed to write " << tempPath.string() << std::endl;
+                return false;
+            }
+            file.write(json.data(), json.size());
+            file.flush();
+            if (!file) {
+                file.close();
+                fs::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        fs::rename(tempPath, finalPath, ec);
+        if (ec) {
+            std::cerr << "PipelineFeedback: failed to commit " << finalPath.string()
+                << ": " << ec.message() << std::endl;
+            fs::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace StarryEngine
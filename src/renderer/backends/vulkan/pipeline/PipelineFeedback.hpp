@@ -0,0 +1,80 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include "../vulkanCore/LogicalDevice.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace StarryEngine {
+
+    // 管线创建记录：每次创建都链接VkPipelineCreationFeedbackCreateInfo并统计耗时
+    // 用于找出编译慢、未命中驱动缓存的管线，决定哪些需要预编译
+    class PipelineFeedback {
+    public:
+        using Ptr = std::shared_ptr<PipelineFeedback>;
+
+        struct StageRecord {
+            VkShaderStageFlagBits stage = VK_SHADER_STAGE_VERTEX_BIT;
+            bool valid = false;         // 驱动提供了该阶段的反馈
+            bool cacheHit = false;      // 阶段命中VkPipelineCache
+            uint64_t durationNs = 0;
+        };
+
+        struct Record {
+            std::string name;
+            uint64_t componentHash = 0; // 组件状态哈希（共享管线的键），未知时为0
+            VkResult result = VK_SUCCESS;
+            uint64_t wallTimeNs = 0;    // 调用vkCreate*Pipelines的墙钟时间
+            bool feedbackValid = false; // 以下字段由驱动填写，否则无意义
+            bool cacheHit = false;
+            bool basePipelineAccelerated = false;
+            uint64_t driverDurationNs = 0;
+            std::vector<StageRecord> stages;
+        };
+
+        // 获取设备对应的记录器（同一设备返回同一实例）
+        static Ptr acquire(const LogicalDevice::Ptr& logicalDevice);
+
+        // 查找设备已有的记录器，不存在时返回nullptr
+        static Ptr find(VkDevice device);
+
+        // 创建管线并记录；设备没有记录器时直接创建（不记录）
+        // 所有管线创建路径都应通过这两个函数调用驱动
+        static VkResult createGraphicsPipeline(VkDevice device, VkPipelineCache pipelineCache,
+            const VkGraphicsPipelineCreateInfo& createInfo, VkPipeline& outPipeline,
+            const std::string& name, uint64_t componentHash = 0);
+        static VkResult createComputePipeline(VkDevice device, VkPipelineCache pipelineCache,
+            const VkComputePipelineCreateInfo& createInfo, VkPipeline& outPipeline,
+            const std::string& name, uint64_t componentHash = 0);
+
+        PipelineFeedback(const LogicalDevice::Ptr& logicalDevice);
+
+        PipelineFeedback(const PipelineFeedback&) = delete;
+        PipelineFeedback& operator=(const PipelineFeedback&) = delete;
+
+        // 驱动是否提供反馈（未提供时只记录墙钟时间）
+        bool isFeedbackSupported() const { return mFeedbackSupported; }
+
+        std::vector<Record> getRecords() const;
+        size_t getRecordCount() const;
+        void clear();
+
+        std::string toJson() const;
+        // 写入JSON文件（先写临时文件再重命名）
+        bool writeJson(const std::string& path) const;
+
+    private:
+        template<typename CreateInfo, typename CreateFunction>
+        VkResult create(const CreateInfo& createInfo, uint32_t stageCount, const VkPipelineShaderStageCreateInfo* stages,
+            CreateFunction&& createFunction, const std::string& name, uint64_t componentHash);
+
+        LogicalDevice::Ptr mLogicalDevice;
+        VkDevice mDevice;
+        bool mFeedbackSupported = false;
+
+        mutable std::mutex mMutex;
+        std::vector<Record> mRecords;
+    };
+
+} // namespace StarryEngine
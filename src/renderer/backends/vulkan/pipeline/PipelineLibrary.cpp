@@ -0,0 +1,265 @@
+#include "PipelineLibrary.hpp"
+#include "PipelineCache.hpp"
+#include "PipelineFeedback.hpp"
+#include "../../../utils/Hash.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace StarryEngine {
+
+    namespace {
+        std::mutex sLibraryMutex;
+        std::unordered_map<VkDevice, std::weak_ptr<PipelineLibrary>> sLibraries;
+
+        VkGraphicsPipelineLibraryFlagsEXT getLibraryFlag(PipelineLibrary::Part part) {
+            switch (part) {
+            case PipelineLibrary::Part::VertexInput:
+                return VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT;
+            case PipelineLibrary::Part::PreRasterization:
+                return VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT;
+            case PipelineLibrary::Part::FragmentShader:
+                return VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT;
+            case PipelineLibrary::Part::FragmentOutput:
+                return VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT;
+            default:
+                return 0;
+            }
+        }
+    }
+
+    PipelineLibrary::Ptr PipelineLibrary::acquire(const LogicalDevice::Ptr& logicalDevice) {
+        if (!logicalDevice->getOptionalFeatures().graphicsPipelineLibrary) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(sLibraryMutex);
+        auto& weak = sLibraries[logicalDevice->getHandle()];
+        if (auto library = weak.lock()) {
+            return library;
+        }
+        auto library = std::make_shared<PipelineLibrary>(logicalDevice);
+        weak = library;
+        return library;
+    }
+
+    PipelineLibrary::Ptr PipelineLibrary::find(VkDevice device) {
+        std::lock_guard<std::mutex> lock(sLibraryMutex);
+        auto it = sLibraries.find(device);
+        return it != sLibraries.end() ? it->second.lock() : nullptr;
+    }
+
+    PipelineLibrary::PipelineLibrary(const LogicalDevice::Ptr& logicalDevice)
+        : mLogicalDevice(logicalDevice), mDevice(logicalDevice->getHandle()),
+        mFastLinking(logicalDevice->getOptionalFeatures().graphicsPipelineLibraryFastLinking) {
+    }
+
+    PipelineLibrary::~PipelineLibrary() {
+        cleanup();
+    }
+
+    void PipelineLibrary::cleanup() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& [key, part] : mParts) {
+            vkDestroyPipeline(mDevice, part.pipeline, nullptr);
+        }
+        mParts.clear();
+        mPartKeys.clear();
+        mLinkedPipelines.clear();
+    }
+
+    VkPipeline PipelineLibrary::acquirePart(Part part, uint64_t partHash,
+        const VkGraphicsPipelineCreateInfo& pipelineInfo) {
+        const uint64_t key = Hasher().add(part).add(partHash).get();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mParts.find(key);
+            if (it != mParts.end()) {
+                mPartsReused++;
+                it->second.refCount++;
+                return it->second.pipeline;
+            }
+        }
+
+        VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo{};
+        libraryInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+        libraryInfo.flags = getLibraryFlag(part);
+
+        // 只保留该部分需要的状态，其余置空
+        VkGraphicsPipelineCreateInfo partInfo{};
+        partInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        partInfo.pNext = &libraryInfo;
+        partInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR |
+            VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+        partInfo.pDynamicState = pipelineInfo.pDynamicState;
+        partInfo.basePipelineIndex = -1;
+
+        std::vector<VkPipelineShaderStageCreateInfo> stages;
+        switch (part) {
+        case Part::VertexInput:
+            partInfo.pVertexInputState = pipelineInfo.pVertexInputState;
+            partInfo.pInputAssemblyState = pipelineInfo.pInputAssemblyState;
+            break;
+        case Part::PreRasterization:
+            for (uint32_t i = 0; i < pipelineInfo.stageCount; ++i) {
+                if (pipelineInfo.pStages[i].stage != VK_SHADER_STAGE_FRAGMENT_BIT) {
+                    stages.push_back(pipelineInfo.pStages[i]);
+                }
+            }
+            partInfo.pViewportState = pipelineInfo.pViewportState;
+            partInfo.pRasterizationState = pipelineInfo.pRasterizationState;
+            partInfo.pTessellationState = pipelineInfo.pTessellationState;
+            partInfo.layout = pipelineInfo.layout;
+            partInfo.renderPass = pipelineInfo.renderPass;
+            partInfo.subpass = pipelineInfo.subpass;
+            break;
+        case Part::FragmentShader:
+            for (uint32_t i = 0; i < pipelineInfo.stageCount; ++i) {
+                if (pipelineInfo.pStages[i].stage == VK_SHADER_STAGE_FRAGMENT_BIT) {
+                    stages.push_back(pipelineInfo.pStages[i]);
+                }
+            }
+            partInfo.pDepthStencilState = pipelineInfo.pDepthStencilState;
+            partInfo.pMultisampleState = pipelineInfo.pMultisampleState;
+            partInfo.layout = pipelineInfo.layout;
+            partInfo.renderPass = pipelineInfo.renderPass;
+            partInfo.subpass = pipelineInfo.subpass;
+            break;
+        case Part::FragmentOutput:
+            partInfo.pColorBlendState = pipelineInfo.pColorBlendState;
+            partInfo.pMultisampleState = pipelineInfo.pMultisampleState;
+            partInfo.renderPass = pipelineInfo.renderPass;
+            partInfo.subpass = pipelineInfo.subpass;
+            break;
+        default:
+            throw std::invalid_argument("Invalid pipeline library part");
+        }
+        partInfo.stageCount = static_cast<uint32_t>(stages.size());
+        partInfo.pStages = stages.empty() ? nullptr : stages.data();
+
+        // 在锁外编译
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkResult result = PipelineFeedback::createGraphicsPipeline(mDevice, PipelineCache::getHandle(mDevice),
+            partInfo, pipeline, "LibraryPart" + std::to_string(static_cast<uint32_t>(part)), partHash);
+        if (result != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create pipeline library part " +
+                std::to_string(static_cast<uint32_t>(part)) + ": VkResult = " + std::to_string(result));
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto [it, inserted] = mParts.try_emplace(key, PartEntry{ pipeline, 0 });
+        if (!inserted) {
+            // 其他线程已创建了相同的部分
+            vkDestroyPipeline(mDevice, pipeline, nullptr);
+            mPartsReused++;
+        }
+        else {
+            mPartKeys[pipeline] = key;
+            mPartsCreated++;
+        }
+        it->second.refCount++;
+        return it->second.pipeline;
+    }
+
+    void PipelineLibrary::releaseParts(const Parts& parts) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (VkPipeline part : parts) {
+            releasePartLocked(part);
+        }
+    }
+
+    void PipelineLibrary::releasePartLocked(VkPipeline part) {
+        if (part == VK_NULL_HANDLE) {
+            return;
+        }
+        auto keyIt = mPartKeys.find(part);
+        if (keyIt == mPartKeys.end()) {
+            return;
+        }
+        auto it = mParts.find(keyIt->second);
+        if (it == mParts.end() || --it->second.refCount > 0) {
+            return;
+        }
+        // 已链接的管线不依赖部分的生命周期，没有引用的部分可以直接销毁
+        vkDestroyPipeline(mDevice, part, nullptr);
+        mParts.erase(it);
+        mPartKeys.erase(keyIt);
+    }
+
+    void PipelineLibrary::onPipelineReleased(VkPipeline pipeline) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mLinkedPipelines.find(pipeline);
+        if (it == mLinkedPipelines.end()) {
+            return;
+        }
+        if (--it->second.refCount > 0) {
+            return;
+        }
+        for (VkPipeline part : it->second.parts) {
+            releasePartLocked(part);
+        }
+        mLinkedPipelines.erase(it);
+    }
+
+    VkPipeline PipelineLibrary::link(const Parts& parts, VkPipelineLayout pipelineLayout,
+        bool optimize, uint64_t stateHash) {
+        VkPipelineLibraryCreateInfoKHR libraryInfo{};
+        libraryInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+        libraryInfo.libraryCount = static_cast<uint32_t>(parts.size());
+        libraryInfo.pLibraries = parts.data();
+
+        VkGraphicsPipelineCreateInfo linkInfo{};
+        linkInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        linkInfo.pNext = &libraryInfo;
+        linkInfo.flags = optimize ? VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : 0;
+        linkInfo.layout = pipelineLayout;
+        linkInfo.basePipelineIndex = -1;
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkResult result;
+        const std::string name = optimize ? "LibraryLinkOptimized" : "LibraryLinkFast";
+        auto pipelineCache = PipelineCache::find(mDevice);
+        if (stateHash != 0 && pipelineCache) {
+            result = pipelineCache->acquireGraphicsPipeline(stateHash, linkInfo, pipeline, name);
+        }
+        else {
+            result = PipelineFeedback::createGraphicsPipeline(mDevice,
+                pipelineCache ? pipelineCache->getHandle() : VK_NULL_HANDLE, linkInfo, pipeline, name, stateHash);
+        }
+        if (result != VK_SUCCESS) {
+            throw std::runtime_error(std::string("Failed to link pipeline library (") +
+                (optimize ? "optimized" : "fast") + "): VkResult = " + std::to_string(result));
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto& linked = mLinkedPipelines[pipeline];
+        if (linked.refCount++ == 0) {
+            linked.parts = parts;
+            for (VkPipeline part : parts) {
+                auto keyIt = mPartKeys.find(part);
+                if (keyIt != mPartKeys.end()) {
+                    mParts[keyIt->second].refCount++;
+                }
+            }
+        }
+        if (optimize) {
+            mOptimizedLinks++;
+        }
+        else {
+            mFastLinks++;
+        }
+        return pipeline;
+    }
+
+    PipelineLibrary::Stats PipelineLibrary::getStats() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Stats stats;
+        stats.partsCreated = mPartsCreated;
+        stats.partsReused = mPartsReused;
+        stats.fastLinks = mFastLinks;
+        stats.optimizedLinks = mOptimizedLinks;
+        stats.liveParts = mParts.size();
+        return stats;
+    }
+
+} // namespace StarryEngine
@@ -0,0 +1,101 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include "../vulkanCore/LogicalDevice.hpp"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace StarryEngine {
+
+    // 图形管线库（VK_EXT_graphics_pipeline_library）：管线拆成四个部分分别编译和缓存
+    // 新组合只需链接已有部分，快速链接几乎不编译，优化链接在后台完成
+    // 设备未启用该扩展时acquire返回nullptr，调用方退回整体创建
+    class PipelineLibrary {
+    public:
+        using Ptr = std::shared_ptr<PipelineLibrary>;
+
+        enum class Part : uint32_t {
+            VertexInput,       // 顶点输入、输入装配
+            PreRasterization,  // 非片段着色器阶段、视口、光栅化
+            FragmentShader,    // 片段着色器、深度模板
+            FragmentOutput,    // 颜色混合、多重采样
+            Count
+        };
+
+        static constexpr size_t PART_COUNT = static_cast<size_t>(Part::Count);
+        using Parts = std::array<VkPipeline, PART_COUNT>;
+
+        struct Stats {
+            uint64_t partsCreated = 0;    // 实际编译的部分数
+            uint64_t partsReused = 0;     // 命中已有部分的次数
+            uint64_t fastLinks = 0;
+            uint64_t optimizedLinks = 0;
+            size_t liveParts = 0;
+        };
+
+        // 获取设备对应的管线库（同一设备返回同一实例），设备未启用扩展时返回nullptr
+        static Ptr acquire(const LogicalDevice::Ptr& logicalDevice);
+
+        // 查找设备已有的管线库，不存在时返回nullptr
+        static Ptr find(VkDevice device);
+
+        PipelineLibrary(const LogicalDevice::Ptr& logicalDevice);
+        ~PipelineLibrary();
+
+        PipelineLibrary(const PipelineLibrary&) = delete;
+        PipelineLibrary& operator=(const PipelineLibrary&) = delete;
+
+        void cleanup();
+
+        // 按部分哈希获取或创建管线库部分并增加其引用，线程安全
+        // pipelineInfo为完整的整体创建信息，按部分取出相关状态和着色器阶段；失败时抛出异常
+        // 链接结束后须调用releaseParts释放这些引用
+        VkPipeline acquirePart(Part part, uint64_t partHash, const VkGraphicsPipelineCreateInfo& pipelineInfo);
+
+        // 释放acquirePart取得的引用（VK_NULL_HANDLE忽略），引用归零的部分立即销毁
+        void releaseParts(const Parts& parts);
+
+        // 把四个部分链接为可绑定的管线，失败时抛出异常
+        // optimize为false时快速链接（不做链接期优化），为true时生成与整体创建相当的管线
+        // stateHash非0且设备有PipelineCache时按状态哈希共享，返回的管线都通过PipelineBuilder::releasePipeline释放
+        // 链接出的管线在释放前持有各部分的引用
+        VkPipeline link(const Parts& parts, VkPipelineLayout pipelineLayout, bool optimize, uint64_t stateHash = 0);
+
+        // 链接出的管线被释放时调用（由PipelineBuilder::releasePipeline调用），不是链接结果时忽略
+        void onPipelineReleased(VkPipeline pipeline);
+
+        // 驱动保证快速链接不会重新编译
+        bool hasFastLinking() const { return mFastLinking; }
+
+        Stats getStats() const;
+
+    private:
+        LogicalDevice::Ptr mLogicalDevice;
+        VkDevice mDevice;
+        bool mFastLinking = false;
+
+        struct PartEntry {
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            uint32_t refCount = 0;  // 链接中的请求与存活的链接结果
+        };
+
+        struct LinkedPipeline {
+            Parts parts{};
+            uint32_t refCount = 0;  // 同一管线可能因按状态哈希共享被多次链接返回
+        };
+
+        // 减少部分的引用，归零时销毁（须持有mMutex）
+        void releasePartLocked(VkPipeline part);
+
+        mutable std::mutex mMutex;
+        std::unordered_map<uint64_t, PartEntry> mParts;  // 键为部分类型与部分哈希的组合
+        std::unordered_map<VkPipeline, uint64_t> mPartKeys;
+        std::unordered_map<VkPipeline, LinkedPipeline> mLinkedPipelines;
+        uint64_t mPartsCreated = 0;
+        uint64_t mPartsReused = 0;
+        uint64_t mFastLinks = 0;
+        uint64_t mOptimizedLinks = 0;
+    };
+
+} // namespace StarryEngine
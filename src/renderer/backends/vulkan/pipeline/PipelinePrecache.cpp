@@ -0,0 +1,389 @@
+#include "PipelinePrecache.hpp"
+#include "../renderPass/RenderPass.hpp"
+#include "../../../utils/Hash.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace StarryEngine {
+
+    namespace {
+        std::mutex sPrecacheMutex;
+        std::unordered_map<VkDevice, std::weak_ptr<PipelinePrecache>> sPrecaches;
+
+        constexpr const char* MANIFEST_HEADER = "# StarryEngine pipeline manifest 1";
+
+        std::vector<std::string> split(const std::string& text, char separator) {
+            std::vector<std::string> parts;
+            std::string part;
+            std::istringstream stream(text);
+            while (std::getline(stream, part, separator)) {
+                parts.push_back(part);
+            }
+            return parts;
+        }
+
+        // 着色器阶段组件当前各模块的SPIR-V内容哈希
+        std::vector<uint64_t> collectShaderHashes(const std::shared_ptr<IPipelineStateComponent>& component) {
+            std::vector<uint64_t> hashes;
+            if (auto shaderStage = std::dynamic_pointer_cast<ShaderStageComponent>(component)) {
+                if (auto program = shaderStage->getShaderProgram()) {
+                    for (const auto& module : program->getShaderModules()) {
+                        hashes.push_back(module->getHash());
+                    }
+                }
+            }
+            return hashes;
+        }
+    }
+
+    PipelinePrecache::Ptr PipelinePrecache::acquire(const LogicalDevice::Ptr& logicalDevice) {
+        std::lock_guard<std::mutex> lock(sPrecacheMutex);
+        auto& weak = sPrecaches[logicalDevice->getHandle()];
+        if (auto precache = weak.lock()) {
+            return precache;
+        }
+        auto precache = std::make_shared<PipelinePrecache>(logicalDevice);
+        weak = precache;
+        return precache;
+    }
+
+    PipelinePrecache::Ptr PipelinePrecache::find(VkDevice device) {
+        std::lock_guard<std::mutex> lock(sPrecacheMutex);
+        auto it = sPrecaches.find(device);
+        return it != sPrecaches.end() ? it->second.lock() : nullptr;
+    }
+
+    PipelinePrecache::PipelinePrecache(const LogicalDevice::Ptr& logicalDevice)
+        : mLogicalDevice(logicalDevice), mDevice(logicalDevice->getHandle()) {
+    }
+
+    PipelinePrecache::~PipelinePrecache() {
+        cleanup();
+    }
+
+    void PipelinePrecache::cleanup() {
+        std::vector<VkPipeline> prebuilt;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            prebuilt.swap(mPrebuilt);
+        }
+        for (VkPipeline pipeline : prebuilt) {
+            PipelineBuilder::releasePipeline(mDevice, pipeline);
+        }
+    }
+
+    void PipelinePrecache::registerPipelineLayout(const std::string& name, VkPipelineLayout pipelineLayout) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLayouts[name] = pipelineLayout;
+        mLayoutNames[pipelineLayout] = name;
+    }
+
+    void PipelinePrecache::registerRenderPass(VkRenderPass renderPass) {
+        const uint64_t hash = RenderPass::GetCompatibilityHash(renderPass);
+        if (hash == 0) {
+            std::cerr << "PipelinePrecache: render pass was not created through RenderPass, ignored" << std::endl;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRenderPasses[hash] = renderPass;
+    }
+
+    void PipelinePrecache::registerPreset(const std::string& name, const PipelineStatePreset& preset) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPresets.insert_or_assign(name, preset);
+        mPresetNames[preset.hash()] = name;
+    }
+
+    uint64_t PipelinePrecache::computeKey(const Entry& entry) {
+        auto selections = entry.selections;
+        std::sort(selections.begin(), selections.end(),
+            [](const ComponentSelection& a, const ComponentSelection& b) { return a.type < b.type; });
+
+        Hasher hasher;
+        for (const auto& selection : selections) {
+            hasher.add(selection.type).add(selection.name);
+        }
+        // 同名着色器组件的不同变体/内容对应不同条目
+        for (uint64_t shaderHash : entry.shaderHashes) {
+            hasher.add(shaderHash);
+        }
+        return hasher.add(entry.layoutName).add(entry.renderPassHash).add(entry.subpass).add(entry.presetName).get();
+    }
+
+    void PipelinePrecache::record(const ComponentRegistry& registry,
+        const std::vector<ComponentSelection>& selections,
+        const std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>>& components,
+        VkPipelineLayout pipelineLayout,
+        VkRenderPass renderPass,
+        uint32_t subpass,
+        const PipelineStatePreset* preset) {
+        Entry entry;
+        entry.renderPassHash = RenderPass::GetCompatibilityHash(renderPass);
+        entry.subpass = subpass;
+        if (entry.renderPassHash == 0) {
+            return;
+        }
+
+        // 空名称或不存在的名称会回退到默认组件，记录实际使用的名称
+        for (const auto& selection : selections) {
+            std::string name = selection.name;
+            if (name.empty() || !registry.hasComponent(selection.type, name)) {
+                name = registry.getDefaultComponentName(selection.type).value_or("");
+            }
+            entry.selections.emplace_back(selection.type, name);
+        }
+
+        auto shaderIt = components.find(PipelineComponentType::SHADER_STAGE);
+        if (shaderIt != components.end()) {
+            entry.shaderHashes = collectShaderHashes(shaderIt->second);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto layoutIt = mLayoutNames.find(pipelineLayout);
+        if (layoutIt == mLayoutNames.end()) {
+            return;
+        }
+        entry.layoutName = layoutIt->second;
+        if (preset) {
+            auto presetIt = mPresetNames.find(preset->hash());
+            if (presetIt == mPresetNames.end()) {
+                return;
+            }
+            entry.presetName = presetIt->second;
+        }
+        mEntries[computeKey(entry)] = std::move(entry);
+    }
+
+    size_t PipelinePrecache::prebuild(const std::shared_ptr<ComponentRegistry>& registry) {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<PipelineBuildRequest> requests;
+        // 预设条目不经过组件批量构建，在调用线程上逐个构建
+        std::vector<std::pair<PipelineBuildRequest, PipelineStatePreset>> presetRequests;
+        size_t stale = 0;
+        size_t unresolved = 0;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (auto it = mEntries.begin(); it != mEntries.end();) {
+                const Entry& entry = it->second;
+                const bool missingComponent = std::any_of(entry.selections.begin(), entry.selections.end(),
+                    [&registry](const ComponentSelection& selection) {
+                        return !registry->hasComponent(selection.type, selection.name);
+                    });
+                // 着色器内容已变化的条目按旧代码记录，预建出的管线不会再被使用
+                bool shaderChanged = false;
+                for (const auto& selection : entry.selections) {
+                    if (selection.type == PipelineComponentType::SHADER_STAGE) {
+                        shaderChanged = collectShaderHashes(registry->getComponent(selection.type, selection.name)) !=
+                            entry.shaderHashes;
+                    }
+                }
+                if (missingComponent || shaderChanged) {
+                    it = mEntries.erase(it);
+                    stale++;
+                    continue;
+                }
+
+                auto layoutIt = mLayouts.find(entry.layoutName);
+                auto renderPassIt = mRenderPasses.find(entry.renderPassHash);
+                auto presetIt = entry.presetName.empty() ? mPresets.end() : mPresets.find(entry.presetName);
+                if (layoutIt == mLayouts.end() || renderPassIt == mRenderPasses.end() ||
+                    (!entry.presetName.empty() && presetIt == mPresets.end())) {
+                    unresolved++;
+                }
+                else if (presetIt != mPresets.end()) {
+                    presetRequests.push_back({ { entry.selections, layoutIt->second, renderPassIt->second, entry.subpass },
+                        presetIt->second });
+                }
+                else {
+                    requests.push_back({ entry.selections, layoutIt->second, renderPassIt->second, entry.subpass });
+                }
+                ++it;
+            }
+        }
+
+        const size_t requestCount = requests.size() + presetRequests.size();
+        if (requestCount == 0) {
+            return 0;
+        }
+
+        // 条目在记录时已验证过，这里不再重复输出验证日志
+        PipelineBuilder builder(mDevice, registry);
+        auto pipelines = builder.buildGraphicsPipelines(requests, false);
+
+        for (const auto& [request, preset] : presetRequests) {
+            try {
+                PipelineBuilder presetBuilder(mDevice, registry);
+                pipelines.push_back(presetBuilder.addComponents(request.selections)
+                    .buildFromPreset(preset, request.pipelineLayout, request.renderPass, request.subpass));
+            }
+            catch (const std::exception& e) {
+                std::cerr << "PipelinePrecache: failed to prebuild preset pipeline: " << e.what() << std::endl;
+            }
+        }
+
+        size_t built = 0;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (VkPipeline pipeline : pipelines) {
+                if (pipeline != VK_NULL_HANDLE) {
+                    mPrebuilt.push_back(pipeline);
+                    built++;
+                }
+            }
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "PipelinePrecache: prebuilt " << built << "/" << requestCount << " pipelines in "
+            << elapsed << " ms (" << stale << " stale, " << unresolved << " unresolved)" << std::endl;
+        return built;
+    }
+
+    size_t PipelinePrecache::getEntryCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mEntries.size();
+    }
+
+    bool PipelinePrecache::load(const std::string& path) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mPath = path;
+        }
+
+        std::ifstream file(path);
+        if (!file) {
+            return false;
+        }
+
+        std::string line;
+        if (!std::getline(file, line) || line != MANIFEST_HEADER) {
+            std::cerr << "PipelinePrecache: unrecognized manifest " << path << std::endl;
+            return false;
+        }
+
+        // 每行：布局名 \t 渲染通道哈希 \t 子通道 \t 着色器哈希(,分隔) \t 类型=名称(|分隔) [\t 预设名]
+        std::unordered_map<uint64_t, Entry> entries;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            auto fields = split(line, '\t');
+            if (fields.size() != 5 && fields.size() != 6) {
+                continue;
+            }
+            try {
+                Entry entry;
+                entry.layoutName = fields[0];
+                entry.renderPassHash = std::stoull(fields[1], nullptr, 16);
+                entry.subpass = static_cast<uint32_t>(std::stoul(fields[2]));
+                for (const auto& hash : split(fields[3], ',')) {
+                    entry.shaderHashes.push_back(std::stoull(hash, nullptr, 16));
+                }
+                for (const auto& selection : split(fields[4], '|')) {
+                    auto separator = selection.find('=');
+                    if (separator == std::string::npos) {
+                        throw std::invalid_argument("selection");
+                    }
+                    auto type = static_cast<uint32_t>(std::stoul(selection.substr(0, separator)));
+                    if (type >= static_cast<uint32_t>(PipelineComponentType::COUNT)) {
+                        throw std::out_of_range("component type");
+                    }
+                    entry.selections.emplace_back(static_cast<PipelineComponentType>(type), selection.substr(separator + 1));
+                }
+                if (fields.size() == 6) {
+                    entry.presetName = fields[5];
+                }
+                entries[computeKey(entry)] = std::move(entry);
+            }
+            catch (const std::exception&) {
+                // 损坏的行直接跳过
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& [key, entry] : entries) {
+            mEntries.try_emplace(key, std::move(entry));
+        }
+        std::cout << "PipelinePrecache: loaded " << entries.size() << " entries from " << path << std::endl;
+        return true;
+    }
+
+    bool PipelinePrecache::save() const {
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            path = mPath;
+        }
+        if (path.empty()) {
+            return false;
+        }
+        return save(path);
+    }
+
+    bool PipelinePrecache::save(const std::string& path) const {
+        std::ostringstream out;
+        out << MANIFEST_HEADER << "\n";
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (const auto& [key, entry] : mEntries) {
+                out << entry.layoutName << '\t' << hashToHex(entry.renderPassHash) << '\t' << entry.subpass << '\t';
+                for (size_t i = 0; i < entry.shaderHashes.size(); ++i) {
+                    out << (i == 0 ? "" : ",") << hashToHex(entry.shaderHashes[i]);
+                }
+                out << '\t';
+                for (size_t i = 0; i < entry.selections.size(); ++i) {
+                    out << (i == 0 ? "" : "|") << static_cast<uint32_t>(entry.selections[i].type)
+                        << '=' << entry.selections[i].name;
+                }
+                if (!entry.presetName.empty()) {
+                    out << '\t' << entry.presetName;
+                }
+                out << "\n";
+            }
+        }
+        const std::string text = out.str();
+
+        const fs::path finalPath = path;
+        std::error_code ec;
+        if (finalPath.has_parent_path()) {
+            fs::create_directories(finalPath.parent_path(), ec);
+        }
+
+        // 先写临时文件再重命名
+        const uint64_t writerId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        fs::path tempPath = finalPath;
+        tempPath += "." + hashToHex(writerId) + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                std::cerr << "PipelinePrecache: failed to write " << tempPath.string() << std::endl;
+                return false;
+            }
+            file.write(text.data(), text.size());
+            file.flush();
+            if (!file) {
+                file.close();
+                fs::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        fs::rename(tempPath, finalPath, ec);
+        if (ec) {
+            std::cerr << "PipelinePrecache: failed to commit " << finalPath.string()
+                << ": " << ec.message() << std::endl;
+            fs::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace StarryEngine
@@ -0,0 +1,88 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include "../vulkanCore/LogicalDevice.hpp"
+#include "NewPipelineBuilder.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace StarryEngine {
+
+    // 管线预缓存清单：记录会话中实际创建过的管线键（组件选择、着色器哈希、布局名、渲染通道签名、状态预设名）
+    // 下次启动时在第一帧前并行预建这些管线，首次使用材质时直接命中共享管线
+    // 布局、渲染通道和预设每次启动须先按名称/兼容性哈希登记后才能记录和预建
+    class PipelinePrecache {
+    public:
+        using Ptr = std::shared_ptr<PipelinePrecache>;
+
+        struct Entry {
+            std::vector<ComponentSelection> selections;  // 已解析为实际组件名
+            std::vector<uint64_t> shaderHashes;          // 各阶段SPIR-V内容哈希（着色器变体键）
+            std::string layoutName;
+            uint64_t renderPassHash = 0;                 // RenderPass兼容性哈希
+            uint32_t subpass = 0;
+            std::string presetName;                      // 非空时按该预设经buildFromPreset构建
+        };
+
+        // 获取设备对应的清单（同一设备返回同一实例）
+        static Ptr acquire(const LogicalDevice::Ptr& logicalDevice);
+
+        // 查找设备已有的清单，不存在时返回nullptr
+        static Ptr find(VkDevice device);
+
+        PipelinePrecache(const LogicalDevice::Ptr& logicalDevice);
+        ~PipelinePrecache();
+
+        PipelinePrecache(const PipelinePrecache&) = delete;
+        PipelinePrecache& operator=(const PipelinePrecache&) = delete;
+
+        // 释放预建的管线
+        void cleanup();
+
+        // 登记本次会话的布局和渲染通道
+        void registerPipelineLayout(const std::string& name, VkPipelineLayout pipelineLayout);
+        void registerRenderPass(VkRenderPass renderPass);
+        // 登记本次会话的状态预设，按名称写入清单；未登记的预设构建的管线不记录
+        void registerPreset(const std::string& name, const PipelineStatePreset& preset);
+
+        // 读取清单并记录save()的目标路径；文件不存在或格式不符时返回false
+        bool load(const std::string& path);
+        bool save() const;
+        bool save(const std::string& path) const;
+
+        // 记录一次管线创建（PipelineBuilder调用），布局或渲染通道未登记时忽略
+        void record(const ComponentRegistry& registry,
+            const std::vector<ComponentSelection>& selections,
+            const std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>>& components,
+            VkPipelineLayout pipelineLayout,
+            VkRenderPass renderPass,
+            uint32_t subpass,
+            const PipelineStatePreset* preset = nullptr);
+
+        // 在共享工作池上并行预建清单中的管线，返回成功数量
+        // 预建的管线由本对象持有到cleanup()，期间相同状态的构建请求直接共享
+        // 组件已不存在或着色器哈希与当前模块不符的条目从清单中移除；布局或渲染通道未登记的条目保留到之后的会话
+        size_t prebuild(const std::shared_ptr<ComponentRegistry>& registry);
+
+        size_t getEntryCount() const;
+
+    private:
+        static uint64_t computeKey(const Entry& entry);
+
+        LogicalDevice::Ptr mLogicalDevice;
+        VkDevice mDevice;
+        std::string mPath;
+
+        mutable std::mutex mMutex;
+        std::unordered_map<uint64_t, Entry> mEntries;  // 键与布局/渲染通道句柄无关，跨会话稳定
+        std::unordered_map<std::string, VkPipelineLayout> mLayouts;
+        std::unordered_map<VkPipelineLayout, std::string> mLayoutNames;
+        std::unordered_map<uint64_t, VkRenderPass> mRenderPasses;
+        std::unordered_map<std::string, PipelineStatePreset> mPresets;
+        std::unordered_map<uint64_t, std::string> mPresetNames;  // 预设内容哈希 → 名称
+        std::vector<VkPipeline> mPrebuilt;
+    };
+
+} // namespace StarryEngine
@@ -0,0 +1,87 @@
+#include "PipelineStatePreset.hpp"
+
+namespace StarryEngine {
+
+    PresetPipelineCreateInfo::PresetPipelineCreateInfo(const PipelineStatePreset& preset) {
+        const auto& inputAssembly = preset.inputAssembly;
+        mInputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        mInputAssembly.topology = inputAssembly.topology;
+        mInputAssembly.primitiveRestartEnable = inputAssembly.primitiveRestartEnable;
+
+        // 动态视口/裁剪：只需声明数量
+        mViewport.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        mViewport.viewportCount = 1;
+        mViewport.scissorCount = 1;
+
+        const auto& rasterization = preset.rasterization;
+        mRasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        mRasterization.depthClampEnable = rasterization.depthClampEnable;
+        mRasterization.rasterizerDiscardEnable = rasterization.rasterizerDiscardEnable;
+        mRasterization.polygonMode = rasterization.polygonMode;
+        mRasterization.cullMode = rasterization.cullMode;
+        mRasterization.frontFace = rasterization.frontFace;
+        mRasterization.depthBiasEnable = rasterization.depthBiasEnable;
+        mRasterization.depthBiasConstantFactor = rasterization.depthBiasConstantFactor;
+        mRasterization.depthBiasClamp = rasterization.depthBiasClamp;
+        mRasterization.depthBiasSlopeFactor = rasterization.depthBiasSlopeFactor;
+        mRasterization.lineWidth = rasterization.lineWidth;
+
+        const auto& multiSample = preset.multiSample;
+        mMultiSample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        mMultiSample.rasterizationSamples = multiSample.rasterizationSamples;
+        mMultiSample.sampleShadingEnable = multiSample.sampleShadingEnable;
+        mMultiSample.minSampleShading = multiSample.minSampleShading;
+        mMultiSample.alphaToCoverageEnable = multiSample.alphaToCoverageEnable;
+        mMultiSample.alphaToOneEnable = multiSample.alphaToOneEnable;
+
+        const auto& depthStencil = preset.depthStencil;
+        mDepthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        mDepthStencil.depthTestEnable = depthStencil.depthTestEnable;
+        mDepthStencil.depthWriteEnable = depthStencil.depthWriteEnable;
+        mDepthStencil.depthCompareOp = depthStencil.depthCompareOp;
+        mDepthStencil.depthBoundsTestEnable = depthStencil.depthBoundsTestEnable;
+        mDepthStencil.stencilTestEnable = depthStencil.stencilTestEnable;
+        mDepthStencil.front = depthStencil.front;
+        mDepthStencil.back = depthStencil.back;
+        mDepthStencil.minDepthBounds = depthStencil.minDepthBounds;
+        mDepthStencil.maxDepthBounds = depthStencil.maxDepthBounds;
+
+        const auto& colorBlend = preset.colorBlend;
+        mAttachments = colorBlend.attachments;
+        mColorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        mColorBlend.logicOpEnable = colorBlend.logicOpEnable;
+        mColorBlend.logicOp = colorBlend.logicOp;
+        mColorBlend.attachmentCount = colorBlend.attachmentCount;
+        mColorBlend.pAttachments = colorBlend.attachmentCount > 0 ? mAttachments.data() : nullptr;
+        for (size_t i = 0; i < 4; ++i) {
+            mColorBlend.blendConstants[i] = colorBlend.blendConstants[i];
+        }
+
+        mDynamicStateList = preset.dynamicStates.states;
+        mDynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        mDynamicState.dynamicStateCount = preset.dynamicStates.count;
+        mDynamicState.pDynamicStates = preset.dynamicStates.count > 0 ? mDynamicStateList.data() : nullptr;
+
+        mCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        mCreateInfo.pInputAssemblyState = &mInputAssembly;
+        mCreateInfo.pViewportState = hasDynamicViewport() ? &mViewport : nullptr;
+        mCreateInfo.pRasterizationState = &mRasterization;
+        mCreateInfo.pMultisampleState = &mMultiSample;
+        mCreateInfo.pDepthStencilState = &mDepthStencil;
+        mCreateInfo.pColorBlendState = &mColorBlend;
+        mCreateInfo.pDynamicState = preset.dynamicStates.count > 0 ? &mDynamicState : nullptr;
+        mCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+        mCreateInfo.basePipelineIndex = -1;
+    }
+
+    bool PresetPipelineCreateInfo::hasDynamicViewport() const {
+        bool viewport = false;
+        bool scissor = false;
+        for (uint32_t i = 0; i < mDynamicState.dynamicStateCount; ++i) {
+            viewport = viewport || mDynamicStateList[i] == VK_DYNAMIC_STATE_VIEWPORT;
+            scissor = scissor || mDynamicStateList[i] == VK_DYNAMIC_STATE_SCISSOR;
+        }
+        return viewport && scissor;
+    }
+
+} // namespace StarryEngine
@@ -0,0 +1,240 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include "../../../utils/Hash.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace StarryEngine {
+
+    // 编译期管线状态描述：纯数据结构，哈希在编译期计算
+    // 与组件注册表并存：代码中声明的固定组合用预设，数据驱动的组合仍走字符串注册表
+    namespace PipelineState {
+
+        constexpr uint32_t MAX_COLOR_ATTACHMENTS = 8;
+        constexpr uint32_t MAX_DYNAMIC_STATES = 16;
+
+        namespace detail {
+            constexpr void addFloat(Hasher& hasher, float value) {
+                hasher.add(std::bit_cast<uint32_t>(value));
+            }
+
+            constexpr void addStencilOp(Hasher& hasher, const VkStencilOpState& state) {
+                hasher.add(state.failOp).add(state.passOp).add(state.depthFailOp).add(state.compareOp)
+                    .add(state.compareMask).add(state.writeMask).add(state.reference);
+            }
+        }
+
+        struct InputAssembly {
+            VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+            VkBool32 primitiveRestartEnable = VK_FALSE;
+
+            constexpr uint64_t hash() const {
+                return Hasher().add(topology).add(primitiveRestartEnable).get();
+            }
+        };
+
+        struct Rasterization {
+            VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+            VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+            VkFrontFace frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+            VkBool32 depthClampEnable = VK_FALSE;
+            VkBool32 rasterizerDiscardEnable = VK_FALSE;
+            VkBool32 depthBiasEnable = VK_FALSE;
+            float depthBiasConstantFactor = 0.0f;
+            float depthBiasClamp = 0.0f;
+            float depthBiasSlopeFactor = 0.0f;
+            float lineWidth = 1.0f;
+
+            constexpr uint64_t hash() const {
+                Hasher hasher;
+                hasher.add(polygonMode).add(cullMode).add(frontFace).add(depthClampEnable)
+                    .add(rasterizerDiscardEnable).add(depthBiasEnable);
+                detail::addFloat(hasher, depthBiasConstantFactor);
+                detail::addFloat(hasher, depthBiasClamp);
+                detail::addFloat(hasher, depthBiasSlopeFactor);
+                detail::addFloat(hasher, lineWidth);
+                return hasher.get();
+            }
+        };
+
+        struct MultiSample {
+            VkSampleCountFlagBits rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+            VkBool32 sampleShadingEnable = VK_FALSE;
+            float minSampleShading = 1.0f;
+            VkBool32 alphaToCoverageEnable = VK_FALSE;
+            VkBool32 alphaToOneEnable = VK_FALSE;
+
+            constexpr uint64_t hash() const {
+                Hasher hasher;
+                hasher.add(rasterizationSamples).add(sampleShadingEnable);
+                detail::addFloat(hasher, minSampleShading);
+                hasher.add(alphaToCoverageEnable).add(alphaToOneEnable);
+                return hasher.get();
+            }
+        };
+
+        struct DepthStencil {
+            VkBool32 depthTestEnable = VK_TRUE;
+            VkBool32 depthWriteEnable = VK_TRUE;
+            VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+            VkBool32 depthBoundsTestEnable = VK_FALSE;
+            VkBool32 stencilTestEnable = VK_FALSE;
+            VkStencilOpState front{};
+            VkStencilOpState back{};
+            float minDepthBounds = 0.0f;
+            float maxDepthBounds = 1.0f;
+
+            constexpr uint64_t hash() const {
+                Hasher hasher;
+                hasher.add(depthTestEnable).add(depthWriteEnable).add(depthCompareOp)
+                    .add(depthBoundsTestEnable).add(stencilTestEnable);
+                detail::addStencilOp(hasher, front);
+                detail::addStencilOp(hasher, back);
+                detail::addFloat(hasher, minDepthBounds);
+                detail::addFloat(hasher, maxDepthBounds);
+                return hasher.get();
+            }
+        };
+
+        struct ColorBlend {
+            VkBool32 logicOpEnable = VK_FALSE;
+            VkLogicOp logicOp = VK_LOGIC_OP_COPY;
+            uint32_t attachmentCount = 0;
+            std::array<VkPipelineColorBlendAttachmentState, MAX_COLOR_ATTACHMENTS> attachments{};
+            std::array<float, 4> blendConstants{};
+
+            constexpr uint64_t hash() const {
+                Hasher hasher;
+                hasher.add(logicOpEnable).add(logicOp).add(attachmentCount);
+                for (uint32_t i = 0; i < attachmentCount; ++i) {
+                    const auto& attachment = attachments[i];
+                    hasher.add(attachment.blendEnable)
+                        .add(attachment.srcColorBlendFactor).add(attachment.dstColorBlendFactor).add(attachment.colorBlendOp)
+                        .add(attachment.srcAlphaBlendFactor).add(attachment.dstAlphaBlendFactor).add(attachment.alphaBlendOp)
+                        .add(attachment.colorWriteMask);
+                }
+                for (float constant : blendConstants) {
+                    detail::addFloat(hasher, constant);
+                }
+                return hasher.get();
+            }
+        };
+
+        struct DynamicStates {
+            uint32_t count = 0;
+            std::array<VkDynamicState, MAX_DYNAMIC_STATES> states{};
+
+            constexpr bool contains(VkDynamicState state) const {
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (states[i] == state) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            constexpr uint64_t hash() const {
+                Hasher hasher;
+                hasher.add(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    hasher.add(states[i]);
+                }
+                return hasher.get();
+            }
+        };
+
+        // 常用附件状态
+        constexpr VkColorComponentFlags COLOR_WRITE_ALL = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+            VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+        constexpr VkPipelineColorBlendAttachmentState NO_BLENDING = {
+            VK_FALSE,
+            VK_BLEND_FACTOR_ONE, VK_BLEND_FACTOR_ZERO, VK_BLEND_OP_ADD,
+            VK_BLEND_FACTOR_ONE, VK_BLEND_FACTOR_ZERO, VK_BLEND_OP_ADD,
+            COLOR_WRITE_ALL
+        };
+
+        constexpr VkPipelineColorBlendAttachmentState ALPHA_BLENDING = {
+            VK_TRUE,
+            VK_BLEND_FACTOR_SRC_ALPHA, VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA, VK_BLEND_OP_ADD,
+            VK_BLEND_FACTOR_ONE, VK_BLEND_FACTOR_ZERO, VK_BLEND_OP_ADD,
+            COLOR_WRITE_ALL
+        };
+    }
+
+    // 固定功能状态的完整组合；着色器、顶点输入和视口在构建时由调用方提供
+    struct PipelineStatePreset {
+        PipelineState::InputAssembly inputAssembly{};
+        PipelineState::Rasterization rasterization{};
+        PipelineState::MultiSample multiSample{};
+        PipelineState::DepthStencil depthStencil{};
+        PipelineState::ColorBlend colorBlend{};
+        PipelineState::DynamicStates dynamicStates{};
+
+        constexpr uint64_t hash() const {
+            return Hasher().add(inputAssembly.hash()).add(rasterization.hash()).add(multiSample.hash())
+                .add(depthStencil.hash()).add(colorBlend.hash()).add(dynamicStates.hash()).get();
+        }
+    };
+
+    // 预设展开后的创建信息：所有状态结构按值保存在对象内，不分配堆内存
+    // createInfo中的指针指向本对象，因此不可复制或移动
+    class PresetPipelineCreateInfo {
+    public:
+        explicit PresetPipelineCreateInfo(const PipelineStatePreset& preset);
+
+        PresetPipelineCreateInfo(const PresetPipelineCreateInfo&) = delete;
+        PresetPipelineCreateInfo& operator=(const PresetPipelineCreateInfo&) = delete;
+
+        // 预设声明了动态视口/裁剪时可以不提供视口状态（此时使用一个动态视口）
+        bool hasDynamicViewport() const;
+
+        const VkGraphicsPipelineCreateInfo& get() const { return mCreateInfo; }
+        VkGraphicsPipelineCreateInfo& get() { return mCreateInfo; }
+
+    private:
+        VkPipelineInputAssemblyStateCreateInfo mInputAssembly{};
+        VkPipelineViewportStateCreateInfo mViewport{};
+        VkPipelineRasterizationStateCreateInfo mRasterization{};
+        VkPipelineMultisampleStateCreateInfo mMultiSample{};
+        VkPipelineDepthStencilStateCreateInfo mDepthStencil{};
+        std::array<VkPipelineColorBlendAttachmentState, PipelineState::MAX_COLOR_ATTACHMENTS> mAttachments{};
+        VkPipelineColorBlendStateCreateInfo mColorBlend{};
+        std::array<VkDynamicState, PipelineState::MAX_DYNAMIC_STATES> mDynamicStateList{};
+        VkPipelineDynamicStateCreateInfo mDynamicState{};
+        VkGraphicsPipelineCreateInfo mCreateInfo{};
+    };
+
+    // 代码中声明的预设，与getPresetSelections中的字符串预设对应
+    namespace PipelinePresets {
+
+        inline constexpr PipelineStatePreset Opaque = [] {
+            PipelineStatePreset preset;
+            preset.colorBlend.attachmentCount = 1;
+            preset.colorBlend.attachments[0] = PipelineState::NO_BLENDING;
+            preset.dynamicStates.count = 2;
+            preset.dynamicStates.states = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+            return preset;
+        }();
+
+        inline constexpr PipelineStatePreset Transparent = [] {
+            PipelineStatePreset preset = Opaque;
+            preset.depthStencil.depthWriteEnable = VK_FALSE;
+            preset.colorBlend.attachments[0] = PipelineState::ALPHA_BLENDING;
+            return preset;
+        }();
+
+        inline constexpr PipelineStatePreset Wireframe = [] {
+            PipelineStatePreset preset = Opaque;
+            preset.rasterization.polygonMode = VK_POLYGON_MODE_LINE;
+            preset.rasterization.cullMode = VK_CULL_MODE_NONE;
+            return preset;
+        }();
+
+        // 哈希在编译期确定，可作为管线共享的键
+        static_assert(Opaque.hash() != Transparent.hash() && Opaque.hash() != Wireframe.hash(),
+            "Pipeline presets must hash differently");
+    }
+
+} // namespace StarryEngine
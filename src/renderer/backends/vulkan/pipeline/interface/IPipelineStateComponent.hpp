@@ -2,6 +2,8 @@
 #include<vulkan/vulkan.h>
 #include <string>
 #include <memory>
+#include <vector>
+#include <algorithm>
 namespace StarryEngine {
 	enum class PipelineComponentType :uint32_t {
 		SHADER_STAGE=0,
@@ -71,6 +73,10 @@ namespace StarryEngine {
 		}
 	}
 
+	inline bool containsDynamicState(const std::vector<VkDynamicState>& dynamicStates, VkDynamicState state) {
+		return std::find(dynamicStates.begin(), dynamicStates.end(), state) != dynamicStates.end();
+	}
+
 	class IPipelineStateComponent {
 	public:
 		virtual PipelineComponentType getType() const = 0;
@@ -79,6 +85,10 @@ namespace StarryEngine {
 		virtual std::shared_ptr<IPipelineStateComponent> clone() const = 0;
 		virtual void apply(VkGraphicsPipelineCreateInfo& pipelineInfo) = 0;
 		virtual bool isValid() const = 0;
+		// 有效状态的内容哈希（不含组件名称），内容相同的组件哈希相同，用于管线去重
+		virtual uint64_t getHash() const = 0;
+		// 排除dynamicStates覆盖的字段后的哈希：这些字段在绘制时设置，不再区分管线
+		virtual uint64_t getStaticHash([[maybe_unused]] const std::vector<VkDynamicState>& dynamicStates) const { return getHash(); }
 		virtual ~IPipelineStateComponent() = default;
 	};
 }
\ No newline at end of file
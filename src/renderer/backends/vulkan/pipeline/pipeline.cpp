@@ -1,4 +1,7 @@
 #include"pipeline.hpp"
+#include"PipelineCache.hpp"
+#include"PipelineFeedback.hpp"
+#include"LayoutCache.hpp"
 
 namespace StarryEngine {
 
@@ -49,7 +52,7 @@ namespace StarryEngine {
         setDynamicStates(dynamic);
 
         const std::vector<VkDescriptorSetLayout> descriptorSetLayout;
-        auto pipelineLayout = PipelineLayout::create(mLogicalDevice, descriptorSetLayout);
+        auto pipelineLayout = LayoutCache::acquire(mLogicalDevice)->getPipelineLayout(descriptorSetLayout);
         setPipelineLayout(pipelineLayout);
 
         setSubPass(0);
@@ -134,7 +137,8 @@ namespace StarryEngine {
         createInfo.basePipelineIndex = mBasePipelineIndex;
         createInfo.pDepthStencilState = &mPipelineStageConfig.depthStencilState.getCreateInfo();
 
-        if (vkCreateGraphicsPipelines(mLogicalDevice->getHandle(), VK_NULL_HANDLE, 1, &createInfo, nullptr, &mGraphicsPipeline) != VK_SUCCESS) {
+        if (PipelineFeedback::createGraphicsPipeline(mLogicalDevice->getHandle(), PipelineCache::getHandle(mLogicalDevice->getHandle()),
+            createInfo, mGraphicsPipeline, "Pipeline[subpass " + std::to_string(mSubpass) + "]") != VK_SUCCESS) {
             throw std::runtime_error("Failed to create graphics pipeline");
         }
     }
@@ -15,14 +15,19 @@ namespace StarryEngine {
 	class PipelineLayout {
 	public:
 		using Ptr = std::shared_ptr<PipelineLayout>;
-		static Ptr create(const LogicalDevice::Ptr& logicalDevice, std::vector<VkDescriptorSetLayout> descriptorSetLayout) {
-			return std::make_shared<PipelineLayout>(logicalDevice, descriptorSetLayout);
+		static Ptr create(const LogicalDevice::Ptr& logicalDevice, std::vector<VkDescriptorSetLayout> descriptorSetLayout,
+			std::vector<VkPushConstantRange> pushConstantRanges = {}) {
+			return std::make_shared<PipelineLayout>(logicalDevice, descriptorSetLayout, pushConstantRanges);
 		}
-		PipelineLayout(const LogicalDevice::Ptr& logicalDevice, std::vector<VkDescriptorSetLayout> descriptorSetLayout) :mLogicalDevice(logicalDevice) {
+		PipelineLayout(const LogicalDevice::Ptr& logicalDevice, std::vector<VkDescriptorSetLayout> descriptorSetLayout,
+			std::vector<VkPushConstantRange> pushConstantRanges = {})
+			:mLogicalDevice(logicalDevice), mDescriptorSetLayouts(descriptorSetLayout), mPushConstantRanges(pushConstantRanges) {
 			VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
 			pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 			pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayout.size());
 			pipelineLayoutInfo.pSetLayouts = descriptorSetLayout.data();
+			pipelineLayoutInfo.pushConstantRangeCount = static_cast<uint32_t>(mPushConstantRanges.size());
+			pipelineLayoutInfo.pPushConstantRanges = mPushConstantRanges.empty() ? nullptr : mPushConstantRanges.data();
 			if (vkCreatePipelineLayout(mLogicalDevice->getHandle(), &pipelineLayoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS) {
 				throw std::runtime_error("Failed to create pipeline layout!");
 			}
@@ -37,9 +42,15 @@ namespace StarryEngine {
 
 		VkPipelineLayout getHandle() { return mPipelineLayout; }
 
+		// 创建时的描述符集布局（着色器对象须使用与布局一致的集合布局）
+		const std::vector<VkDescriptorSetLayout>& getDescriptorSetLayouts() const { return mDescriptorSetLayouts; }
+		const std::vector<VkPushConstantRange>& getPushConstantRanges() const { return mPushConstantRanges; }
+
 	private:
 		LogicalDevice::Ptr mLogicalDevice;
 		VkPipelineLayout mPipelineLayout = VK_NULL_HANDLE;
+		std::vector<VkDescriptorSetLayout> mDescriptorSetLayouts;
+		std::vector<VkPushConstantRange> mPushConstantRanges;
 	};
 
 
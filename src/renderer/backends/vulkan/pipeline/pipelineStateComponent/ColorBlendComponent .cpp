@@ -1,4 +1,5 @@
 #include "ColorBlendComponent.hpp"
+#include "../../../../utils/Hash.hpp"
 #include<iostream>
 namespace StarryEngine {
 
@@ -436,4 +437,42 @@ namespace StarryEngine {
         }
     }
 
+    uint64_t ColorBlendComponent::getHash() const {
+        Hasher hasher;
+        hasher.add(mCreateInfo.logicOpEnable).add(mCreateInfo.logicOp);
+        for (float constant : mCreateInfo.blendConstants) {
+            hasher.add(constant);
+        }
+        hasher.add(mAttachmentStates);
+        return hasher.get();
+    }
+
+    uint64_t ColorBlendComponent::getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const {
+        const bool dynamicEnable = containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT);
+        const bool dynamicEquation = containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT);
+
+        Hasher hasher;
+        hasher.add(mCreateInfo.logicOpEnable).add(mCreateInfo.logicOp);
+        if (!containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_BLEND_CONSTANTS)) {
+            for (float constant : mCreateInfo.blendConstants) {
+                hasher.add(constant);
+            }
+        }
+
+        // 附件数量和写掩码始终属于管线
+        hasher.add(static_cast<uint64_t>(mAttachmentStates.size()));
+        for (const auto& attachment : mAttachmentStates) {
+            hasher.add(attachment.colorWriteMask);
+            if (!dynamicEnable) {
+                hasher.add(attachment.blendEnable);
+            }
+            if (!dynamicEquation) {
+                hasher.add(attachment.srcColorBlendFactor).add(attachment.dstColorBlendFactor)
+                    .add(attachment.colorBlendOp).add(attachment.srcAlphaBlendFactor)
+                    .add(attachment.dstAlphaBlendFactor).add(attachment.alphaBlendOp);
+            }
+        }
+        return hasher.get();
+    }
+
 } // namespace StarryEngine
\ No newline at end of file
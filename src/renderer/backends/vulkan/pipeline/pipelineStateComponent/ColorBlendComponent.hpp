@@ -55,6 +55,8 @@ namespace StarryEngine {
 
         std::string getDescription() const override;
         bool isValid() const override;
+        uint64_t getHash() const override;
+        uint64_t getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const override;
 
         // 获取颜色混合信息
         const std::vector<VkPipelineColorBlendAttachmentState>& getAttachmentStates() const { return mAttachmentStates; }
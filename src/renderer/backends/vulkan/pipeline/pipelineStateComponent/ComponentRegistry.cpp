@@ -2,43 +2,76 @@
 
 namespace StarryEngine {
 
-    void ComponentRegistry::registerComponent(const std::string& name,
+    ComponentId ComponentRegistry::registerComponent(const std::string& name,
         std::shared_ptr<IPipelineStateComponent> component) {
         PipelineComponentType type = component->getType();
-        mComponents[type][name] = component;
-        mComponentNames[type].insert(name);
+        const size_t typeIndex = static_cast<size_t>(type);
+        auto& slots = mSlots[typeIndex];
+
+        uint32_t index;
+        auto nameIt = mNameToIndex[typeIndex].find(name);
+        if (nameIt != mNameToIndex[typeIndex].end()) {
+            // 同名替换：沿用槽位，代数增加使旧句柄失效
+            index = nameIt->second;
+            slots[index].generation++;
+        }
+        else if (!mFreeSlots[typeIndex].empty()) {
+            index = mFreeSlots[typeIndex].back();
+            mFreeSlots[typeIndex].pop_back();
+        }
+        else {
+            index = static_cast<uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+
+        Slot& slot = slots[index];
+        slot.raw = component.get();
+        slot.component = std::move(component);
+        slot.name = name;
+        mNameToIndex[typeIndex][name] = index;
+        return { type, index, slot.generation };
+    }
+
+    ComponentId ComponentRegistry::findComponentId(PipelineComponentType type, const std::string& name) const {
+        if (type >= PipelineComponentType::COUNT) {
+            return {};
+        }
+        const size_t typeIndex = static_cast<size_t>(type);
+        auto it = mNameToIndex[typeIndex].find(name);
+        if (it == mNameToIndex[typeIndex].end()) {
+            return {};
+        }
+        return { type, it->second, mSlots[typeIndex][it->second].generation };
     }
 
     std::shared_ptr<IPipelineStateComponent> ComponentRegistry::getComponent(
         PipelineComponentType type,
         const std::string& name) const {
 
-        auto typeIt = mComponents.find(type);
-        if (typeIt == mComponents.end()) {
-            return nullptr;
-        }
-
-        auto compIt = typeIt->second.find(name);
-        if (compIt == typeIt->second.end()) {
+        ComponentId id = findComponentId(type, name);
+        if (!id.isValid()) {
             return nullptr;
         }
-
-        return compIt->second;
+        return mSlots[static_cast<size_t>(type)][id.index].component;
     }
 
     std::vector<std::string> ComponentRegistry::getComponentNames(PipelineComponentType type) const {
         std::vector<std::string> names;
-        auto it = mComponentNames.find(type);
-        if (it != mComponentNames.end()) {
-            names.assign(it->second.begin(), it->second.end());
+        if (type >= PipelineComponentType::COUNT) {
+            return names;
+        }
+        for (const auto& [name, _] : mNameToIndex[static_cast<size_t>(type)]) {
+            names.push_back(name);
         }
         return names;
     }
 
     std::vector<PipelineComponentType> ComponentRegistry::getRegisteredTypes() const {
         std::vector<PipelineComponentType> types;
-        for (const auto& [type, _] : mComponents) {
-            types.push_back(type);
+        for (size_t i = 0; i < TYPE_COUNT; ++i) {
+            if (!mNameToIndex[i].empty()) {
+                types.push_back(static_cast<PipelineComponentType>(i));
+            }
         }
         return types;
     }
@@ -68,28 +101,20 @@ namespace StarryEngine {
     }
 
     bool ComponentRegistry::hasComponent(PipelineComponentType type, const std::string& name) const {
-        auto typeIt = mComponents.find(type);
-        if (typeIt == mComponents.end()) {
-            return false;
-        }
-        return typeIt->second.find(name) != typeIt->second.end();
+        return findComponentId(type, name).isValid();
     }
 
     void ComponentRegistry::removeComponent(PipelineComponentType type, const std::string& name) {
-        auto typeIt = mComponents.find(type);
-        if (typeIt != mComponents.end()) {
-            typeIt->second.erase(name);
-            if (typeIt->second.empty()) {
-                mComponents.erase(typeIt);
-            }
-        }
-
-        auto nameIt = mComponentNames.find(type);
-        if (nameIt != mComponentNames.end()) {
-            nameIt->second.erase(name);
-            if (nameIt->second.empty()) {
-                mComponentNames.erase(nameIt);
-            }
+        ComponentId id = findComponentId(type, name);
+        if (id.isValid()) {
+            const size_t typeIndex = static_cast<size_t>(type);
+            Slot& slot = mSlots[typeIndex][id.index];
+            slot.component.reset();
+            slot.raw = nullptr;
+            slot.name.clear();
+            slot.generation++;
+            mFreeSlots[typeIndex].push_back(id.index);
+            mNameToIndex[typeIndex].erase(name);
         }
 
         // 如果移除的组件是默认组件，则清除默认设置
@@ -100,22 +125,32 @@ namespace StarryEngine {
     }
 
     void ComponentRegistry::clear() {
-        mComponents.clear();
-        mComponentNames.clear();
+        // 保留槽位并增加代数，清空前发出的句柄不会误指向之后注册的组件
+        for (size_t i = 0; i < TYPE_COUNT; ++i) {
+            mFreeSlots[i].clear();
+            for (uint32_t index = 0; index < mSlots[i].size(); ++index) {
+                Slot& slot = mSlots[i][index];
+                slot.component.reset();
+                slot.raw = nullptr;
+                slot.name.clear();
+                slot.generation++;
+                mFreeSlots[i].push_back(index);
+            }
+            mNameToIndex[i].clear();
+        }
         mDefaultComponents.clear();
     }
 
     size_t ComponentRegistry::getComponentCount() const {
         size_t count = 0;
-        for (const auto& [_, components] : mComponents) {
-            count += components.size();
+        for (const auto& names : mNameToIndex) {
+            count += names.size();
         }
         return count;
     }
 
     size_t ComponentRegistry::getComponentCount(PipelineComponentType type) const {
-        auto it = mComponents.find(type);
-        return (it != mComponents.end()) ? it->second.size() : 0;
+        return type < PipelineComponentType::COUNT ? mNameToIndex[static_cast<size_t>(type)].size() : 0;
     }
 
-} // namespace StarryEngine
\ No newline at end of file
+} // namespace StarryEngine
@@ -1,5 +1,7 @@
 #pragma once
 #include "../interface/TypedPipelineComponent.hpp"
+#include <array>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -10,12 +12,74 @@
 
 namespace StarryEngine {
 
+    // 注册表中组件槽位的标识：类型 + 槽位下标 + 代数
+    // 组件被移除或同名替换后代数增加，旧标识随之失效
+    struct ComponentId {
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        PipelineComponentType type = PipelineComponentType::COUNT;
+        uint32_t index = INVALID_INDEX;
+        uint32_t generation = 0;
+
+        bool isValid() const { return index != INVALID_INDEX; }
+        bool operator==(const ComponentId& other) const {
+            return type == other.type && index == other.index && generation == other.generation;
+        }
+    };
+
+    // 带组件类型的句柄，用于每帧访问（不做字符串哈希、不复制shared_ptr）
+    template<typename Component>
+    struct ComponentHandle {
+        ComponentId id;
+
+        bool isValid() const { return id.isValid(); }
+        bool operator==(const ComponentHandle& other) const { return id == other.id; }
+    };
+
     class ComponentRegistry {
     public:
-        // 注册组件（使用字符串名称）
-        void registerComponent(const std::string& name,
+        // 注册组件（使用字符串名称），返回槽位标识；同名组件被替换时旧标识失效
+        ComponentId registerComponent(const std::string& name,
             std::shared_ptr<IPipelineStateComponent> component);
 
+        // 注册具体类型的组件，返回带类型的句柄
+        template<typename Component>
+        ComponentHandle<Component> registerComponent(const std::string& name,
+            std::shared_ptr<Component> component) {
+            return { registerComponent(name, std::static_pointer_cast<IPipelineStateComponent>(component)) };
+        }
+
+        // 按句柄访问组件：只做下标和代数检查，句柄失效时返回nullptr
+        // 返回的指针在组件被移除或替换前有效
+        IPipelineStateComponent* get(const ComponentId& id) const {
+            if (!id.isValid() || id.type >= PipelineComponentType::COUNT) {
+                return nullptr;
+            }
+            const auto& slots = mSlots[static_cast<size_t>(id.type)];
+            if (id.index >= slots.size() || slots[id.index].generation != id.generation) {
+                return nullptr;
+            }
+            return slots[id.index].raw;
+        }
+
+        template<typename Component>
+        Component* get(const ComponentHandle<Component>& handle) const {
+            // 每种组件类型只对应一个组件类，注册时已按类型分槽
+            return static_cast<Component*>(get(handle.id));
+        }
+
+        // 按名称查找标识（供工具和初始化使用），不存在时返回无效标识
+        ComponentId findComponentId(PipelineComponentType type, const std::string& name) const;
+
+        template<typename Component>
+        ComponentHandle<Component> findHandle(const std::string& name) const {
+            ComponentId id = findComponentId(Component::ComponentType, name);
+            if (id.isValid() && dynamic_cast<Component*>(get(id)) == nullptr) {
+                return {};
+            }
+            return { id };
+        }
+
         // 获取组件（通过类型和名称）
         std::shared_ptr<IPipelineStateComponent> getComponent(
             PipelineComponentType type,
@@ -52,15 +116,28 @@ namespace StarryEngine {
         // 获取指定类型的组件数量
         size_t getComponentCount(PipelineComponentType type) const;
 
+        // 只读快照：复制名称到组件的映射（组件实例共享），供工作线程并发查询
+        // 快照之后对注册表的注册/移除不影响快照
+        std::shared_ptr<const ComponentRegistry> snapshot() const {
+            return std::make_shared<const ComponentRegistry>(*this);
+        }
+
     private:
-        // 按类型组织的组件映射
-        std::unordered_map<
-            PipelineComponentType,
-            std::unordered_map<std::string, std::shared_ptr<IPipelineStateComponent>>
-        > mComponents;
-
-        // 组件名称集合（便于快速查找）
-        std::unordered_map<PipelineComponentType, std::unordered_set<std::string>> mComponentNames;
+        static constexpr size_t TYPE_COUNT = static_cast<size_t>(PipelineComponentType::COUNT);
+
+        struct Slot {
+            std::shared_ptr<IPipelineStateComponent> component;  // 为空表示空闲槽位
+            IPipelineStateComponent* raw = nullptr;
+            uint32_t generation = 0;
+            std::string name;
+        };
+
+        // 按类型组织的稠密槽位数组，下标即句柄中的index
+        std::array<std::vector<Slot>, TYPE_COUNT> mSlots;
+        std::array<std::vector<uint32_t>, TYPE_COUNT> mFreeSlots;
+
+        // 名称到槽位下标（只在注册和按名称查询时使用）
+        std::array<std::unordered_map<std::string, uint32_t>, TYPE_COUNT> mNameToIndex;
 
         // 默认组件映射
         std::unordered_map<PipelineComponentType, std::string> mDefaultComponents;
@@ -1,4 +1,5 @@
 #include "DepthStencilComponent.hpp"
+#include "../../../../utils/Hash.hpp"
 
 namespace StarryEngine {
 
@@ -335,4 +336,47 @@ namespace StarryEngine {
         }
     }
 
+    uint64_t DepthStencilComponent::getHash() const {
+        return hashState(mCreateInfo);
+    }
+
+    uint64_t DepthStencilComponent::getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const {
+        // 动态字段置为固定值后再计算
+        VkPipelineDepthStencilStateCreateInfo info = mCreateInfo;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE)) info.depthTestEnable = VK_FALSE;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE)) info.depthWriteEnable = VK_FALSE;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_DEPTH_COMPARE_OP)) info.depthCompareOp = VK_COMPARE_OP_NEVER;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE)) info.depthBoundsTestEnable = VK_FALSE;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE)) info.stencilTestEnable = VK_FALSE;
+        for (VkStencilOpState* face : { &info.front, &info.back }) {
+            if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_STENCIL_OP)) {
+                face->failOp = face->passOp = face->depthFailOp = VK_STENCIL_OP_KEEP;
+                face->compareOp = VK_COMPARE_OP_NEVER;
+            }
+            if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK)) face->compareMask = 0;
+            if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_STENCIL_WRITE_MASK)) face->writeMask = 0;
+            if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_STENCIL_REFERENCE)) face->reference = 0;
+        }
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_DEPTH_BOUNDS)) {
+            info.minDepthBounds = 0.0f;
+            info.maxDepthBounds = 1.0f;
+        }
+        return hashState(info);
+    }
+
+    uint64_t DepthStencilComponent::hashState(const VkPipelineDepthStencilStateCreateInfo& info) {
+        Hasher hasher;
+        hasher.add(info.flags)
+            .add(info.depthTestEnable)
+            .add(info.depthWriteEnable)
+            .add(info.depthCompareOp)
+            .add(info.depthBoundsTestEnable)
+            .add(info.stencilTestEnable)
+            .addBytes(&info.front, sizeof(VkStencilOpState))
+            .addBytes(&info.back, sizeof(VkStencilOpState))
+            .add(info.minDepthBounds)
+            .add(info.maxDepthBounds);
+        return hasher.get();
+    }
+
 } // namespace StarryEngine
\ No newline at end of file
@@ -70,6 +70,8 @@ namespace StarryEngine {
 
         std::string getDescription() const override;
         bool isValid() const override;
+        uint64_t getHash() const override;
+        uint64_t getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const override;
 
         // 获取当前深度测试状态
         VkBool32 getDepthTestEnable() const { return mCreateInfo.depthTestEnable; }
@@ -77,6 +79,7 @@ namespace StarryEngine {
         VkCompareOp getDepthCompareOp() const { return mCreateInfo.depthCompareOp; }
 
         // 获取当前模板测试状态
+        VkBool32 getDepthBoundsTestEnable() const { return mCreateInfo.depthBoundsTestEnable; }
         VkBool32 getStencilTestEnable() const { return mCreateInfo.stencilTestEnable; }
         const VkStencilOpState& getFrontStencilOpState() const { return mCreateInfo.front; }
         const VkStencilOpState& getBackStencilOpState() const { return mCreateInfo.back; }
@@ -85,6 +88,7 @@ namespace StarryEngine {
         VkPipelineDepthStencilStateCreateInfo mCreateInfo{};
 
         void updateCreateInfo();
+        static uint64_t hashState(const VkPipelineDepthStencilStateCreateInfo& info);
 
         // 辅助函数，用于检查深度边界是否有效
         bool areDepthBoundsValid() const;
@@ -1,4 +1,5 @@
 #include "DynamicStateComponent.hpp"
+#include "../../../../utils/Hash.hpp"
 #include <algorithm>
 
 namespace StarryEngine {
@@ -101,6 +102,38 @@ namespace StarryEngine {
         return *this;
     }
 
+    DynamicStateComponent& DynamicStateComponent::addExtendedDynamicStates(const LogicalDevice& device) {
+        static const VkDynamicState extendedStates[] = {
+            VK_DYNAMIC_STATE_CULL_MODE,
+            VK_DYNAMIC_STATE_FRONT_FACE,
+            VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY,
+            VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE,
+            VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE,
+            VK_DYNAMIC_STATE_DEPTH_COMPARE_OP,
+            VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE,
+            VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE,
+            VK_DYNAMIC_STATE_STENCIL_OP,
+            VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE,
+            VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE,
+            VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE,
+            VK_DYNAMIC_STATE_POLYGON_MODE_EXT,
+            VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT,
+            VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT,
+            VK_DYNAMIC_STATE_VERTEX_INPUT_EXT
+        };
+        for (VkDynamicState state : extendedStates) {
+            if (device.supportsDynamicState(state)) {
+                addDynamicState(state);
+            }
+        }
+
+        // 动态顶点输入与动态步长互斥
+        if (hasDynamicState(VK_DYNAMIC_STATE_VERTEX_INPUT_EXT)) {
+            removeDynamicState(VK_DYNAMIC_STATE_VERTEX_INPUT_BINDING_STRIDE);
+        }
+        return *this;
+    }
+
     std::string DynamicStateComponent::getDescription() const {
         if (mDynamicStates.empty()) {
             return "Dynamic States: NONE";
@@ -124,6 +157,22 @@ namespace StarryEngine {
 #ifdef VK_EXT_extended_dynamic_state
             case VK_DYNAMIC_STATE_VERTEX_INPUT_BINDING_STRIDE_EXT: desc += "VERTEX_INPUT_BINDING_STRIDE"; break;
 #endif
+            case VK_DYNAMIC_STATE_CULL_MODE: desc += "CULL_MODE"; break;
+            case VK_DYNAMIC_STATE_FRONT_FACE: desc += "FRONT_FACE"; break;
+            case VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY: desc += "PRIMITIVE_TOPOLOGY"; break;
+            case VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE: desc += "DEPTH_TEST_ENABLE"; break;
+            case VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE: desc += "DEPTH_WRITE_ENABLE"; break;
+            case VK_DYNAMIC_STATE_DEPTH_COMPARE_OP: desc += "DEPTH_COMPARE_OP"; break;
+            case VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE: desc += "DEPTH_BOUNDS_TEST_ENABLE"; break;
+            case VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE: desc += "STENCIL_TEST_ENABLE"; break;
+            case VK_DYNAMIC_STATE_STENCIL_OP: desc += "STENCIL_OP"; break;
+            case VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE: desc += "PRIMITIVE_RESTART_ENABLE"; break;
+            case VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE: desc += "DEPTH_BIAS_ENABLE"; break;
+            case VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE: desc += "RASTERIZER_DISCARD_ENABLE"; break;
+            case VK_DYNAMIC_STATE_POLYGON_MODE_EXT: desc += "POLYGON_MODE"; break;
+            case VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT: desc += "COLOR_BLEND_ENABLE"; break;
+            case VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT: desc += "COLOR_BLEND_EQUATION"; break;
+            case VK_DYNAMIC_STATE_VERTEX_INPUT_EXT: desc += "VERTEX_INPUT"; break;
             default: desc += "UNKNOWN(" + std::to_string(mDynamicStates[i]) + ")"; break;
             }
         }
@@ -173,6 +222,24 @@ namespace StarryEngine {
             case VK_DYNAMIC_STATE_STENCIL_REFERENCE:
                 // 有效的标准动态状态
                 break;
+            case VK_DYNAMIC_STATE_CULL_MODE:
+            case VK_DYNAMIC_STATE_FRONT_FACE:
+            case VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY:
+            case VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE:
+            case VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE:
+            case VK_DYNAMIC_STATE_DEPTH_COMPARE_OP:
+            case VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE:
+            case VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE:
+            case VK_DYNAMIC_STATE_STENCIL_OP:
+            case VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE:
+            case VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE:
+            case VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE:
+            case VK_DYNAMIC_STATE_POLYGON_MODE_EXT:
+            case VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT:
+            case VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT:
+            case VK_DYNAMIC_STATE_VERTEX_INPUT_EXT:
+                // 扩展动态状态（设备是否支持由LogicalDevice::supportsDynamicState判断）
+                break;
             default:
 #ifdef VK_EXT_extended_dynamic_state
                 if (state == VK_DYNAMIC_STATE_VERTEX_INPUT_BINDING_STRIDE_EXT) {
@@ -196,4 +263,8 @@ namespace StarryEngine {
         mCreateInfo.pDynamicStates = mDynamicStates.empty() ? nullptr : mDynamicStates.data();
     }
 
+    uint64_t DynamicStateComponent::getHash() const {
+        return Hasher().add(mDynamicStates).get();
+    }
+
 } // namespace StarryEngine
\ No newline at end of file
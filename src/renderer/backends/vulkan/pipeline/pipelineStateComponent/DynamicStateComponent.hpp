@@ -1,5 +1,6 @@
 #pragma once
 #include "../interface/TypedPipelineComponent.hpp"
+#include "../../vulkanCore/LogicalDevice.hpp"
 #include <vulkan/vulkan.h>
 #include <vector>
 #include <memory>
@@ -35,6 +36,11 @@ namespace StarryEngine {
         DynamicStateComponent& addColorBlendStates();         // 颜色混合
         DynamicStateComponent& addVertexInputState();         // 顶点输入（需要扩展）
 
+        // 扩展动态状态（只添加设备支持的）：剔除、正面、拓扑、图元重启、深度/模板开关与比较、
+        // 深度偏移开关、光栅化丢弃、多边形模式、混合开关与方程，以及动态顶点输入
+        // 这些字段不再参与管线去重哈希，绘制前须通过RenderContext::applyDynamicState设置
+        DynamicStateComponent& addExtendedDynamicStates(const LogicalDevice& device);
+
         void apply(VkGraphicsPipelineCreateInfo& pipelineInfo) override {
             updateCreateInfo();
             pipelineInfo.pDynamicState = &mCreateInfo;
@@ -42,6 +48,7 @@ namespace StarryEngine {
 
         std::string getDescription() const override;
         bool isValid() const override;
+        uint64_t getHash() const override;
 
         // 获取动态状态列表
         const std::vector<VkDynamicState>& getDynamicStates() const { return mDynamicStates; }
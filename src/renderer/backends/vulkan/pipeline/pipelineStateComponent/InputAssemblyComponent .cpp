@@ -1,4 +1,5 @@
 #include "InputAssemblyComponent.hpp"
+#include "../../../../utils/Hash.hpp"
 
 namespace StarryEngine {
 
@@ -137,4 +138,39 @@ namespace StarryEngine {
         return true;
     }
 
+    uint64_t InputAssemblyComponent::getHash() const {
+        return Hasher().add(mCreateInfo.topology).add(mCreateInfo.primitiveRestartEnable).get();
+    }
+
+    uint64_t InputAssemblyComponent::getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const {
+        Hasher hasher;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY)) {
+            // 动态拓扑仍须与管线的拓扑类别（点/线/三角形/面片）一致
+            hasher.add(getTopologyClass(mCreateInfo.topology));
+        }
+        else {
+            hasher.add(mCreateInfo.topology);
+        }
+        if (!containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE)) {
+            hasher.add(mCreateInfo.primitiveRestartEnable);
+        }
+        return hasher.get();
+    }
+
+    uint32_t InputAssemblyComponent::getTopologyClass(VkPrimitiveTopology topology) {
+        switch (topology) {
+        case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+            return 0;
+        case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+            return 1;
+        case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+            return 3;
+        default:
+            return 2;
+        }
+    }
+
 } // namespace StarryEngine
\ No newline at end of file
@@ -31,11 +31,16 @@ namespace StarryEngine {
 
         std::string getDescription() const override;
         bool isValid() const override;
+        uint64_t getHash() const override;
+        uint64_t getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const override;
 
         // 获取当前拓扑和重启状态
         VkPrimitiveTopology getTopology() const { return mCreateInfo.topology; }
         VkBool32 getPrimitiveRestartEnable() const { return mCreateInfo.primitiveRestartEnable; }
 
+        // 拓扑类别：0点、1线、2三角形、3面片
+        static uint32_t getTopologyClass(VkPrimitiveTopology topology);
+
     private:
         VkPipelineInputAssemblyStateCreateInfo mCreateInfo{};
 
@@ -1,4 +1,5 @@
 #include "MultiSampleComponent.hpp"
+#include "../../../../utils/Hash.hpp"
 
 namespace StarryEngine {
 
@@ -159,4 +160,15 @@ namespace StarryEngine {
         mCreateInfo.pSampleMask = mSampleMask.empty() ? nullptr : mSampleMask.data();
     }
 
+    uint64_t MultiSampleComponent::getHash() const {
+        Hasher hasher;
+        hasher.add(mCreateInfo.rasterizationSamples)
+            .add(mCreateInfo.sampleShadingEnable)
+            .add(mCreateInfo.minSampleShading)
+            .add(mSampleMask)
+            .add(mCreateInfo.alphaToCoverageEnable)
+            .add(mCreateInfo.alphaToOneEnable);
+        return hasher.get();
+    }
+
 } // namespace StarryEngine
\ No newline at end of file
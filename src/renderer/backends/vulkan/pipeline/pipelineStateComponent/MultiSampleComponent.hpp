@@ -1,6 +1,7 @@
 #pragma once
 #include "../interface/TypedPipelineComponent.hpp"
 #include <vulkan/vulkan.h>
+#include <array>
 #include <vector>
 #include <memory>
 #include <stdexcept>
@@ -28,6 +29,21 @@ namespace StarryEngine {
 
         std::string getDescription() const override;
         bool isValid() const override;
+        uint64_t getHash() const override;
+
+        VkSampleCountFlagBits getRasterizationSamples() const { return mCreateInfo.rasterizationSamples; }
+        VkBool32 getAlphaToCoverageEnable() const { return mCreateInfo.alphaToCoverageEnable; }
+        // 最多64个采样，掩码最多两个字
+        static constexpr size_t MAX_SAMPLE_MASK_WORDS = 2;
+
+        // 未设置采样掩码时返回全1，供动态状态使用；按值返回定长数组，每次绘制设置时不分配内存
+        std::array<VkSampleMask, MAX_SAMPLE_MASK_WORDS> getSampleMask() const {
+            std::array<VkSampleMask, MAX_SAMPLE_MASK_WORDS> mask = { ~0u, ~0u };
+            for (size_t i = 0; i < mSampleMask.size() && i < mask.size(); ++i) {
+                mask[i] = mSampleMask[i];
+            }
+            return mask;
+        }
 
     private:
         VkPipelineMultisampleStateCreateInfo mCreateInfo{};
@@ -1,4 +1,5 @@
 #include "RasterizationComponent.hpp"
+#include "../../../../utils/Hash.hpp"
 
 namespace StarryEngine {
 
@@ -159,4 +160,42 @@ namespace StarryEngine {
 
         return true;
     }
+
+    uint64_t RasterizationComponent::getHash() const {
+        return hashState(mCreateInfo);
+    }
+
+    uint64_t RasterizationComponent::getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const {
+        // 动态字段置为固定值后再计算
+        VkPipelineRasterizationStateCreateInfo info = mCreateInfo;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE)) info.rasterizerDiscardEnable = VK_FALSE;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_POLYGON_MODE_EXT)) info.polygonMode = VK_POLYGON_MODE_FILL;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_CULL_MODE)) info.cullMode = VK_CULL_MODE_NONE;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_FRONT_FACE)) info.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE)) info.depthBiasEnable = VK_FALSE;
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_DEPTH_BIAS)) {
+            info.depthBiasConstantFactor = 0.0f;
+            info.depthBiasClamp = 0.0f;
+            info.depthBiasSlopeFactor = 0.0f;
+        }
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_LINE_WIDTH)) info.lineWidth = 1.0f;
+        return hashState(info);
+    }
+
+    uint64_t RasterizationComponent::hashState(const VkPipelineRasterizationStateCreateInfo& info) {
+        Hasher hasher;
+        hasher.add(info.flags)
+            .add(info.depthClampEnable)
+            .add(info.rasterizerDiscardEnable)
+            .add(info.polygonMode)
+            .add(info.cullMode)
+            .add(info.frontFace)
+            .add(info.depthBiasEnable)
+            .add(info.depthBiasConstantFactor)
+            .add(info.depthBiasClamp)
+            .add(info.depthBiasSlopeFactor)
+            .add(info.lineWidth);
+        return hasher.get();
+    }
+
 } // namespace StarryEngine
\ No newline at end of file
@@ -31,10 +31,24 @@ namespace StarryEngine {
 
         std::string getDescription() const override;
         bool isValid() const override;
+        uint64_t getHash() const override;
+        uint64_t getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const override;
+
+        VkPolygonMode getPolygonMode() const { return mCreateInfo.polygonMode; }
+        VkCullModeFlags getCullMode() const { return mCreateInfo.cullMode; }
+        VkFrontFace getFrontFace() const { return mCreateInfo.frontFace; }
+        VkBool32 getDepthBiasEnable() const { return mCreateInfo.depthBiasEnable; }
+        VkBool32 getRasterizerDiscardEnable() const { return mCreateInfo.rasterizerDiscardEnable; }
+        float getDepthBiasConstantFactor() const { return mCreateInfo.depthBiasConstantFactor; }
+        float getDepthBiasClamp() const { return mCreateInfo.depthBiasClamp; }
+        float getDepthBiasSlopeFactor() const { return mCreateInfo.depthBiasSlopeFactor; }
+        float getLineWidth() const { return mCreateInfo.lineWidth; }
 
     private:
         VkPipelineRasterizationStateCreateInfo mCreateInfo{};
 
+        static uint64_t hashState(const VkPipelineRasterizationStateCreateInfo& info);
+
         void updateCreateInfo() {}
     };
 } // namespace StarryEngine
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "ShaderStageComponent.hpp"
+#include "../../../../utils/Hash.hpp"
 
 namespace StarryEngine {
 
@@ -10,9 +11,47 @@ namespace StarryEngine {
     ShaderStageComponent& ShaderStageComponent::reset() {
         mShaderProgram.reset();
         mStageNames.clear();
+        mSpecializations.clear();
         return *this;
     }
 
+    ShaderStageComponent& ShaderStageComponent::setSpecialization(
+        VkShaderStageFlagBits stage, const ShaderSpecialization& specialization) {
+        mSpecializations[stage] = specialization;
+        return *this;
+    }
+
+    ShaderStageComponent& ShaderStageComponent::clearSpecializations() {
+        mSpecializations.clear();
+        return *this;
+    }
+
+    const std::vector<VkPipelineShaderStageCreateInfo>& ShaderStageComponent::resolveStages() {
+        // 每次重新生成：程序可能被热重载替换了模块
+        // 入口名和特化常量都深拷贝到组件自身，创建信息只指向这些副本
+        // 克隆出的组件交给工作线程后，程序再修改特化常量或热重载也不会影响它
+        mResolvedStages = mShaderProgram->getStages();
+        mResolvedEntryPoints.clear();
+        mMergedSpecializations.clear();
+
+        for (auto& stage : mResolvedStages) {
+            mResolvedEntryPoints.emplace_back(stage.pName);
+            stage.pName = mResolvedEntryPoints.back().c_str();
+
+            ShaderSpecialization merged;
+            if (const auto* base = mShaderProgram->getSpecialization(stage.stage)) {
+                merged = *base;
+            }
+            auto it = mSpecializations.find(stage.stage);
+            if (it != mSpecializations.end()) {
+                merged.merge(it->second);
+            }
+            auto& stored = mMergedSpecializations[stage.stage] = merged;
+            stage.pSpecializationInfo = stored.getInfo();
+        }
+        return mResolvedStages;
+    }
+
     ShaderStageComponent& ShaderStageComponent::setShaderProgram(std::shared_ptr<ShaderProgram> program) {
         mShaderProgram = program;
         return *this;
@@ -141,6 +180,11 @@ namespace StarryEngine {
             else {
                 desc += stageName;
             }
+
+            auto spec = mSpecializations.find(stages[i].stage);
+            if (spec != mSpecializations.end() && !spec->second.empty()) {
+                desc += "{" + std::to_string(spec->second.size()) + " spec constants}";
+            }
         }
 
         return desc;
@@ -196,8 +240,53 @@ namespace StarryEngine {
         return false;
     }
 
+    bool ShaderStageComponent::referencesFile(const std::string& path) const {
+        return mShaderProgram && mShaderProgram->referencesFile(path);
+    }
+
     void ShaderStageComponent::updateCreateInfo() {
         // 这个组件不需要更新创建信息，因为直接使用ShaderProgram
     }
 
+    uint64_t ShaderStageComponent::getHash() const {
+        return getStageHash(VK_SHADER_STAGE_ALL);
+    }
+
+    uint64_t ShaderStageComponent::getStageHash(VkShaderStageFlags stageMask) const {
+        Hasher hasher;
+        if (!mShaderProgram) {
+            return hasher.get();
+        }
+
+        // 按模块内容（SPIR-V哈希）而非VkShaderModule句柄计算，特化常量取合并后的值
+        const auto& stages = mShaderProgram->getStages();
+        const auto& modules = mShaderProgram->getShaderModules();
+        uint64_t stageCount = 0;
+        for (const auto& stage : stages) {
+            if (stage.stage & stageMask) {
+                stageCount++;
+            }
+        }
+        hasher.add(stageCount);
+        for (size_t i = 0; i < stages.size(); ++i) {
+            if (!(stages[i].stage & stageMask)) {
+                continue;
+            }
+            hasher.add(stages[i].stage)
+                .add(i < modules.size() ? modules[i]->getHash() : 0ull)
+                .add(stages[i].pName);
+
+            ShaderSpecialization merged;
+            if (const auto* base = mShaderProgram->getSpecialization(stages[i].stage)) {
+                merged = *base;
+            }
+            auto it = mSpecializations.find(stages[i].stage);
+            if (it != mSpecializations.end()) {
+                merged.merge(it->second);
+            }
+            hasher.add(merged.getHash());
+        }
+        return hasher.get();
+    }
+
 } // namespace StarryEngine
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "../../../../../renderer/resource/shaders/ShaderProgram.hpp"
 #include "../../../../../renderer/resource/shaders/ShaderBuilder.hpp"
 #include <vulkan/vulkan.h>
+#include <deque>
 #include <vector>
 #include <memory>
 #include <string>
@@ -47,11 +48,18 @@ namespace StarryEngine {
             const std::vector<std::pair<std::string, std::string>>& macros = {},
             const std::string& debugName = "");
 
+        // 覆盖指定阶段的特化常量（与程序自带的常量合并，组件中的值优先）
+        // 多个组件可以共享同一个ShaderProgram，各自生成不同的管线变体
+        ShaderStageComponent& setSpecialization(VkShaderStageFlagBits stage, const ShaderSpecialization& specialization);
+        ShaderStageComponent& clearSpecializations();
+        const std::unordered_map<VkShaderStageFlagBits, ShaderSpecialization>& getSpecializations() const { return mSpecializations; }
+
         // 应用组件到管线创建信息
         void apply(VkGraphicsPipelineCreateInfo& pipelineInfo) override {
             if (mShaderProgram && !mShaderProgram->getStages().empty()) {
-                pipelineInfo.stageCount = static_cast<uint32_t>(mShaderProgram->getStages().size());
-                pipelineInfo.pStages = mShaderProgram->getStages().data();
+                const auto& stages = resolveStages();
+                pipelineInfo.stageCount = static_cast<uint32_t>(stages.size());
+                pipelineInfo.pStages = stages.data();
             }
             else {
                 pipelineInfo.stageCount = 0;
@@ -59,8 +67,15 @@ namespace StarryEngine {
             }
         }
 
+        // 应用特化常量覆盖后的阶段信息（存放在组件内）
+        const std::vector<VkPipelineShaderStageCreateInfo>& resolveStages();
+
         std::string getDescription() const override;
         bool isValid() const override;
+        uint64_t getHash() const override;
+
+        // 只计算stageMask内阶段的哈希（管线库按阶段拆分缓存时使用）
+        uint64_t getStageHash(VkShaderStageFlags stageMask) const;
 
         // 获取着色器程序
         std::shared_ptr<ShaderProgram> getShaderProgram() const { return mShaderProgram; }
@@ -68,9 +83,18 @@ namespace StarryEngine {
         // 检查是否包含特定阶段的着色器
         bool hasStage(VkShaderStageFlagBits stage) const;
 
+        // 检查是否有阶段来自指定源文件（热重载时定位受影响的组件）
+        bool referencesFile(const std::string& path) const;
+
     private:
         std::shared_ptr<ShaderProgram> mShaderProgram;
         std::unordered_map<VkShaderStageFlagBits, std::string> mStageNames;
+        std::unordered_map<VkShaderStageFlagBits, ShaderSpecialization> mSpecializations;
+
+        // resolveStages()的结果，pName指向mResolvedEntryPoints，pSpecializationInfo指向mMergedSpecializations
+        std::vector<VkPipelineShaderStageCreateInfo> mResolvedStages;
+        std::deque<std::string> mResolvedEntryPoints;  // deque保证地址稳定
+        std::unordered_map<VkShaderStageFlagBits, ShaderSpecialization> mMergedSpecializations;
 
         void updateCreateInfo();
     };
@@ -1,4 +1,5 @@
 #include"VertexInputComponent.hpp"
+#include "../../../../utils/Hash.hpp"
 
 
 namespace StarryEngine {
@@ -140,4 +141,24 @@ namespace StarryEngine {
         mCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(mAttributes.size());
         mCreateInfo.pVertexAttributeDescriptions = mAttributes.empty() ? nullptr : mAttributes.data();
     }
+
+    uint64_t VertexInputComponent::getHash() const {
+        return Hasher().add(mBindings).add(mAttributes).get();
+    }
+
+    uint64_t VertexInputComponent::getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const {
+        // 动态顶点输入时布局完全在绘制时设置
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_VERTEX_INPUT_EXT)) {
+            return Hasher().get();
+        }
+        if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_VERTEX_INPUT_BINDING_STRIDE)) {
+            auto bindings = mBindings;
+            for (auto& binding : bindings) {
+                binding.stride = 0;
+            }
+            return Hasher().add(bindings).add(mAttributes).get();
+        }
+        return getHash();
+    }
+
 }
\ No newline at end of file
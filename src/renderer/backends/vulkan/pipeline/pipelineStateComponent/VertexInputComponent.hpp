@@ -45,6 +45,8 @@ namespace StarryEngine {
         uint32_t getAttributeCount() const { return static_cast<uint32_t>(mAttributes.size()); }
 
         bool isValid() const override;
+        uint64_t getHash() const override;
+        uint64_t getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const override;
     private:
         std::vector<VkVertexInputBindingDescription> mBindings;
         std::vector<VkVertexInputAttributeDescription> mAttributes;
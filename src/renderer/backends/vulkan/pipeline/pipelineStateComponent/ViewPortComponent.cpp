@@ -1,4 +1,5 @@
 #include "ViewportComponent.hpp"
+#include "../../../../utils/Hash.hpp"
 
 namespace StarryEngine {
     ViewportScissor::ViewportScissor(float x, float y, float width, float height,
@@ -87,4 +88,30 @@ namespace StarryEngine {
         mCreateInfo.pScissors = mScissors.empty() ? nullptr : mScissors.data();
     }
 
+    uint64_t ViewportComponent::getHash() const {
+        return Hasher().add(mViewports).add(mScissors).get();
+    }
+
+    uint64_t ViewportComponent::getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const {
+        Hasher hasher;
+        // *_WITH_COUNT连数量也在绘制时设置
+        if (!containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT)) {
+            if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_VIEWPORT)) {
+                hasher.add(static_cast<uint32_t>(mViewports.size()));
+            }
+            else {
+                hasher.add(mViewports);
+            }
+        }
+        if (!containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT)) {
+            if (containsDynamicState(dynamicStates, VK_DYNAMIC_STATE_SCISSOR)) {
+                hasher.add(static_cast<uint32_t>(mScissors.size()));
+            }
+            else {
+                hasher.add(mScissors);
+            }
+        }
+        return hasher.get();
+    }
+
 }
\ No newline at end of file
@@ -39,6 +39,9 @@ namespace StarryEngine {
         const std::vector<VkViewport>& getViewports() const { return mViewports; }
         const std::vector<VkRect2D>& getScissors() const { return mScissors; }
         bool isValid() const override { return mViewports.size() == mScissors.size(); }
+        uint64_t getHash() const override;
+        // 视口/裁剪为动态状态时只计入数量，窗口大小变化不产生新的管线键
+        uint64_t getStaticHash(const std::vector<VkDynamicState>& dynamicStates) const override;
         uint32_t getViewportCount() const { return static_cast<uint32_t>(mViewports.size()); }
 
     private:
@@ -1,10 +1,54 @@
 #include "RenderContext.hpp"
+#include "../pipeline/PipelineCache.hpp"
+#include "../pipeline/pipelineStateComponent/DynamicStateComponent.hpp"
+#include "../pipeline/pipelineStateComponent/RasterizationComponent.hpp"
+#include "../pipeline/pipelineStateComponent/DepthStencilComponent.hpp"
+#include "../pipeline/pipelineStateComponent/ColorBlendComponent.hpp"
+#include "../pipeline/pipelineStateComponent/InputAssemblyComponent.hpp"
+#include "../pipeline/pipelineStateComponent/VertexInputComponent.hpp"
+#include "../pipeline/pipelineStateComponent/MultiSampleComponent.hpp"
+#include "../pipeline/pipelineStateComponent/ViewPortComponent.hpp"
+#include "../descriptor/TransientDescriptorAllocator.hpp"
+#include "../../../resource/shaders/ShaderObject.hpp"
+#include <algorithm>
+#include <array>
 #include <stdexcept>
+#include <string>
 
 namespace StarryEngine {
 
-    RenderContext::RenderContext(std::shared_ptr<LogicalDevice> device, VkCommandBuffer cmd, uint32_t frameIndex)
-        : mDevice(device), mCommandBuffer(cmd), mFrameIndex(frameIndex) {
+    namespace {
+        template<typename Function>
+        Function requireCommand(Function function, const char* name) {
+            if (function == nullptr) {
+                throw std::runtime_error(std::string(name) + " is not supported by the device");
+            }
+            return function;
+        }
+
+        template<typename Component>
+        const Component& requireComponent(
+            const std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>>& components,
+            PipelineComponentType type) {
+            auto it = components.find(type);
+            auto component = it != components.end() ? std::dynamic_pointer_cast<Component>(it->second) : nullptr;
+            if (!component) {
+                throw std::runtime_error(std::string("Missing ") + getComponentTypeName(type) +
+                    " component for shader object state");
+            }
+            return *component;
+        }
+    }
+
+    RenderContext::RenderContext(std::shared_ptr<LogicalDevice> device, VkCommandBuffer cmd, uint32_t frameIndex,
+        std::shared_ptr<TransientDescriptorAllocator> transientDescriptors)
+        : mDevice(device), mCommandBuffer(cmd), mFrameIndex(frameIndex),
+        mTransientDescriptors(std::move(transientDescriptors)) {
+    }
+
+    void RenderContext::reset() {
+        mSkipDraws = false;
+        mBoundDescriptorSets = {};
     }
 
     // ==================== 渲染通道管理 ====================
@@ -14,6 +58,8 @@ namespace StarryEngine {
             throw std::invalid_argument("RenderPassBeginInfo cannot be null");
         }
         vkCmdBeginRenderPass(mCommandBuffer, renderPassBeginInfo, subpassContents);
+        mSkipDraws = false;
+        mBoundDescriptorSets = {};
     }
 
 
@@ -23,6 +69,18 @@ namespace StarryEngine {
 
     void RenderContext::endRenderPass() {
         vkCmdEndRenderPass(mCommandBuffer);
+        mBoundDescriptorSets = {};
+    }
+
+    void RenderContext::beginRendering(const VkRenderingInfo& renderingInfo) {
+        vkCmdBeginRendering(mCommandBuffer, &renderingInfo);
+        mSkipDraws = false;
+        mBoundDescriptorSets = {};
+    }
+
+    void RenderContext::endRendering() {
+        vkCmdEndRendering(mCommandBuffer);
+        mBoundDescriptorSets = {};
     }
 
     // ==================== 管线状态管理 ====================
@@ -32,6 +90,23 @@ namespace StarryEngine {
             throw std::invalid_argument("Graphics pipeline cannot be null");
         }
         vkCmdBindPipeline(mCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        mSkipDraws = false;
+    }
+
+    bool RenderContext::bindGraphicsPipeline(const AsyncPipeline& pipeline) {
+        VkPipeline handle = pipeline.getPipeline();
+        if (handle == VK_NULL_HANDLE) {
+            auto pipelineCache = PipelineCache::find(mDevice->getHandle());
+            handle = pipelineCache ? pipelineCache->getFallbackPipeline(pipeline.getPipelineLayout()) : VK_NULL_HANDLE;
+        }
+
+        if (handle == VK_NULL_HANDLE) {
+            mSkipDraws = true;
+            return false;
+        }
+        vkCmdBindPipeline(mCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, handle);
+        mSkipDraws = false;
+        return true;
     }
 
     void RenderContext::bindComputePipeline(VkPipeline pipeline) {
@@ -53,6 +128,355 @@ namespace StarryEngine {
         vkCmdSetBlendConstants(mCommandBuffer, constants);
     }
 
+    // ==================== 扩展动态状态 ====================
+
+    void RenderContext::setCullMode(VkCullModeFlags cullMode) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetCullMode, "vkCmdSetCullMode")(mCommandBuffer, cullMode);
+    }
+
+    void RenderContext::setFrontFace(VkFrontFace frontFace) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetFrontFace, "vkCmdSetFrontFace")(mCommandBuffer, frontFace);
+    }
+
+    void RenderContext::setPrimitiveTopology(VkPrimitiveTopology topology) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetPrimitiveTopology,
+            "vkCmdSetPrimitiveTopology")(mCommandBuffer, topology);
+    }
+
+    void RenderContext::setPrimitiveRestartEnable(VkBool32 enable) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetPrimitiveRestartEnable,
+            "vkCmdSetPrimitiveRestartEnable")(mCommandBuffer, enable);
+    }
+
+    void RenderContext::setDepthTestEnable(VkBool32 enable) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetDepthTestEnable,
+            "vkCmdSetDepthTestEnable")(mCommandBuffer, enable);
+    }
+
+    void RenderContext::setDepthWriteEnable(VkBool32 enable) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetDepthWriteEnable,
+            "vkCmdSetDepthWriteEnable")(mCommandBuffer, enable);
+    }
+
+    void RenderContext::setDepthCompareOp(VkCompareOp compareOp) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetDepthCompareOp,
+            "vkCmdSetDepthCompareOp")(mCommandBuffer, compareOp);
+    }
+
+    void RenderContext::setDepthBoundsTestEnable(VkBool32 enable) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetDepthBoundsTestEnable,
+            "vkCmdSetDepthBoundsTestEnable")(mCommandBuffer, enable);
+    }
+
+    void RenderContext::setStencilTestEnable(VkBool32 enable) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetStencilTestEnable,
+            "vkCmdSetStencilTestEnable")(mCommandBuffer, enable);
+    }
+
+    void RenderContext::setStencilOp(VkStencilFaceFlags faceMask, const VkStencilOpState& state) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetStencilOp, "vkCmdSetStencilOp")(
+            mCommandBuffer, faceMask, state.failOp, state.passOp, state.depthFailOp, state.compareOp);
+    }
+
+    void RenderContext::setDepthBiasEnable(VkBool32 enable) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetDepthBiasEnable,
+            "vkCmdSetDepthBiasEnable")(mCommandBuffer, enable);
+    }
+
+    void RenderContext::setRasterizerDiscardEnable(VkBool32 enable) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetRasterizerDiscardEnable,
+            "vkCmdSetRasterizerDiscardEnable")(mCommandBuffer, enable);
+    }
+
+    void RenderContext::setPolygonMode(VkPolygonMode polygonMode) {
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetPolygonMode,
+            "vkCmdSetPolygonModeEXT")(mCommandBuffer, polygonMode);
+    }
+
+    void RenderContext::setColorBlendEnable(uint32_t firstAttachment, const std::vector<VkBool32>& enables) {
+        if (enables.empty()) {
+            return;
+        }
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetColorBlendEnable, "vkCmdSetColorBlendEnableEXT")(
+            mCommandBuffer, firstAttachment, static_cast<uint32_t>(enables.size()), enables.data());
+    }
+
+    void RenderContext::setColorBlendEquation(uint32_t firstAttachment,
+        const std::vector<VkColorBlendEquationEXT>& equations) {
+        if (equations.empty()) {
+            return;
+        }
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetColorBlendEquation, "vkCmdSetColorBlendEquationEXT")(
+            mCommandBuffer, firstAttachment, static_cast<uint32_t>(equations.size()), equations.data());
+    }
+
+    void RenderContext::setVertexInput(const std::vector<VkVertexInputBindingDescription>& bindings,
+        const std::vector<VkVertexInputAttributeDescription>& attributes) {
+        // 每次绘制都可能调用，转换结果放在栈上
+        if (bindings.size() > MAX_VERTEX_INPUT_BINDINGS || attributes.size() > MAX_VERTEX_INPUT_ATTRIBUTES) {
+            throw std::runtime_error("Too many vertex input bindings or attributes for dynamic vertex input");
+        }
+
+        std::array<VkVertexInputBindingDescription2EXT, MAX_VERTEX_INPUT_BINDINGS> bindings2{};
+        for (size_t i = 0; i < bindings.size(); ++i) {
+            bindings2[i].sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_BINDING_DESCRIPTION_2_EXT;
+            bindings2[i].binding = bindings[i].binding;
+            bindings2[i].stride = bindings[i].stride;
+            bindings2[i].inputRate = bindings[i].inputRate;
+            bindings2[i].divisor = 1;
+        }
+
+        std::array<VkVertexInputAttributeDescription2EXT, MAX_VERTEX_INPUT_ATTRIBUTES> attributes2{};
+        for (size_t i = 0; i < attributes.size(); ++i) {
+            attributes2[i].sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_ATTRIBUTE_DESCRIPTION_2_EXT;
+            attributes2[i].location = attributes[i].location;
+            attributes2[i].binding = attributes[i].binding;
+            attributes2[i].format = attributes[i].format;
+            attributes2[i].offset = attributes[i].offset;
+        }
+
+        requireCommand(mDevice->getDynamicStateCommands().cmdSetVertexInput, "vkCmdSetVertexInputEXT")(
+            mCommandBuffer, static_cast<uint32_t>(bindings.size()), bindings2.data(),
+            static_cast<uint32_t>(attributes.size()), attributes2.data());
+    }
+
+    void RenderContext::applyDynamicState(const DynamicStateComponent& dynamicState,
+        const RasterizationComponent& rasterization) {
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_CULL_MODE)) {
+            setCullMode(rasterization.getCullMode());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_FRONT_FACE)) {
+            setFrontFace(rasterization.getFrontFace());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_POLYGON_MODE_EXT)) {
+            setPolygonMode(rasterization.getPolygonMode());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE)) {
+            setDepthBiasEnable(rasterization.getDepthBiasEnable());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_DEPTH_BIAS)) {
+            vkCmdSetDepthBias(mCommandBuffer, rasterization.getDepthBiasConstantFactor(),
+                rasterization.getDepthBiasClamp(), rasterization.getDepthBiasSlopeFactor());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE)) {
+            setRasterizerDiscardEnable(rasterization.getRasterizerDiscardEnable());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_LINE_WIDTH)) {
+            vkCmdSetLineWidth(mCommandBuffer, rasterization.getLineWidth());
+        }
+    }
+
+    void RenderContext::applyDynamicState(const DynamicStateComponent& dynamicState,
+        const DepthStencilComponent& depthStencil) {
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE)) {
+            setDepthTestEnable(depthStencil.getDepthTestEnable());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE)) {
+            setDepthWriteEnable(depthStencil.getDepthWriteEnable());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP)) {
+            setDepthCompareOp(depthStencil.getDepthCompareOp());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE)) {
+            setDepthBoundsTestEnable(depthStencil.getDepthBoundsTestEnable());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE)) {
+            setStencilTestEnable(depthStencil.getStencilTestEnable());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_STENCIL_OP)) {
+            setStencilOp(VK_STENCIL_FACE_FRONT_BIT, depthStencil.getFrontStencilOpState());
+            setStencilOp(VK_STENCIL_FACE_BACK_BIT, depthStencil.getBackStencilOpState());
+        }
+    }
+
+    void RenderContext::applyDynamicState(const DynamicStateComponent& dynamicState,
+        const ColorBlendComponent& colorBlend) {
+        // 每次绘制都可能调用，与applyGraphicsState一样放在栈上
+        const auto& attachments = colorBlend.getAttachmentStates();
+        if (attachments.size() > MAX_COLOR_ATTACHMENTS) {
+            throw std::runtime_error("Too many color attachments for dynamic color blend state");
+        }
+        const uint32_t attachmentCount = static_cast<uint32_t>(attachments.size());
+        const auto& commands = mDevice->getDynamicStateCommands();
+        if (attachmentCount > 0 && dynamicState.hasDynamicState(VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT)) {
+            std::array<VkBool32, MAX_COLOR_ATTACHMENTS> enables{};
+            for (uint32_t i = 0; i < attachmentCount; ++i) {
+                enables[i] = attachments[i].blendEnable;
+            }
+            requireCommand(commands.cmdSetColorBlendEnable, "vkCmdSetColorBlendEnableEXT")(
+                mCommandBuffer, 0, attachmentCount, enables.data());
+        }
+        if (attachmentCount > 0 && dynamicState.hasDynamicState(VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT)) {
+            std::array<VkColorBlendEquationEXT, MAX_COLOR_ATTACHMENTS> equations{};
+            for (uint32_t i = 0; i < attachmentCount; ++i) {
+                const auto& attachment = attachments[i];
+                equations[i] = {
+                    attachment.srcColorBlendFactor, attachment.dstColorBlendFactor, attachment.colorBlendOp,
+                    attachment.srcAlphaBlendFactor, attachment.dstAlphaBlendFactor, attachment.alphaBlendOp };
+            }
+            requireCommand(commands.cmdSetColorBlendEquation, "vkCmdSetColorBlendEquationEXT")(
+                mCommandBuffer, 0, attachmentCount, equations.data());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_BLEND_CONSTANTS)) {
+            setBlendConstants(colorBlend.getBlendConstants());
+        }
+    }
+
+    void RenderContext::applyDynamicState(const DynamicStateComponent& dynamicState,
+        const InputAssemblyComponent& inputAssembly) {
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY)) {
+            setPrimitiveTopology(inputAssembly.getTopology());
+        }
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE)) {
+            setPrimitiveRestartEnable(inputAssembly.getPrimitiveRestartEnable());
+        }
+    }
+
+    void RenderContext::applyDynamicState(const DynamicStateComponent& dynamicState,
+        const VertexInputComponent& vertexInput) {
+        if (dynamicState.hasDynamicState(VK_DYNAMIC_STATE_VERTEX_INPUT_EXT)) {
+            setVertexInput(vertexInput.getBindings(), vertexInput.getAttributes());
+        }
+    }
+
+    // ==================== 着色器对象 ====================
+
+    void RenderContext::bindShaderObject(const ShaderObject& shaderObject) {
+        auto bindShaders = requireCommand(mDevice->getShaderObjectCommands().cmdBindShaders, "vkCmdBindShadersEXT");
+
+        // 绑定着色器对象后，之前绑定的管线不再生效；未使用的阶段须显式解绑
+        std::array<VkShaderStageFlagBits, 5> stages{};
+        uint32_t stageCount = 0;
+        stages[stageCount++] = VK_SHADER_STAGE_VERTEX_BIT;
+        stages[stageCount++] = VK_SHADER_STAGE_FRAGMENT_BIT;
+        const auto& features = mDevice->getEnabledFeatures();
+        if (features.tessellationShader) {
+            stages[stageCount++] = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+            stages[stageCount++] = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+        }
+        if (features.geometryShader) {
+            stages[stageCount++] = VK_SHADER_STAGE_GEOMETRY_BIT;
+        }
+
+        std::array<VkShaderEXT, 5> shaders{};
+        const auto& objectStages = shaderObject.getStages();
+        const auto& objectShaders = shaderObject.getShaders();
+        for (uint32_t i = 0; i < stageCount; ++i) {
+            for (size_t j = 0; j < objectStages.size(); ++j) {
+                if (objectStages[j] == stages[i]) {
+                    shaders[i] = objectShaders[j];
+                }
+            }
+        }
+
+        bindShaders(mCommandBuffer, stageCount, stages.data(), shaders.data());
+        mSkipDraws = false;
+    }
+
+    RenderContext::GraphicsState RenderContext::resolveGraphicsState(
+        const std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>>& components) {
+        GraphicsState state;
+        state.viewport = &requireComponent<ViewportComponent>(components, PipelineComponentType::VIEWPORT_STATE);
+        state.rasterization = &requireComponent<RasterizationComponent>(components, PipelineComponentType::RASTERIZATION);
+        state.multiSample = &requireComponent<MultiSampleComponent>(components, PipelineComponentType::MULTISAMPLE);
+        state.depthStencil = &requireComponent<DepthStencilComponent>(components, PipelineComponentType::DEPTH_STENCIL);
+        state.colorBlend = &requireComponent<ColorBlendComponent>(components, PipelineComponentType::COLOR_BLEND);
+        state.inputAssembly = &requireComponent<InputAssemblyComponent>(components, PipelineComponentType::INPUT_ASSEMBLY);
+        state.vertexInput = &requireComponent<VertexInputComponent>(components, PipelineComponentType::VERTEX_INPUT);
+        return state;
+    }
+
+    void RenderContext::applyGraphicsState(
+        const std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>>& components) {
+        applyGraphicsState(resolveGraphicsState(components));
+    }
+
+    void RenderContext::applyGraphicsState(const GraphicsState& state) {
+        const auto& commands = mDevice->getDynamicStateCommands();
+        const auto& viewport = *state.viewport;
+        const auto& rasterization = *state.rasterization;
+        const auto& multiSample = *state.multiSample;
+        const auto& depthStencil = *state.depthStencil;
+        const auto& colorBlend = *state.colorBlend;
+        const auto& inputAssembly = *state.inputAssembly;
+        const auto& vertexInput = *state.vertexInput;
+
+        // 视口与裁剪
+        const auto& viewports = viewport.getViewports();
+        const auto& scissors = viewport.getScissors();
+        requireCommand(commands.cmdSetViewportWithCount, "vkCmdSetViewportWithCount")(
+            mCommandBuffer, static_cast<uint32_t>(viewports.size()), viewports.data());
+        requireCommand(commands.cmdSetScissorWithCount, "vkCmdSetScissorWithCount")(
+            mCommandBuffer, static_cast<uint32_t>(scissors.size()), scissors.data());
+
+        // 光栅化
+        setRasterizerDiscardEnable(rasterization.getRasterizerDiscardEnable());
+        setPolygonMode(rasterization.getPolygonMode());
+        setCullMode(rasterization.getCullMode());
+        setFrontFace(rasterization.getFrontFace());
+        setDepthBiasEnable(rasterization.getDepthBiasEnable());
+        vkCmdSetDepthBias(mCommandBuffer, rasterization.getDepthBiasConstantFactor(),
+            rasterization.getDepthBiasClamp(), rasterization.getDepthBiasSlopeFactor());
+        vkCmdSetLineWidth(mCommandBuffer, rasterization.getLineWidth());
+
+        // 多重采样
+        const auto sampleMask = multiSample.getSampleMask();
+        requireCommand(commands.cmdSetRasterizationSamples, "vkCmdSetRasterizationSamplesEXT")(
+            mCommandBuffer, multiSample.getRasterizationSamples());
+        requireCommand(commands.cmdSetSampleMask, "vkCmdSetSampleMaskEXT")(
+            mCommandBuffer, multiSample.getRasterizationSamples(), sampleMask.data());
+        requireCommand(commands.cmdSetAlphaToCoverageEnable, "vkCmdSetAlphaToCoverageEnableEXT")(
+            mCommandBuffer, multiSample.getAlphaToCoverageEnable());
+
+        // 深度模板
+        setDepthTestEnable(depthStencil.getDepthTestEnable());
+        setDepthWriteEnable(depthStencil.getDepthWriteEnable());
+        setDepthCompareOp(depthStencil.getDepthCompareOp());
+        setStencilTestEnable(depthStencil.getStencilTestEnable());
+        const VkStencilOpState& front = depthStencil.getFrontStencilOpState();
+        const VkStencilOpState& back = depthStencil.getBackStencilOpState();
+        setStencilOp(VK_STENCIL_FACE_FRONT_BIT, front);
+        setStencilOp(VK_STENCIL_FACE_BACK_BIT, back);
+        vkCmdSetStencilCompareMask(mCommandBuffer, VK_STENCIL_FACE_FRONT_BIT, front.compareMask);
+        vkCmdSetStencilCompareMask(mCommandBuffer, VK_STENCIL_FACE_BACK_BIT, back.compareMask);
+        vkCmdSetStencilWriteMask(mCommandBuffer, VK_STENCIL_FACE_FRONT_BIT, front.writeMask);
+        vkCmdSetStencilWriteMask(mCommandBuffer, VK_STENCIL_FACE_BACK_BIT, back.writeMask);
+        vkCmdSetStencilReference(mCommandBuffer, VK_STENCIL_FACE_FRONT_BIT, front.reference);
+        vkCmdSetStencilReference(mCommandBuffer, VK_STENCIL_FACE_BACK_BIT, back.reference);
+
+        // 颜色混合（逐附件状态放在栈上，避免每次绘制分配内存）
+        const auto& attachments = colorBlend.getAttachmentStates();
+        if (attachments.size() > MAX_COLOR_ATTACHMENTS) {
+            throw std::runtime_error("Too many color attachments for shader object state");
+        }
+        std::array<VkBool32, MAX_COLOR_ATTACHMENTS> enables{};
+        std::array<VkColorBlendEquationEXT, MAX_COLOR_ATTACHMENTS> equations{};
+        std::array<VkColorComponentFlags, MAX_COLOR_ATTACHMENTS> writeMasks{};
+        const uint32_t attachmentCount = static_cast<uint32_t>(attachments.size());
+        for (uint32_t i = 0; i < attachmentCount; ++i) {
+            const auto& attachment = attachments[i];
+            enables[i] = attachment.blendEnable;
+            equations[i] = {
+                attachment.srcColorBlendFactor, attachment.dstColorBlendFactor, attachment.colorBlendOp,
+                attachment.srcAlphaBlendFactor, attachment.dstAlphaBlendFactor, attachment.alphaBlendOp };
+            writeMasks[i] = attachment.colorWriteMask;
+        }
+        if (attachmentCount > 0) {
+            requireCommand(commands.cmdSetColorBlendEnable, "vkCmdSetColorBlendEnableEXT")(
+                mCommandBuffer, 0, attachmentCount, enables.data());
+            requireCommand(commands.cmdSetColorBlendEquation, "vkCmdSetColorBlendEquationEXT")(
+                mCommandBuffer, 0, attachmentCount, equations.data());
+            requireCommand(commands.cmdSetColorWriteMask, "vkCmdSetColorWriteMaskEXT")(
+                mCommandBuffer, 0, attachmentCount, writeMasks.data());
+        }
+        setBlendConstants(colorBlend.getBlendConstants());
+
+        // 输入装配与顶点输入
+        setPrimitiveTopology(inputAssembly.getTopology());
+        setPrimitiveRestartEnable(inputAssembly.getPrimitiveRestartEnable());
+        setVertexInput(vertexInput.getBindings(), vertexInput.getAttributes());
+    }
+
     // ==================== 资源绑定 ====================
 
     void RenderContext::bindVertexBuffer(VkBuffer buffer, uint32_t binding, VkDeviceSize offset) {
@@ -94,6 +518,9 @@ namespace StarryEngine {
             throw std::invalid_argument("Pipeline layout cannot be null");
         }
 
+        if (isDescriptorSetsBound(bindPoint, layout, firstSet, &descriptorSet, 1)) {
+            return;
+        }
         vkCmdBindDescriptorSets(mCommandBuffer, bindPoint, layout, firstSet, 1, &descriptorSet, 0, nullptr);
     }
 
@@ -112,15 +539,43 @@ namespace StarryEngine {
             }
         }
 
+        const uint32_t count = static_cast<uint32_t>(descriptorSets.size());
+        if (isDescriptorSetsBound(bindPoint, layout, firstSet, descriptorSets.data(), count)) {
+            return;
+        }
         vkCmdBindDescriptorSets(mCommandBuffer, bindPoint, layout, firstSet,
-            static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(),
+            count, descriptorSets.data(),
             0, nullptr);
     }
 
+    bool RenderContext::isDescriptorSetsBound(VkPipelineBindPoint bindPoint, VkPipelineLayout layout,
+        uint32_t firstSet, const VkDescriptorSet* descriptorSets, uint32_t count) {
+        auto& bound = mBoundDescriptorSets;
+        if (bound.bindPoint == bindPoint && bound.layout == layout && bound.firstSet == firstSet &&
+            std::equal(bound.sets.begin(), bound.sets.end(), descriptorSets, descriptorSets + count)) {
+            return true;
+        }
+        bound.bindPoint = bindPoint;
+        bound.layout = layout;
+        bound.firstSet = firstSet;
+        bound.sets.assign(descriptorSets, descriptorSets + count);
+        return false;
+    }
+
+    VkDescriptorSet RenderContext::allocateTransientSet(VkDescriptorSetLayout layout) {
+        if (!mTransientDescriptors) {
+            throw std::runtime_error("RenderContext has no transient descriptor allocator");
+        }
+        return mTransientDescriptors->allocate(layout);
+    }
+
     // ==================== 绘制和分发命令 ====================
 
     void RenderContext::draw(uint32_t vertexCount, uint32_t instanceCount,
         uint32_t firstVertex, uint32_t firstInstance) {
+        if (mSkipDraws) {
+            return;
+        }
         if (vertexCount == 0) {
             throw std::invalid_argument("Vertex count cannot be zero");
         }
@@ -133,6 +588,9 @@ namespace StarryEngine {
 
     void RenderContext::drawIndexed(uint32_t indexCount, uint32_t instanceCount,
         uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {
+        if (mSkipDraws) {
+            return;
+        }
         if (indexCount == 0) {
             throw std::invalid_argument("Index count cannot be zero");
         }
@@ -145,6 +603,9 @@ namespace StarryEngine {
 
     void RenderContext::drawIndirect(VkBuffer buffer, VkDeviceSize offset,
         uint32_t drawCount, uint32_t stride) {
+        if (mSkipDraws) {
+            return;
+        }
         if (buffer == VK_NULL_HANDLE) {
             throw std::invalid_argument("Indirect buffer cannot be null");
         }
@@ -157,6 +618,9 @@ namespace StarryEngine {
 
     void RenderContext::drawIndexedIndirect(VkBuffer buffer, VkDeviceSize offset,
         uint32_t drawCount, uint32_t stride) {
+        if (mSkipDraws) {
+            return;
+        }
         if (buffer == VK_NULL_HANDLE) {
             throw std::invalid_argument("Indirect buffer cannot be null");
         }
@@ -3,52 +3,137 @@
 #include "commandBuffer.hpp"
 #include "sync/fence.hpp"
 #include "sync/semaphore.hpp"
+#include "../pipeline/AsyncPipeline.hpp"
+#include "../pipeline/interface/IPipelineStateComponent.hpp"
 #include <vulkan/vulkan.h>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace StarryEngine {
+    class DynamicStateComponent;
+    class RasterizationComponent;
+    class DepthStencilComponent;
+    class ColorBlendComponent;
+    class InputAssemblyComponent;
+    class VertexInputComponent;
+    class MultiSampleComponent;
+    class ViewportComponent;
+    class ShaderObject;
+    class TransientDescriptorAllocator;
+
     struct FrameContext {
         CommandBuffer::Ptr mainCommandBuffer;
         Semaphore::Ptr imageAvailableSemaphore;
         Semaphore::Ptr renderFinishedSemaphore;
         Fence::Ptr inFlightFence; 
+        std::shared_ptr<TransientDescriptorAllocator> transientDescriptors;  // inFlightFence信号后重置
         std::unique_ptr<class RenderContext> renderContext;
 
         void initRenderContext(std::shared_ptr<LogicalDevice> device,uint32_t frameIndex) {
             renderContext = std::make_unique<RenderContext>(
                 device,
                 mainCommandBuffer->getHandle(),
-                frameIndex
+                frameIndex,
+                transientDescriptors
             );
         }
     };
 
     class RenderContext {
     public:
-        RenderContext(std::shared_ptr<LogicalDevice> device, VkCommandBuffer cmd, uint32_t frameIndex);
+        // 逐次绘制设置的状态使用栈上定长数组的上限
+        static constexpr size_t MAX_COLOR_ATTACHMENTS = 8;
+        static constexpr size_t MAX_VERTEX_INPUT_BINDINGS = 32;
+        static constexpr size_t MAX_VERTEX_INPUT_ATTRIBUTES = 32;
+
+        RenderContext(std::shared_ptr<LogicalDevice> device, VkCommandBuffer cmd, uint32_t frameIndex,
+            std::shared_ptr<TransientDescriptorAllocator> transientDescriptors = nullptr);
+
+        // 命令缓冲重新开始录制时调用：清除上一次录制留下的绑定记录
+        void reset();
 
         // 渲染通道管理
         void beginRenderPass(const VkRenderPassBeginInfo* renderPassBeginInfo, VkSubpassContents subpassContents);
         void nextSubpass(VkSubpassContents contents);
         void endRenderPass();
 
+        // 动态渲染（着色器对象不能在VkRenderPass中使用）
+        void beginRendering(const VkRenderingInfo& renderingInfo);
+        void endRendering();
+
         // 管线状态管理
         void bindGraphicsPipeline(VkPipeline pipeline);
+        // 异步管线：就绪时绑定真实管线，否则绑定同布局的后备管线
+        // 两者都没有时返回false，并跳过之后的绘制命令直到下一次绑定管线
+        bool bindGraphicsPipeline(const AsyncPipeline& pipeline);
         void bindComputePipeline(VkPipeline pipeline);
         void setViewport(const VkViewport& viewport);
         void setScissor(const VkRect2D& scissor);
         void setBlendConstants(const float constants[4]);
 
+        // 扩展动态状态（设备未启用对应功能时抛出异常）
+        void setCullMode(VkCullModeFlags cullMode);
+        void setFrontFace(VkFrontFace frontFace);
+        void setPrimitiveTopology(VkPrimitiveTopology topology);
+        void setPrimitiveRestartEnable(VkBool32 enable);
+        void setDepthTestEnable(VkBool32 enable);
+        void setDepthWriteEnable(VkBool32 enable);
+        void setDepthCompareOp(VkCompareOp compareOp);
+        void setDepthBoundsTestEnable(VkBool32 enable);
+        void setStencilTestEnable(VkBool32 enable);
+        void setStencilOp(VkStencilFaceFlags faceMask, const VkStencilOpState& state);
+        void setDepthBiasEnable(VkBool32 enable);
+        void setRasterizerDiscardEnable(VkBool32 enable);
+        void setPolygonMode(VkPolygonMode polygonMode);
+        void setColorBlendEnable(uint32_t firstAttachment, const std::vector<VkBool32>& enables);
+        void setColorBlendEquation(uint32_t firstAttachment, const std::vector<VkColorBlendEquationEXT>& equations);
+        void setVertexInput(const std::vector<VkVertexInputBindingDescription>& bindings,
+            const std::vector<VkVertexInputAttributeDescription>& attributes);
+
+        // 按组件的值录制dynamicState中声明为动态的字段，其余字段由管线决定
+        // 管线去重不再区分这些字段，绑定管线后、绘制前须为每个组件调用一次
+        void applyDynamicState(const DynamicStateComponent& dynamicState, const RasterizationComponent& rasterization);
+        void applyDynamicState(const DynamicStateComponent& dynamicState, const DepthStencilComponent& depthStencil);
+        void applyDynamicState(const DynamicStateComponent& dynamicState, const ColorBlendComponent& colorBlend);
+        void applyDynamicState(const DynamicStateComponent& dynamicState, const InputAssemblyComponent& inputAssembly);
+        void applyDynamicState(const DynamicStateComponent& dynamicState, const VertexInputComponent& vertexInput);
+
+        // 着色器对象路径：绑定程序的各阶段，其余图形阶段绑定为空
+        void bindShaderObject(const ShaderObject& shaderObject);
+        // 着色器对象没有管线状态，按组件录制绘制所需的全部状态；缺少必需组件时抛出异常
+        void applyGraphicsState(
+            const std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>>& components);
+        // 已解析好的组件引用，可按材质缓存，逐次绘制时不再查表
+        struct GraphicsState {
+            const ViewportComponent* viewport = nullptr;
+            const RasterizationComponent* rasterization = nullptr;
+            const MultiSampleComponent* multiSample = nullptr;
+            const DepthStencilComponent* depthStencil = nullptr;
+            const ColorBlendComponent* colorBlend = nullptr;
+            const InputAssemblyComponent* inputAssembly = nullptr;
+            const VertexInputComponent* vertexInput = nullptr;
+        };
+        static GraphicsState resolveGraphicsState(
+            const std::unordered_map<PipelineComponentType, std::shared_ptr<IPipelineStateComponent>>& components);
+        void applyGraphicsState(const GraphicsState& state);
+
         // 资源绑定
         void bindVertexBuffer(VkBuffer buffer, uint32_t binding = 0, VkDeviceSize offset = 0);
         void bindVertexBuffers(const std::vector<VkBuffer>& buffers);
         void bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset = 0,
             VkIndexType indexType = VK_INDEX_TYPE_UINT32);
+        // 与上一次绑定的布局、起始集合和集合完全相同时跳过（LayoutCache使兼容的管线共用同一布局句柄）
+        // 记录在beginRenderPass/beginRendering时清空
         void bindDescriptorSet(VkPipelineBindPoint bindPoint, VkDescriptorSet descriptorSet,
             uint32_t firstSet = 0, VkPipelineLayout layout = VK_NULL_HANDLE);
         void bindDescriptorSets(VkPipelineBindPoint bindPoint, VkPipelineLayout layout,
             uint32_t firstSet, const std::vector<VkDescriptorSet>& descriptorSets);
 
+        // 本帧临时描述符集（逐绘制/逐通道数据），帧结束后自动回收，不能单独释放
+        // 上下文没有临时分配器时抛出异常
+        VkDescriptorSet allocateTransientSet(VkDescriptorSetLayout layout);
+
         // 绘制和分发命令
         void draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0);
         void drawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0,
@@ -63,9 +148,24 @@ namespace StarryEngine {
         uint32_t getFrameIndex() const { return mFrameIndex; }
         std::shared_ptr<LogicalDevice> getLogicalDevice() const { return mDevice; }
         VkDevice getDevice() const { return mDevice->getHandle(); }
+        TransientDescriptorAllocator* getTransientDescriptors() const { return mTransientDescriptors.get(); }
     private:
         std::shared_ptr<LogicalDevice> mDevice;
         VkCommandBuffer mCommandBuffer;
         uint32_t mFrameIndex;
+        std::shared_ptr<TransientDescriptorAllocator> mTransientDescriptors;
+        bool mSkipDraws = false;  // 当前绑定的异步管线不可用
+
+        struct BoundDescriptorSets {
+            VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+            VkPipelineLayout layout = VK_NULL_HANDLE;
+            uint32_t firstSet = 0;
+            std::vector<VkDescriptorSet> sets;
+        };
+        BoundDescriptorSets mBoundDescriptorSets;
+
+        // 已绑定则返回true，否则记录本次绑定
+        bool isDescriptorSetsBound(VkPipelineBindPoint bindPoint, VkPipelineLayout layout,
+            uint32_t firstSet, const VkDescriptorSet* descriptorSets, uint32_t count);
     };
 } // namespace StarryEngine
\ No newline at end of file
@@ -1,12 +1,37 @@
 #include "RenderPass.hpp"
 #include "../vulkanCore/LogicalDevice.hpp" 
+#include "../../../utils/Hash.hpp"
+#include <mutex>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace StarryEngine {
+	namespace {
+		std::mutex sCompatibilityMutex;
+		std::unordered_map<VkRenderPass, uint64_t> sCompatibilityHashes;
+
+		void hashAttachmentRefs(Hasher& hasher, uint32_t count, const VkAttachmentReference* refs) {
+			hasher.add(count);
+			for (uint32_t i = 0; refs && i < count; ++i) {
+				hasher.add(refs[i].attachment);
+			}
+		}
+	}
+
+	uint64_t RenderPass::GetCompatibilityHash(VkRenderPass renderPass) {
+		std::lock_guard<std::mutex> lock(sCompatibilityMutex);
+		auto it = sCompatibilityHashes.find(renderPass);
+		return it != sCompatibilityHashes.end() ? it->second : 0;
+	}
+
 	RenderPass::RenderPass(std::shared_ptr<LogicalDevice> logicalDevice):mLogicalDevice(logicalDevice) {}
 
 	RenderPass::~RenderPass() {
 		if(mRenderPass != VK_NULL_HANDLE) {
+			{
+				std::lock_guard<std::mutex> lock(sCompatibilityMutex);
+				sCompatibilityHashes.erase(mRenderPass);
+			}
 			vkDestroyRenderPass(mLogicalDevice->getHandle(), mRenderPass, nullptr);
 		}
 	}
@@ -42,5 +67,30 @@ namespace StarryEngine {
 		if (vkCreateRenderPass(mLogicalDevice->getHandle(), &renderPassInfo, nullptr, &mRenderPass) != VK_SUCCESS) {
 			throw std::runtime_error("failed to create render pass!");
 		}
+
+		mCompatibilityHash = computeCompatibilityHash(subpassDescriptions);
+		std::lock_guard<std::mutex> lock(sCompatibilityMutex);
+		sCompatibilityHashes[mRenderPass] = mCompatibilityHash;
+	}
+
+	uint64_t RenderPass::computeCompatibilityHash(const std::vector<VkSubpassDescription>& subpasses) const {
+		Hasher hasher;
+		hasher.add(static_cast<uint64_t>(mAttachments.size()));
+		for (const auto& attachment : mAttachments) {
+			hasher.add(attachment.flags).add(attachment.format).add(attachment.samples);
+		}
+
+		hasher.add(static_cast<uint64_t>(subpasses.size()));
+		for (const auto& subpass : subpasses) {
+			hasher.add(subpass.flags).add(subpass.pipelineBindPoint);
+			hashAttachmentRefs(hasher, subpass.inputAttachmentCount, subpass.pInputAttachments);
+			hashAttachmentRefs(hasher, subpass.colorAttachmentCount, subpass.pColorAttachments);
+			hashAttachmentRefs(hasher, subpass.pResolveAttachments ? subpass.colorAttachmentCount : 0, subpass.pResolveAttachments);
+			hashAttachmentRefs(hasher, subpass.pDepthStencilAttachment ? 1 : 0, subpass.pDepthStencilAttachment);
+			hasher.add(subpass.preserveAttachmentCount);
+		}
+
+		hasher.add(mDependencies);
+		return hasher.get();
 	}
 }
\ No newline at end of file
@@ -24,6 +24,13 @@ namespace StarryEngine {
 
 		VkRenderPass getHandle() const { return mRenderPass; }
 
+		// 兼容性哈希：只包含附件格式/采样数、子通道附件引用和依赖（忽略load/store与布局）
+		// 兼容的渲染通道哈希相同，可以共用同一条管线
+		uint64_t getCompatibilityHash() const { return mCompatibilityHash; }
+
+		// 按句柄查询已创建渲染通道的兼容性哈希，未知句柄返回0
+		static uint64_t GetCompatibilityHash(VkRenderPass renderPass);
+
 	private:
 		std::shared_ptr<LogicalDevice> mLogicalDevice;
 
@@ -31,6 +38,9 @@ namespace StarryEngine {
 		std::vector<std::unique_ptr<Subpass>> mSubpasses{};
 		std::vector<VkAttachmentDescription> mAttachments{};
 		std::vector<VkSubpassDependency> mDependencies{};
+		uint64_t mCompatibilityHash = 0;
+
+		uint64_t computeCompatibilityHash(const std::vector<VkSubpassDescription>& subpasses) const;
 
 	};
 }
\ No newline at end of file
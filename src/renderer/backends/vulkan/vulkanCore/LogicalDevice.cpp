@@ -1,4 +1,5 @@
 #include"LogicalDevice.hpp"
+#include <type_traits>
 namespace StarryEngine {
 	LogicalDevice::LogicalDevice(const PhysicalDevice::Ptr& physicalDevice, LogicalDevice::Config config) :
 		mPhysicalDevice(physicalDevice), mConfig(config) {
@@ -17,23 +18,204 @@ namespace StarryEngine {
 			queueCreateInfos.push_back(queueCreateInfo);
 		}
 
-		VkPhysicalDeviceFeatures deviceFeatures{};
-		deviceFeatures.samplerAnisotropy = mConfig.samplerAnisotropy;
-		deviceFeatures.geometryShader = mConfig.geometryShader;
-		deviceFeatures.tessellationShader = mConfig.tessellationShader;
-		deviceFeatures.fillModeNonSolid = mConfig.fillModeNonSolid;
-		deviceFeatures.wideLines = mConfig.wideLines;
+		VkPhysicalDeviceFeatures2 deviceFeatures{};
+		deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		deviceFeatures.features.samplerAnisotropy = mConfig.samplerAnisotropy;
+		deviceFeatures.features.geometryShader = mConfig.geometryShader;
+		deviceFeatures.features.tessellationShader = mConfig.tessellationShader;
+		deviceFeatures.features.fillModeNonSolid = mConfig.fillModeNonSolid;
+		deviceFeatures.features.wideLines = mConfig.wideLines;
+
+		mEnabledExtensions = deviceExtensions;
+
+		// 可选扩展：检测扩展与功能位，都支持时才加入功能链
+		VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT gplFeatures{};
+		gplFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+		if (mConfig.graphicsPipelineLibrary &&
+			physicalDevice->isExtensionSupported(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+			physicalDevice->isExtensionSupported(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME)) {
+			VkPhysicalDeviceFeatures2 supported{};
+			supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			supported.pNext = &gplFeatures;
+			vkGetPhysicalDeviceFeatures2(physicalDevice->getHandle(), &supported);
+
+			if (gplFeatures.graphicsPipelineLibrary) {
+				VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT gplProperties{};
+				gplProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+				VkPhysicalDeviceProperties2 properties{};
+				properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+				properties.pNext = &gplProperties;
+				vkGetPhysicalDeviceProperties2(physicalDevice->getHandle(), &properties);
+
+				mEnabledExtensions.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+				mEnabledExtensions.push_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+				gplFeatures.pNext = deviceFeatures.pNext;
+				deviceFeatures.pNext = &gplFeatures;
+				mOptionalFeatures.graphicsPipelineLibrary = true;
+				mOptionalFeatures.graphicsPipelineLibraryFastLinking = gplProperties.graphicsPipelineLibraryFastLinking;
+			}
+		}
+
+		// 扩展动态状态：1.3设备上1和2（基础部分）为核心功能，否则通过扩展启用
+		const bool coreExtendedDynamicState =
+			physicalDevice->getDeviceProperties().apiVersion >= VK_API_VERSION_1_3;
+		VkPhysicalDeviceExtendedDynamicStateFeaturesEXT edsFeatures{};
+		edsFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+		VkPhysicalDeviceExtendedDynamicState2FeaturesEXT eds2Features{};
+		eds2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+		VkPhysicalDeviceExtendedDynamicState3FeaturesEXT eds3Features{};
+		eds3Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+		VkPhysicalDeviceVertexInputDynamicStateFeaturesEXT vertexInputFeatures{};
+		vertexInputFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VERTEX_INPUT_DYNAMIC_STATE_FEATURES_EXT;
+		if (mConfig.extendedDynamicState) {
+			const bool edsExtension = !coreExtendedDynamicState &&
+				physicalDevice->isExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+			const bool eds2Extension = !coreExtendedDynamicState &&
+				physicalDevice->isExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME);
+			const bool eds3Extension = physicalDevice->isExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+			const bool vertexInputExtension =
+				physicalDevice->isExtensionSupported(VK_EXT_VERTEX_INPUT_DYNAMIC_STATE_EXTENSION_NAME);
+
+			// 只查询设备支持的扩展对应的功能结构
+			VkPhysicalDeviceFeatures2 supported{};
+			supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			auto chain = [&supported](auto& features) {
+				features.pNext = supported.pNext;
+				supported.pNext = &features;
+			};
+			if (edsExtension) chain(edsFeatures);
+			if (eds2Extension) chain(eds2Features);
+			if (eds3Extension) chain(eds3Features);
+			if (vertexInputExtension) chain(vertexInputFeatures);
+			if (supported.pNext != nullptr) {
+				vkGetPhysicalDeviceFeatures2(physicalDevice->getHandle(), &supported);
+			}
+
+			// 启用时只保留用到的功能位
+			auto enable = [&deviceFeatures, this](auto& features, const char* extension) {
+				mEnabledExtensions.push_back(extension);
+				features.pNext = deviceFeatures.pNext;
+				deviceFeatures.pNext = &features;
+			};
+			mOptionalFeatures.extendedDynamicState = coreExtendedDynamicState || edsFeatures.extendedDynamicState;
+			mOptionalFeatures.extendedDynamicState2 = coreExtendedDynamicState || eds2Features.extendedDynamicState2;
+			if (edsExtension && edsFeatures.extendedDynamicState) {
+				enable(edsFeatures, VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+			}
+			if (eds2Extension && eds2Features.extendedDynamicState2) {
+				eds2Features.extendedDynamicState2LogicOp = VK_FALSE;
+				eds2Features.extendedDynamicState2PatchControlPoints = VK_FALSE;
+				enable(eds2Features, VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME);
+			}
+			if (eds3Extension) {
+				VkPhysicalDeviceExtendedDynamicState3FeaturesEXT used{};
+				used.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+				used.extendedDynamicState3PolygonMode = eds3Features.extendedDynamicState3PolygonMode;
+				used.extendedDynamicState3ColorBlendEnable = eds3Features.extendedDynamicState3ColorBlendEnable;
+				used.extendedDynamicState3ColorBlendEquation = eds3Features.extendedDynamicState3ColorBlendEquation;
+				eds3Features = used;
+				if (eds3Features.extendedDynamicState3PolygonMode || eds3Features.extendedDynamicState3ColorBlendEnable ||
+					eds3Features.extendedDynamicState3ColorBlendEquation) {
+					enable(eds3Features, VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+					mOptionalFeatures.extendedDynamicState3PolygonMode = eds3Features.extendedDynamicState3PolygonMode;
+					mOptionalFeatures.extendedDynamicState3ColorBlendEnable = eds3Features.extendedDynamicState3ColorBlendEnable;
+					mOptionalFeatures.extendedDynamicState3ColorBlendEquation = eds3Features.extendedDynamicState3ColorBlendEquation;
+				}
+			}
+			if (vertexInputExtension && vertexInputFeatures.vertexInputDynamicState) {
+				enable(vertexInputFeatures, VK_EXT_VERTEX_INPUT_DYNAMIC_STATE_EXTENSION_NAME);
+				mOptionalFeatures.vertexInputDynamicState = true;
+			}
+		}
+
+		// 管线创建反馈：没有功能位，1.3设备为核心功能
+		if (mConfig.pipelineCreationFeedback) {
+			if (coreExtendedDynamicState) {
+				mOptionalFeatures.pipelineCreationFeedback = true;
+			}
+			else if (physicalDevice->isExtensionSupported(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME)) {
+				mEnabledExtensions.push_back(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+				mOptionalFeatures.pipelineCreationFeedback = true;
+			}
+		}
+
+		// 描述符索引：1.2设备为核心功能，否则通过扩展启用；只启用无绑定资源表用到的功能位
+		VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures{};
+		descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+		const bool coreDescriptorIndexing =
+			physicalDevice->getDeviceProperties().apiVersion >= VK_API_VERSION_1_2;
+		if (mConfig.descriptorIndexing && (coreDescriptorIndexing ||
+			physicalDevice->isExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))) {
+			VkPhysicalDeviceFeatures2 supported{};
+			supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			supported.pNext = &descriptorIndexingFeatures;
+			vkGetPhysicalDeviceFeatures2(physicalDevice->getHandle(), &supported);
+
+			const auto& available = descriptorIndexingFeatures;
+			if (available.shaderSampledImageArrayNonUniformIndexing &&
+				available.shaderStorageBufferArrayNonUniformIndexing &&
+				available.descriptorBindingSampledImageUpdateAfterBind &&
+				available.descriptorBindingStorageBufferUpdateAfterBind &&
+				available.descriptorBindingUpdateUnusedWhilePending &&
+				available.descriptorBindingPartiallyBound &&
+				available.runtimeDescriptorArray) {
+				VkPhysicalDeviceDescriptorIndexingFeatures used{};
+				used.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+				used.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+				used.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+				used.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+				used.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+				used.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+				used.descriptorBindingPartiallyBound = VK_TRUE;
+				used.runtimeDescriptorArray = VK_TRUE;
+				descriptorIndexingFeatures = used;
+
+				if (!coreDescriptorIndexing) {
+					mEnabledExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+				}
+				descriptorIndexingFeatures.pNext = deviceFeatures.pNext;
+				deviceFeatures.pNext = &descriptorIndexingFeatures;
+				mOptionalFeatures.descriptorIndexing = true;
+			}
+		}
+
+		// 着色器对象：依赖动态渲染，只在1.3设备上启用（动态渲染为核心功能）
+		VkPhysicalDeviceShaderObjectFeaturesEXT shaderObjectFeatures{};
+		shaderObjectFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT;
+		VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures{};
+		dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+		if (mConfig.shaderObject && coreExtendedDynamicState &&
+			physicalDevice->isExtensionSupported(VK_EXT_SHADER_OBJECT_EXTENSION_NAME)) {
+			VkPhysicalDeviceFeatures2 supported{};
+			supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			supported.pNext = &shaderObjectFeatures;
+			shaderObjectFeatures.pNext = &dynamicRenderingFeatures;
+			vkGetPhysicalDeviceFeatures2(physicalDevice->getHandle(), &supported);
+
+			if (shaderObjectFeatures.shaderObject && dynamicRenderingFeatures.dynamicRendering) {
+				mEnabledExtensions.push_back(VK_EXT_SHADER_OBJECT_EXTENSION_NAME);
+				dynamicRenderingFeatures.pNext = deviceFeatures.pNext;
+				shaderObjectFeatures.pNext = &dynamicRenderingFeatures;
+				deviceFeatures.pNext = &shaderObjectFeatures;
+				mOptionalFeatures.shaderObject = true;
+				// 1.3设备上扩展动态状态1/2为核心功能，着色器对象路径依赖这些命令
+				mOptionalFeatures.extendedDynamicState = true;
+				mOptionalFeatures.extendedDynamicState2 = true;
+			}
+		}
+		mEnabledFeatures = deviceFeatures.features;
 
 		VkDeviceCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+		createInfo.pNext = &deviceFeatures;
 
 		createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 		createInfo.pQueueCreateInfos = queueCreateInfos.data();
 
-		createInfo.pEnabledFeatures = &deviceFeatures;
+		createInfo.pEnabledFeatures = nullptr;
 
-		createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-		createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+		createInfo.enabledExtensionCount = static_cast<uint32_t>(mEnabledExtensions.size());
+		createInfo.ppEnabledExtensionNames = mEnabledExtensions.data();
 
 		if (enableValidationLayers) {
 			createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
@@ -47,6 +229,109 @@ namespace StarryEngine {
 
 		vkGetDeviceQueue(mLogicalDevice, queueIndices.graphicsFamily.value(), 0, &mQueues.graphicsQueue);
 		vkGetDeviceQueue(mLogicalDevice, queueIndices.presentFamily.value(), 0, &mQueues.presentQueue);
+
+		loadDynamicStateCommands(coreExtendedDynamicState);
+	}
+
+	void LogicalDevice::loadDynamicStateCommands(bool coreExtendedDynamicState) {
+		auto load = [this](auto& function, const char* name) {
+			function = reinterpret_cast<std::remove_reference_t<decltype(function)>>(
+				vkGetDeviceProcAddr(mLogicalDevice, name));
+		};
+		auto& commands = mDynamicStateCommands;
+
+		if (mOptionalFeatures.extendedDynamicState) {
+			const bool core = coreExtendedDynamicState;
+			load(commands.cmdSetCullMode, core ? "vkCmdSetCullMode" : "vkCmdSetCullModeEXT");
+			load(commands.cmdSetFrontFace, core ? "vkCmdSetFrontFace" : "vkCmdSetFrontFaceEXT");
+			load(commands.cmdSetPrimitiveTopology, core ? "vkCmdSetPrimitiveTopology" : "vkCmdSetPrimitiveTopologyEXT");
+			load(commands.cmdSetDepthTestEnable, core ? "vkCmdSetDepthTestEnable" : "vkCmdSetDepthTestEnableEXT");
+			load(commands.cmdSetDepthWriteEnable, core ? "vkCmdSetDepthWriteEnable" : "vkCmdSetDepthWriteEnableEXT");
+			load(commands.cmdSetDepthCompareOp, core ? "vkCmdSetDepthCompareOp" : "vkCmdSetDepthCompareOpEXT");
+			load(commands.cmdSetDepthBoundsTestEnable,
+				core ? "vkCmdSetDepthBoundsTestEnable" : "vkCmdSetDepthBoundsTestEnableEXT");
+			load(commands.cmdSetStencilTestEnable, core ? "vkCmdSetStencilTestEnable" : "vkCmdSetStencilTestEnableEXT");
+			load(commands.cmdSetStencilOp, core ? "vkCmdSetStencilOp" : "vkCmdSetStencilOpEXT");
+		}
+		if (mOptionalFeatures.extendedDynamicState2) {
+			const bool core = coreExtendedDynamicState;
+			load(commands.cmdSetPrimitiveRestartEnable,
+				core ? "vkCmdSetPrimitiveRestartEnable" : "vkCmdSetPrimitiveRestartEnableEXT");
+			load(commands.cmdSetDepthBiasEnable, core ? "vkCmdSetDepthBiasEnable" : "vkCmdSetDepthBiasEnableEXT");
+			load(commands.cmdSetRasterizerDiscardEnable,
+				core ? "vkCmdSetRasterizerDiscardEnable" : "vkCmdSetRasterizerDiscardEnableEXT");
+		}
+		if (mOptionalFeatures.extendedDynamicState3PolygonMode) {
+			load(commands.cmdSetPolygonMode, "vkCmdSetPolygonModeEXT");
+		}
+		if (mOptionalFeatures.extendedDynamicState3ColorBlendEnable) {
+			load(commands.cmdSetColorBlendEnable, "vkCmdSetColorBlendEnableEXT");
+		}
+		if (mOptionalFeatures.extendedDynamicState3ColorBlendEquation) {
+			load(commands.cmdSetColorBlendEquation, "vkCmdSetColorBlendEquationEXT");
+		}
+		if (mOptionalFeatures.vertexInputDynamicState) {
+			load(commands.cmdSetVertexInput, "vkCmdSetVertexInputEXT");
+		}
+
+		// 着色器对象扩展自带全部所需的动态状态命令，不依赖扩展动态状态3的功能位
+		if (mOptionalFeatures.shaderObject) {
+			load(commands.cmdSetPolygonMode, "vkCmdSetPolygonModeEXT");
+			load(commands.cmdSetColorBlendEnable, "vkCmdSetColorBlendEnableEXT");
+			load(commands.cmdSetColorBlendEquation, "vkCmdSetColorBlendEquationEXT");
+			load(commands.cmdSetVertexInput, "vkCmdSetVertexInputEXT");
+			load(commands.cmdSetViewportWithCount, "vkCmdSetViewportWithCount");
+			load(commands.cmdSetScissorWithCount, "vkCmdSetScissorWithCount");
+			load(commands.cmdSetRasterizationSamples, "vkCmdSetRasterizationSamplesEXT");
+			load(commands.cmdSetSampleMask, "vkCmdSetSampleMaskEXT");
+			load(commands.cmdSetAlphaToCoverageEnable, "vkCmdSetAlphaToCoverageEnableEXT");
+			load(commands.cmdSetColorWriteMask, "vkCmdSetColorWriteMaskEXT");
+
+			load(mShaderObjectCommands.createShaders, "vkCreateShadersEXT");
+			load(mShaderObjectCommands.destroyShader, "vkDestroyShaderEXT");
+			load(mShaderObjectCommands.cmdBindShaders, "vkCmdBindShadersEXT");
+		}
+	}
+
+	bool LogicalDevice::supportsDynamicState(VkDynamicState state) const {
+		switch (state) {
+		case VK_DYNAMIC_STATE_CULL_MODE:
+		case VK_DYNAMIC_STATE_FRONT_FACE:
+		case VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY:
+		case VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE:
+		case VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE:
+		case VK_DYNAMIC_STATE_DEPTH_COMPARE_OP:
+		case VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE:
+		case VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE:
+		case VK_DYNAMIC_STATE_STENCIL_OP:
+		case VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT:
+		case VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT:
+		case VK_DYNAMIC_STATE_VERTEX_INPUT_BINDING_STRIDE:
+			return mOptionalFeatures.extendedDynamicState;
+		case VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE:
+		case VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE:
+		case VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE:
+			return mOptionalFeatures.extendedDynamicState2;
+		case VK_DYNAMIC_STATE_POLYGON_MODE_EXT:
+			return mOptionalFeatures.extendedDynamicState3PolygonMode;
+		case VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT:
+			return mOptionalFeatures.extendedDynamicState3ColorBlendEnable;
+		case VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT:
+			return mOptionalFeatures.extendedDynamicState3ColorBlendEquation;
+		case VK_DYNAMIC_STATE_VERTEX_INPUT_EXT:
+			return mOptionalFeatures.vertexInputDynamicState;
+		default:
+			return state <= VK_DYNAMIC_STATE_STENCIL_REFERENCE;
+		}
+	}
+
+	bool LogicalDevice::isExtensionEnabled(const std::string& name) const {
+		for (const char* extension : mEnabledExtensions) {
+			if (name == extension) {
+				return true;
+			}
+		}
+		return false;
 	}
 
 	LogicalDevice::~LogicalDevice() {
@@ -9,6 +9,63 @@ namespace StarryEngine {
             VkBool32 tessellationShader = VK_FALSE;
             VkBool32 fillModeNonSolid = VK_FALSE;
             VkBool32 wideLines = VK_FALSE;
+
+            // 可选扩展：设备支持时才启用，实际结果见getOptionalFeatures()
+            bool graphicsPipelineLibrary = true;
+            bool extendedDynamicState = true;  // 扩展动态状态1/2/3与动态顶点输入
+            bool shaderObject = true;          // VK_EXT_shader_object（仅1.3设备）
+            bool pipelineCreationFeedback = true;  // 管线创建反馈（1.3核心，否则通过扩展）
+            bool descriptorIndexing = true;    // 无绑定资源表所需的描述符索引（1.2核心，否则通过扩展）
+        };
+
+        // 创建时实际启用的可选功能
+        struct OptionalFeatures {
+            bool graphicsPipelineLibrary = false;
+            bool graphicsPipelineLibraryFastLinking = false;  // 快速链接不会重新编译
+            bool extendedDynamicState = false;       // 剔除、正面、拓扑、深度模板开关
+            bool extendedDynamicState2 = false;      // 图元重启、深度偏移开关、光栅化丢弃
+            bool extendedDynamicState3PolygonMode = false;
+            bool extendedDynamicState3ColorBlendEnable = false;
+            bool extendedDynamicState3ColorBlendEquation = false;
+            bool vertexInputDynamicState = false;
+            bool shaderObject = false;               // 同时启用动态渲染
+            bool pipelineCreationFeedback = false;   // 可在创建信息中链接VkPipelineCreationFeedbackCreateInfo
+            bool descriptorIndexing = false;         // 非一致索引、绑定后更新、部分绑定与运行时数组
+        };
+
+        // 扩展动态状态命令（设备为1.3时取核心入口，否则取扩展入口），不支持的为nullptr
+        struct DynamicStateCommands {
+            PFN_vkCmdSetCullMode cmdSetCullMode = nullptr;
+            PFN_vkCmdSetFrontFace cmdSetFrontFace = nullptr;
+            PFN_vkCmdSetPrimitiveTopology cmdSetPrimitiveTopology = nullptr;
+            PFN_vkCmdSetDepthTestEnable cmdSetDepthTestEnable = nullptr;
+            PFN_vkCmdSetDepthWriteEnable cmdSetDepthWriteEnable = nullptr;
+            PFN_vkCmdSetDepthCompareOp cmdSetDepthCompareOp = nullptr;
+            PFN_vkCmdSetDepthBoundsTestEnable cmdSetDepthBoundsTestEnable = nullptr;
+            PFN_vkCmdSetStencilTestEnable cmdSetStencilTestEnable = nullptr;
+            PFN_vkCmdSetStencilOp cmdSetStencilOp = nullptr;
+            PFN_vkCmdSetPrimitiveRestartEnable cmdSetPrimitiveRestartEnable = nullptr;
+            PFN_vkCmdSetDepthBiasEnable cmdSetDepthBiasEnable = nullptr;
+            PFN_vkCmdSetRasterizerDiscardEnable cmdSetRasterizerDiscardEnable = nullptr;
+            PFN_vkCmdSetPolygonModeEXT cmdSetPolygonMode = nullptr;
+            PFN_vkCmdSetColorBlendEnableEXT cmdSetColorBlendEnable = nullptr;
+            PFN_vkCmdSetColorBlendEquationEXT cmdSetColorBlendEquation = nullptr;
+            PFN_vkCmdSetVertexInputEXT cmdSetVertexInput = nullptr;
+
+            // 以下只在启用着色器对象时加载（着色器对象要求所有状态都动态设置）
+            PFN_vkCmdSetViewportWithCount cmdSetViewportWithCount = nullptr;
+            PFN_vkCmdSetScissorWithCount cmdSetScissorWithCount = nullptr;
+            PFN_vkCmdSetRasterizationSamplesEXT cmdSetRasterizationSamples = nullptr;
+            PFN_vkCmdSetSampleMaskEXT cmdSetSampleMask = nullptr;
+            PFN_vkCmdSetAlphaToCoverageEnableEXT cmdSetAlphaToCoverageEnable = nullptr;
+            PFN_vkCmdSetColorWriteMaskEXT cmdSetColorWriteMask = nullptr;
+        };
+
+        // VK_EXT_shader_object的创建与绑定命令，未启用时为nullptr
+        struct ShaderObjectCommands {
+            PFN_vkCreateShadersEXT createShaders = nullptr;
+            PFN_vkDestroyShaderEXT destroyShader = nullptr;
+            PFN_vkCmdBindShadersEXT cmdBindShaders = nullptr;
         };
 
         struct QueueHandles {
@@ -28,11 +85,28 @@ namespace StarryEngine {
         PhysicalDevice::Ptr getPhysicalDevice() const { return mPhysicalDevice; }
         VkDevice getHandle()const { return mLogicalDevice; }
         QueueHandles getQueueHandles()const { return mQueues; }
+        const OptionalFeatures& getOptionalFeatures() const { return mOptionalFeatures; }
+        bool isExtensionEnabled(const std::string& name) const;
+        const DynamicStateCommands& getDynamicStateCommands() const { return mDynamicStateCommands; }
+        const ShaderObjectCommands& getShaderObjectCommands() const { return mShaderObjectCommands; }
+
+        // 创建时启用的核心功能（着色器对象路径据此决定须绑定为空的阶段）
+        const VkPhysicalDeviceFeatures& getEnabledFeatures() const { return mEnabledFeatures; }
+
+        // 该动态状态能否在管线中声明（核心动态状态始终返回true）
+        bool supportsDynamicState(VkDynamicState state) const;
 
     private:
         Config mConfig;
         PhysicalDevice::Ptr mPhysicalDevice;
         VkDevice mLogicalDevice = VK_NULL_HANDLE;
         QueueHandles mQueues{};
+        OptionalFeatures mOptionalFeatures{};
+        std::vector<const char*> mEnabledExtensions;
+        DynamicStateCommands mDynamicStateCommands{};
+        ShaderObjectCommands mShaderObjectCommands{};
+        VkPhysicalDeviceFeatures mEnabledFeatures{};
+
+        void loadDynamicStateCommands(bool coreExtendedDynamicState);
     };
 }
@@ -5,6 +5,14 @@ namespace StarryEngine {
         : mInstance(instance), mSurface(surface) {
         mPhysicalDevice = selectPhysicalDevice();
         vkGetPhysicalDeviceProperties(mPhysicalDevice, &mProperties);
+
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(mPhysicalDevice, nullptr, &extensionCount, nullptr);
+        std::vector<VkExtensionProperties> extensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(mPhysicalDevice, nullptr, &extensionCount, extensions.data());
+        for (const auto& extension : extensions) {
+            mExtensions.insert(extension.extensionName);
+        }
     }
 
     PhysicalDevice::~PhysicalDevice() {}
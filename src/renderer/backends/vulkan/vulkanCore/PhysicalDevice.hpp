@@ -16,6 +16,9 @@ namespace StarryEngine {
         VkSurfaceKHR getSurface() const { return mSurface; }
         Instance::Ptr getInstance() { return mInstance; }
 
+        // 设备是否支持指定扩展（可选扩展在创建逻辑设备时按此检测）
+        bool isExtensionSupported(const std::string& name) const { return mExtensions.count(name) > 0; }
+
         VkFormat findSupportedFormat(const std::vector<VkFormat>& candidates,
             VkImageTiling tiling,
             VkFormatFeatureFlags features);
@@ -29,6 +32,7 @@ namespace StarryEngine {
 
         Instance::Ptr mInstance;
         VkPhysicalDeviceProperties mProperties{};
+        std::set<std::string> mExtensions;
         VkPhysicalDevice mPhysicalDevice = VK_NULL_HANDLE;
         VkSurfaceKHR mSurface = VK_NULL_HANDLE;
     };
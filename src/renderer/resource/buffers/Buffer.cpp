@@ -39,6 +39,7 @@ namespace StarryEngine {
         // 如果VMA分配器可用，使用VMA创建缓冲区
         if (sVMAAllocator != VK_NULL_HANDLE) {
             if (createBufferWithVMA(size, usage, properties, initialData)) {
+                registerBindless();
                 return;
             }
             std::cerr << "VMA buffer creation failed, falling back to traditional method" << std::endl;
@@ -148,6 +149,17 @@ namespace StarryEngine {
             vkDestroyBuffer(mLogicalDevice->getHandle(), stagingBufferHandle, nullptr);
             vkFreeMemory(mLogicalDevice->getHandle(), stagingBufferMemory, nullptr);
         }
+
+        registerBindless();
+    }
+
+    void Buffer::registerBindless() {
+        if (!(mUsage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)) {
+            return;
+        }
+        if (auto bindless = BindlessTable::find(mLogicalDevice->getHandle())) {
+            mBindlessIndex = bindless->registerStorageBuffer(mBuffer, 0, mBufferSize);
+        }
     }
 
     // VMA创建缓冲区实现
@@ -300,6 +312,12 @@ namespace StarryEngine {
     }
 
     void Buffer::cleanup() noexcept {
+        if (mBindlessIndex != BindlessTable::INVALID_INDEX) {
+            if (auto bindless = BindlessTable::find(mLogicalDevice->getHandle())) {
+                bindless->release(BindlessTable::Binding::StorageBuffer, mBindlessIndex);
+            }
+            mBindlessIndex = BindlessTable::INVALID_INDEX;
+        }
         if (mBuffer != VK_NULL_HANDLE) {
             if (sVMAAllocator != VK_NULL_HANDLE && mVmaAllocation != VK_NULL_HANDLE) {
                 vmaDestroyBuffer(sVMAAllocator, mBuffer, mVmaAllocation);
@@ -2,6 +2,7 @@
 #include "../../../base.hpp"
 #include "../../../renderer/backends/vulkan/vulkanCore/VulkanCore.hpp"
 #include "../../../renderer/backends/vulkan/renderContext/CommandPool.hpp"
+#include "../../../renderer/backends/vulkan/descriptor/BindlessTable.hpp"
 #include <stdexcept>
 #include <cstring>
 #include <memory>
@@ -37,6 +38,9 @@ namespace StarryEngine {
         VkBufferUsageFlags getUsage() const noexcept { return mUsage; }
         VkMemoryPropertyFlags getProperties() const noexcept { return mProperties; }
 
+        // 存储缓冲在无绑定资源表中的索引（非存储缓冲或设备未启用无绑定时为BindlessTable::INVALID_INDEX）
+        uint32_t getBindlessIndex() const noexcept { return mBindlessIndex; }
+
         // 核心功能（接口不变）
         virtual void cleanup() noexcept;
         void* map(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
@@ -63,6 +67,7 @@ namespace StarryEngine {
         VkBufferUsageFlags mUsage = 0;
         VkMemoryPropertyFlags mProperties = 0;
         void* mMapped = nullptr;
+        uint32_t mBindlessIndex = BindlessTable::INVALID_INDEX;
 
         // VMA相关成员
         VmaAllocation mVmaAllocation = VK_NULL_HANDLE;
@@ -73,6 +78,7 @@ namespace StarryEngine {
         // 辅助方法
         void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
         uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+        void registerBindless();
 
         // 内部VMA创建方法
         bool createBufferWithVMA(VkDeviceSize size,
@@ -0,0 +1,343 @@
+#include "ShaderCache.hpp"
+#include "../../utils/Hash.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace StarryEngine {
+    namespace fs = std::filesystem;
+
+    ShaderCache::ShaderCache(const std::string& directory, uint64_t maxBytes)
+        : mDirectory(directory), mMaxBytes(maxBytes) {
+        std::error_code ec;
+        fs::create_directories(mDirectory, ec);
+        if (ec) {
+            std::cerr << "ShaderCache: failed to create directory " << directory
+                << ": " << ec.message() << std::endl;
+        }
+        scanDirectory();
+    }
+
+    uint64_t ShaderCache::computeKey(
+        const std::string& source,
+        shaderc_shader_kind kind,
+        const std::vector<std::pair<std::string, std::string>>& macros,
+        shaderc_target_env targetEnv,
+        uint32_t envVersion,
+        shaderc_optimization_level optimizationLevel
+    ) {
+        Hasher hasher;
+        hasher.add(FILE_VERSION)
+            .add(source)
+            .add(kind)
+            .add(static_cast<uint64_t>(macros.size()));
+        for (const auto& [name, value] : macros) {
+            hasher.add(name).add(value);
+        }
+        hasher.add(targetEnv)
+            .add(envVersion)
+            .add(optimizationLevel);
+        return hasher.get();
+    }
+
+    fs::path ShaderCache::entryPath(uint64_t key) const {
+        return mDirectory / (hashToHex(key) + FILE_EXTENSION);
+    }
+
+    void ShaderCache::scanDirectory() {
+        struct Found {
+            uint64_t key;
+            uint64_t size;
+            fs::file_time_type time;
+        };
+        std::vector<Found> found;
+
+        std::error_code ec;
+        for (fs::directory_iterator it(mDirectory, ec), end; !ec && it != end; it.increment(ec)) {
+            if (!it->is_regular_file(ec)) {
+                continue;
+            }
+            const fs::path& path = it->path();
+
+            // 只清理崩溃遗留的旧临时文件，不打断其他写入者的写入-重命名
+            if (path.extension() == ".tmp") {
+                const auto writeTime = it->last_write_time(ec);
+                if (!ec && fs::file_time_type::clock::now() - writeTime > STALE_TEMP_AGE) {
+                    fs::remove(path, ec);
+                }
+                ec.clear();
+                continue;
+            }
+            if (path.extension() != FILE_EXTENSION || path.stem().string().size() != 16) {
+                continue;
+            }
+
+            uint64_t key = 0;
+            try {
+                key = std::stoull(path.stem().string(), nullptr, 16);
+            }
+            catch (const std::exception&) {
+                continue;
+            }
+            found.push_back({ key, static_cast<uint64_t>(it->file_size(ec)), it->last_write_time(ec) });
+        }
+
+        // 按最后使用时间从旧到新插入，最终链表头部是最近使用的条目
+        std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) {
+            return a.time < b.time;
+        });
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (const auto& f : found) {
+            mLru.push_front(f.key);
+            mEntries[f.key] = Entry{ f.size, mLru.begin() };
+            mTotalBytes += f.size;
+        }
+        evictLocked();
+    }
+
+    bool ShaderCache::load(uint64_t key, std::vector<uint32_t>& outSpirv,
+        std::vector<Dependency>* outDependencies, const DependencyValidator& validator) {
+        const fs::path path = entryPath(key);
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            mMisses++;
+            return false;
+        }
+
+        const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+        FileHeader header{};
+        bool valid = fileSize >= sizeof(FileHeader);
+        if (valid) {
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+            valid = file &&
+                header.magic == FILE_MAGIC &&
+                header.version == FILE_VERSION &&
+                header.key == key &&
+                header.wordCount > 0 &&
+                fileSize == sizeof(FileHeader) + header.wordCount * sizeof(uint32_t) + header.dependencyBytes;
+        }
+
+        std::vector<uint32_t> spirv;
+        std::vector<Dependency> dependencies;
+        if (valid) {
+            spirv.resize(header.wordCount);
+            file.read(reinterpret_cast<char*>(spirv.data()), header.wordCount * sizeof(uint32_t));
+            std::string dependencyBlob(header.dependencyBytes, '\0');
+            file.read(dependencyBlob.data(), dependencyBlob.size());
+            constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+            valid = file &&
+                spirv[0] == SPIRV_MAGIC &&
+                Hasher().addBytes(spirv.data(), spirv.size() * sizeof(uint32_t))
+                    .addBytes(dependencyBlob.data(), dependencyBlob.size()).get() == header.checksum &&
+                parseDependencies(dependencyBlob, dependencies);
+        }
+        file.close();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!valid) {
+            // 损坏或截断的条目：删除后按未命中处理，由调用方重新编译
+            std::cerr << "ShaderCache: discarding corrupted entry " << path.string() << std::endl;
+            mCorrupted++;
+            mMisses++;
+            eraseLocked(key);
+            return false;
+        }
+
+        if (validator && !validator(dependencies)) {
+            mStale++;
+            mMisses++;
+            return false;
+        }
+
+        if (mEntries.find(key) == mEntries.end()) {
+            // 其他进程写入的条目，补录到索引
+            mLru.push_front(key);
+            mEntries[key] = Entry{ fileSize, mLru.begin() };
+            mTotalBytes += fileSize;
+        }
+        touchLocked(key);
+
+        mHits++;
+        outSpirv = std::move(spirv);
+        if (outDependencies) {
+            *outDependencies = std::move(dependencies);
+        }
+        return true;
+    }
+
+    void ShaderCache::store(uint64_t key, const std::vector<uint32_t>& spirv,
+        const std::vector<Dependency>& dependencies) {
+        if (spirv.empty()) {
+            return;
+        }
+
+        const std::string dependencyBlob = serializeDependencies(dependencies);
+
+        FileHeader header{};
+        header.magic = FILE_MAGIC;
+        header.version = FILE_VERSION;
+        header.key = key;
+        header.wordCount = spirv.size();
+        header.checksum = Hasher().addBytes(spirv.data(), spirv.size() * sizeof(uint32_t))
+            .addBytes(dependencyBlob.data(), dependencyBlob.size()).get();
+        header.dependencyBytes = dependencyBlob.size();
+
+        const uint64_t fileSize = sizeof(FileHeader) + spirv.size() * sizeof(uint32_t) + dependencyBlob.size();
+        if (fileSize > mMaxBytes) {
+            return;
+        }
+
+        // 每个进程的每个线程使用独立的临时文件名，避免并发写同一个键时互相覆盖
+        // 线程ID在不同进程间可能相同，再混入进程启动时生成的随机数
+        static const uint64_t processNonce = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+        const fs::path finalPath = entryPath(key);
+        const uint64_t writerId = Hasher().add(processNonce)
+            .add(static_cast<uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()))).get();
+        fs::path tempPath = finalPath;
+        tempPath += "." + hashToHex(writerId) + ".tmp";
+
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                std::cerr << "ShaderCache: failed to write " << tempPath.string() << std::endl;
+                return;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(spirv.data()), spirv.size() * sizeof(uint32_t));
+            file.write(dependencyBlob.data(), dependencyBlob.size());
+            file.flush();
+            if (!file) {
+                file.close();
+                std::error_code ec;
+                fs::remove(tempPath, ec);
+                return;
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, finalPath, ec);
+        if (ec) {
+            std::cerr << "ShaderCache: failed to commit " << finalPath.string()
+                << ": " << ec.message() << std::endl;
+            fs::remove(tempPath, ec);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mEntries.find(key);
+        if (it != mEntries.end()) {
+            mTotalBytes -= it->second.size;
+            it->second.size = fileSize;
+            mTotalBytes += fileSize;
+            mLru.splice(mLru.begin(), mLru, it->second.lruIt);
+        }
+        else {
+            mLru.push_front(key);
+            mEntries[key] = Entry{ fileSize, mLru.begin() };
+            mTotalBytes += fileSize;
+        }
+        mWrites++;
+        evictLocked();
+    }
+
+    void ShaderCache::remove(uint64_t key) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        eraseLocked(key);
+    }
+
+    void ShaderCache::clear() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        while (!mLru.empty()) {
+            eraseLocked(mLru.back());
+        }
+    }
+
+    ShaderCache::Stats ShaderCache::getStats() const {
+        Stats stats;
+        stats.hits = mHits.load();
+        stats.misses = mMisses.load();
+        stats.writes = mWrites.load();
+        stats.evictions = mEvictions.load();
+        stats.corrupted = mCorrupted.load();
+        stats.stale = mStale.load();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        stats.totalBytes = mTotalBytes;
+        stats.entryCount = mEntries.size();
+        return stats;
+    }
+
+    void ShaderCache::setMaxBytes(uint64_t maxBytes) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mMaxBytes = maxBytes;
+        evictLocked();
+    }
+
+    std::string ShaderCache::serializeDependencies(const std::vector<Dependency>& dependencies) {
+        std::string blob;
+        for (const auto& dependency : dependencies) {
+            const uint32_t length = static_cast<uint32_t>(dependency.path.size());
+            blob.append(reinterpret_cast<const char*>(&dependency.contentHash), sizeof(uint64_t));
+            blob.append(reinterpret_cast<const char*>(&length), sizeof(uint32_t));
+            blob.append(dependency.path);
+        }
+        return blob;
+    }
+
+    bool ShaderCache::parseDependencies(const std::string& blob, std::vector<Dependency>& outDependencies) {
+        size_t offset = 0;
+        while (offset < blob.size()) {
+            Dependency dependency;
+            uint32_t length = 0;
+            if (blob.size() - offset < sizeof(uint64_t) + sizeof(uint32_t)) {
+                return false;
+            }
+            std::memcpy(&dependency.contentHash, blob.data() + offset, sizeof(uint64_t));
+            std::memcpy(&length, blob.data() + offset + sizeof(uint64_t), sizeof(uint32_t));
+            offset += sizeof(uint64_t) + sizeof(uint32_t);
+            if (blob.size() - offset < length) {
+                return false;
+            }
+            dependency.path.assign(blob.data() + offset, length);
+            offset += length;
+            outDependencies.push_back(std::move(dependency));
+        }
+        return true;
+    }
+
+    void ShaderCache::touchLocked(uint64_t key) {
+        auto it = mEntries.find(key);
+        if (it == mEntries.end()) {
+            return;
+        }
+        mLru.splice(mLru.begin(), mLru, it->second.lruIt);
+
+        // 用文件修改时间持久化LRU顺序，下次启动扫描时恢复
+        std::error_code ec;
+        fs::last_write_time(entryPath(key), fs::file_time_type::clock::now(), ec);
+    }
+
+    void ShaderCache::eraseLocked(uint64_t key) {
+        auto it = mEntries.find(key);
+        if (it != mEntries.end()) {
+            mTotalBytes -= it->second.size;
+            mLru.erase(it->second.lruIt);
+            mEntries.erase(it);
+        }
+        std::error_code ec;
+        fs::remove(entryPath(key), ec);
+    }
+
+    void ShaderCache::evictLocked() {
+        while (mTotalBytes > mMaxBytes && !mLru.empty()) {
+            eraseLocked(mLru.back());
+            mEvictions++;
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <shaderc/shaderc.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace StarryEngine {
+    // 基于内容寻址的磁盘SPIR-V缓存
+    // 键 = hash(源码, 着色器类型, 宏列表, 目标环境, 优化等级)
+    // #include展开的文件不在键中，条目另存依赖列表及其内容哈希，加载时校验
+    class ShaderCache {
+    public:
+        using Ptr = std::shared_ptr<ShaderCache>;
+        static Ptr create(const std::string& directory, uint64_t maxBytes = DEFAULT_MAX_BYTES) {
+            return std::make_shared<ShaderCache>(directory, maxBytes);
+        }
+
+        static constexpr uint64_t DEFAULT_MAX_BYTES = 64ull * 1024 * 1024;
+
+        struct Stats {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t writes = 0;
+            uint64_t evictions = 0;
+            uint64_t corrupted = 0;
+            uint64_t stale = 0;         // 依赖文件已变化而作废的条目
+            uint64_t totalBytes = 0;
+            size_t entryCount = 0;
+        };
+
+        // 编译时展开的依赖文件
+        struct Dependency {
+            std::string path;
+            uint64_t contentHash = 0;
+        };
+
+        // 校验依赖是否仍与当前文件一致
+        using DependencyValidator = std::function<bool(const std::vector<Dependency>&)>;
+
+        ShaderCache(const std::string& directory, uint64_t maxBytes = DEFAULT_MAX_BYTES);
+
+        // 计算缓存键
+        static uint64_t computeKey(
+            const std::string& source,
+            shaderc_shader_kind kind,
+            const std::vector<std::pair<std::string, std::string>>& macros,
+            shaderc_target_env targetEnv,
+            uint32_t envVersion,
+            shaderc_optimization_level optimizationLevel
+        );
+
+        // 命中时写入outSpirv并返回true；文件损坏时删除条目并视为未命中
+        // validator拒绝依赖列表时视为未命中（条目保留，随后由新的编译结果覆盖）
+        bool load(uint64_t key, std::vector<uint32_t>& outSpirv,
+            std::vector<Dependency>* outDependencies = nullptr,
+            const DependencyValidator& validator = nullptr);
+
+        // 原子写入：先写临时文件再重命名
+        void store(uint64_t key, const std::vector<uint32_t>& spirv,
+            const std::vector<Dependency>& dependencies = {});
+
+        void remove(uint64_t key);
+        void clear();
+
+        Stats getStats() const;
+        const std::filesystem::path& getDirectory() const { return mDirectory; }
+        uint64_t getMaxBytes() const { return mMaxBytes; }
+        void setMaxBytes(uint64_t maxBytes);
+
+    private:
+        struct Entry {
+            uint64_t size = 0;
+            std::list<uint64_t>::iterator lruIt;
+        };
+
+        struct FileHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t key;
+            uint64_t wordCount;
+            uint64_t checksum;          // 覆盖SPIR-V和依赖列表
+            uint64_t dependencyBytes;   // SPIR-V之后的依赖列表：{u64 哈希, u32 路径长度, 路径}...
+        };
+
+        static constexpr uint32_t FILE_MAGIC = 0x56505353; // "SSPV"
+        static constexpr uint32_t FILE_VERSION = 2;
+        static constexpr const char* FILE_EXTENSION = ".spvc";
+        // 超过这个时间未修改的临时文件视为崩溃遗留，较新的可能正被其他进程或线程写入
+        static constexpr std::chrono::minutes STALE_TEMP_AGE{ 10 };
+
+        std::filesystem::path entryPath(uint64_t key) const;
+        void scanDirectory();
+        void touchLocked(uint64_t key);
+        void eraseLocked(uint64_t key);
+        void evictLocked();
+
+        static std::string serializeDependencies(const std::vector<Dependency>& dependencies);
+        static bool parseDependencies(const std::string& blob, std::vector<Dependency>& outDependencies);
+
+    private:
+        std::filesystem::path mDirectory;
+        uint64_t mMaxBytes;
+
+        mutable std::mutex mMutex;
+        std::list<uint64_t> mLru;  // 头部为最近使用
+        std::unordered_map<uint64_t, Entry> mEntries;
+        uint64_t mTotalBytes = 0;
+
+        std::atomic<uint64_t> mHits{ 0 };
+        std::atomic<uint64_t> mMisses{ 0 };
+        std::atomic<uint64_t> mWrites{ 0 };
+        std::atomic<uint64_t> mEvictions{ 0 };
+        std::atomic<uint64_t> mCorrupted{ 0 };
+        std::atomic<uint64_t> mStale{ 0 };
+    };
+}
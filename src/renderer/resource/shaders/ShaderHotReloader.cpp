@@ -0,0 +1,283 @@
+#include "ShaderHotReloader.hpp"
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace StarryEngine {
+    namespace fs = std::filesystem;
+
+    ShaderHotReloader::ShaderHotReloader(const LogicalDevice::Ptr& logicalDevice)
+        : mLogicalDevice(logicalDevice) {
+        mShaderUtils = ShaderUtils::create(logicalDevice);
+    }
+
+    ShaderHotReloader::~ShaderHotReloader() {
+        stop();
+    }
+
+    void ShaderHotReloader::addWatchDirectory(const std::string& directory) {
+        std::error_code ec;
+        fs::path path = fs::weakly_canonical(directory, ec);
+        if (ec || !fs::is_directory(path, ec)) {
+            std::cerr << "ShaderHotReloader: directory not found: " << directory << std::endl;
+            return;
+        }
+        mDirectories.push_back(path);
+    }
+
+    void ShaderHotReloader::watchProgram(const ShaderProgram::Ptr& program) {
+        if (!program) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mProgramsMutex);
+        mPrograms.push_back(program);
+    }
+
+    void ShaderHotReloader::start() {
+        if (mRunning || mDirectories.empty()) {
+            return;
+        }
+
+#ifdef __linux__
+        if (!initInotify())
+#endif
+        {
+            // 轮询模式：先记录一遍现有文件的修改时间
+            std::unordered_set<std::string> ignored;
+            pollChanges(ignored);
+        }
+
+        mRunning = true;
+        mThread = std::thread([this]() { watchLoop(); });
+    }
+
+    void ShaderHotReloader::stop() {
+        mRunning = false;
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+#ifdef __linux__
+        if (mInotifyFd >= 0) {
+            close(mInotifyFd);
+            mInotifyFd = -1;
+        }
+        mWatchDescriptors.clear();
+#endif
+    }
+
+    void ShaderHotReloader::watchLoop() {
+        std::unordered_set<std::string> changed;
+        auto lastEvent = std::chrono::steady_clock::now();
+
+        while (mRunning) {
+            const size_t before = changed.size();
+            // 有待处理的变更时缩短等待，以便尽快结束去抖
+            const auto timeout = changed.empty() ? POLL_INTERVAL : DEBOUNCE_DELAY;
+
+#ifdef __linux__
+            if (mInotifyFd >= 0) {
+                pollfd pfd{ mInotifyFd, POLLIN, 0 };
+                if (::poll(&pfd, 1, static_cast<int>(timeout.count())) > 0 && (pfd.revents & POLLIN)) {
+                    readInotifyEvents(changed);
+                }
+            }
+            else
+#endif
+            {
+                std::this_thread::sleep_for(timeout);
+                pollChanges(changed);
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (changed.size() != before) {
+                lastEvent = now;
+            }
+            if (!changed.empty() && now - lastEvent >= DEBOUNCE_DELAY) {
+                recompile(changed);
+                changed.clear();
+            }
+        }
+    }
+
+    void ShaderHotReloader::pollChanges(std::unordered_set<std::string>& changed) {
+        const bool seeding = mFileTimes.empty();
+        std::error_code ec;
+        for (const auto& directory : mDirectories) {
+            for (fs::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+                if (!it->is_regular_file(ec)) {
+                    continue;
+                }
+                const std::string path = it->path().string();
+                const auto time = it->last_write_time(ec);
+                auto found = mFileTimes.find(path);
+                if (found == mFileTimes.end()) {
+                    mFileTimes.emplace(path, time);
+                    if (!seeding) {
+                        changed.insert(path);
+                    }
+                }
+                else if (found->second != time) {
+                    found->second = time;
+                    changed.insert(path);
+                }
+            }
+        }
+    }
+
+    void ShaderHotReloader::recompile(const std::unordered_set<std::string>& changedFiles) {
+        // 变更的include文件不再使用内存中的旧内容
+        if (auto resolver = ShaderUtils::GetIncludeResolver()) {
+            for (const auto& file : changedFiles) {
+                resolver->invalidate(file);
+            }
+        }
+
+        // 找出引用了变更文件的程序，顺带清理已释放的程序
+        std::vector<ShaderProgram::Ptr> affected;
+        std::string affectedFile;
+        {
+            std::lock_guard<std::mutex> lock(mProgramsMutex);
+            mPrograms.erase(std::remove_if(mPrograms.begin(), mPrograms.end(),
+                [](const std::weak_ptr<ShaderProgram>& weak) { return weak.expired(); }),
+                mPrograms.end());
+
+            for (const auto& weak : mPrograms) {
+                auto program = weak.lock();
+                if (!program) {
+                    continue;
+                }
+                for (const auto& file : changedFiles) {
+                    if (program->referencesFile(file)) {
+                        affected.push_back(program);
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (const auto& program : affected) {
+            // 主线程可能同时修改特化常量，取加锁的副本
+            const std::vector<ShaderStageDesc> descs = program->snapshotStageDescs();
+
+            std::string files;
+            for (const auto& file : changedFiles) {
+                if (program->referencesFile(file)) {
+                    files += files.empty() ? file : ", " + file;
+                }
+            }
+
+            try {
+                auto modules = mShaderUtils->loadBatch(descs);
+                std::lock_guard<std::mutex> lock(mPendingMutex);
+                mPending.push_back(PendingReload{ program, std::move(modules) });
+                std::cout << "ShaderHotReloader: recompiled " << files << std::endl;
+            }
+            catch (const std::exception& e) {
+                // 编译失败：不替换模块，旧版本继续使用
+                std::cerr << "ShaderHotReloader: failed to recompile " << files << ":\n" << e.what() << std::endl;
+                std::lock_guard<std::mutex> lock(mPendingMutex);
+                mErrors.push_back(ReloadError{ files, e.what() });
+            }
+        }
+    }
+
+    std::vector<ShaderProgram::Ptr> ShaderHotReloader::applyPendingReloads() {
+        std::vector<PendingReload> pending;
+        {
+            std::unique_lock<std::mutex> lock(mPendingMutex, std::try_to_lock);
+            if (!lock.owns_lock() || mPending.empty()) {
+                return {};
+            }
+            pending.swap(mPending);
+        }
+
+        std::vector<ShaderProgram::Ptr> updated;
+        for (auto& reload : pending) {
+            auto program = reload.program.lock();
+            if (!program) {
+                continue;
+            }
+            program->replaceModules(reload.modules);
+            if (std::find(updated.begin(), updated.end(), program) == updated.end()) {
+                updated.push_back(program);
+            }
+        }
+        return updated;
+    }
+
+    std::vector<ShaderHotReloader::ReloadError> ShaderHotReloader::takeErrors() {
+        std::lock_guard<std::mutex> lock(mPendingMutex);
+        std::vector<ReloadError> errors;
+        errors.swap(mErrors);
+        return errors;
+    }
+
+#ifdef __linux__
+    bool ShaderHotReloader::initInotify() {
+        mInotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (mInotifyFd < 0) {
+            std::cerr << "ShaderHotReloader: inotify unavailable, falling back to polling" << std::endl;
+            return false;
+        }
+
+        for (const auto& directory : mDirectories) {
+            addInotifyWatch(directory);
+            std::error_code ec;
+            for (fs::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+                if (it->is_directory(ec)) {
+                    addInotifyWatch(it->path());
+                }
+            }
+        }
+        return true;
+    }
+
+    void ShaderHotReloader::addInotifyWatch(const fs::path& directory) {
+        // 编辑器常用"写临时文件再重命名"的方式保存，因此同时关注IN_MOVED_TO
+        const int wd = inotify_add_watch(mInotifyFd, directory.c_str(),
+            IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd < 0) {
+            std::cerr << "ShaderHotReloader: failed to watch " << directory.string() << std::endl;
+            return;
+        }
+        mWatchDescriptors[wd] = directory;
+    }
+
+    void ShaderHotReloader::readInotifyEvents(std::unordered_set<std::string>& changed) {
+        alignas(inotify_event) char buffer[4096];
+        for (;;) {
+            const ssize_t length = read(mInotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break;
+            }
+
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + event->len;
+
+                auto it = mWatchDescriptors.find(event->wd);
+                if (it == mWatchDescriptors.end() || event->len == 0) {
+                    continue;
+                }
+                const fs::path path = it->second / event->name;
+
+                if (event->mask & IN_ISDIR) {
+                    // 新建的子目录也纳入监视
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        addInotifyWatch(path);
+                    }
+                    continue;
+                }
+                // IN_CREATE之后必有IN_CLOSE_WRITE，只在写完时处理
+                if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                    changed.insert(path.string());
+                }
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "ShaderProgram.hpp"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace StarryEngine {
+    // 着色器热重载：监视源码目录，后台线程重新编译受影响的ShaderProgram
+    // Linux下使用inotify，其他平台退化为按修改时间轮询
+    // 编译结果在帧边界由applyPendingReloads()交换，编译失败时保留旧模块
+    class ShaderHotReloader {
+    public:
+        using Ptr = std::shared_ptr<ShaderHotReloader>;
+        static Ptr create(const LogicalDevice::Ptr& logicalDevice) {
+            return std::make_shared<ShaderHotReloader>(logicalDevice);
+        }
+
+        struct ReloadError {
+            std::string file;
+            std::string message;
+        };
+
+        ShaderHotReloader(const LogicalDevice::Ptr& logicalDevice);
+        ~ShaderHotReloader();
+
+        ShaderHotReloader(const ShaderHotReloader&) = delete;
+        ShaderHotReloader& operator=(const ShaderHotReloader&) = delete;
+
+        // 递归监视目录（需在start()之前调用）
+        void addWatchDirectory(const std::string& directory);
+
+        // 登记需要热重载的程序（只持有弱引用）
+        void watchProgram(const ShaderProgram::Ptr& program);
+
+        void start();
+        void stop();
+        bool isRunning() const { return mRunning; }
+
+        // 在帧边界调用：交换已编译完成的模块，返回本次更新的程序
+        // 后台线程持有锁时直接返回空，不阻塞渲染循环
+        std::vector<ShaderProgram::Ptr> applyPendingReloads();
+
+        // 取走最近的编译错误
+        std::vector<ReloadError> takeErrors();
+
+    private:
+        struct PendingReload {
+            std::weak_ptr<ShaderProgram> program;
+            std::vector<ShaderModule::Ptr> modules;
+        };
+
+        void watchLoop();
+        void pollChanges(std::unordered_set<std::string>& changed);
+        void recompile(const std::unordered_set<std::string>& changedFiles);
+
+#ifdef __linux__
+        bool initInotify();
+        void addInotifyWatch(const std::filesystem::path& directory);
+        void readInotifyEvents(std::unordered_set<std::string>& changed);
+#endif
+
+    private:
+        LogicalDevice::Ptr mLogicalDevice;
+        ShaderUtils::Ptr mShaderUtils;  // 只在后台线程使用
+
+        std::vector<std::filesystem::path> mDirectories;
+
+        std::mutex mProgramsMutex;
+        std::vector<std::weak_ptr<ShaderProgram>> mPrograms;
+
+        std::mutex mPendingMutex;
+        std::vector<PendingReload> mPending;
+        std::vector<ReloadError> mErrors;
+
+        std::thread mThread;
+        std::atomic<bool> mRunning{ false };
+
+        // 连续写入合并的等待时间（编辑器保存时常触发多次事件）
+        static constexpr std::chrono::milliseconds DEBOUNCE_DELAY{ 100 };
+        static constexpr std::chrono::milliseconds POLL_INTERVAL{ 250 };
+
+#ifdef __linux__
+        int mInotifyFd = -1;
+        std::unordered_map<int, std::filesystem::path> mWatchDescriptors;
+#endif
+        // 轮询模式下记录的文件修改时间
+        std::unordered_map<std::string, std::filesystem::file_time_type> mFileTimes;
+    };
+}
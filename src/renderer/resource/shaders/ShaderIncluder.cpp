@@ -0,0 +1,192 @@
+#include "ShaderIncluder.hpp"
+#include "../../utils/Hash.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace StarryEngine {
+    namespace fs = std::filesystem;
+
+    // ==================== ShaderIncludeResolver ====================
+
+    ShaderIncludeResolver::ShaderIncludeResolver(const std::vector<std::string>& searchPaths) {
+        for (const auto& path : searchPaths) {
+            addSearchPath(path);
+        }
+    }
+
+    void ShaderIncludeResolver::addSearchPath(const std::string& directory) {
+        const fs::path normalized = normalizePath(directory);
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (std::find(mSearchPaths.begin(), mSearchPaths.end(), normalized) == mSearchPaths.end()) {
+            mSearchPaths.push_back(normalized);
+        }
+    }
+
+    std::vector<fs::path> ShaderIncludeResolver::getSearchPaths() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mSearchPaths;
+    }
+
+    uint64_t ShaderIncludeResolver::getConfigHash() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Hasher hasher;
+        hasher.add(static_cast<uint64_t>(mSearchPaths.size()));
+        for (const auto& path : mSearchPaths) {
+            hasher.add(path.generic_string());
+        }
+        return hasher.get();
+    }
+
+    std::string ShaderIncludeResolver::normalizePath(const fs::path& path) {
+        std::error_code ec;
+        fs::path normalized = fs::weakly_canonical(path, ec);
+        if (ec) {
+            normalized = fs::absolute(path, ec).lexically_normal();
+        }
+        return normalized.generic_string();
+    }
+
+    ShaderIncludeResolver::FilePtr ShaderIncludeResolver::resolve(
+        const std::string& requested, const std::string& requestingPath, bool relative) {
+        std::vector<fs::path> candidates;
+        const fs::path requestedPath(requested);
+        if (requestedPath.is_absolute()) {
+            candidates.push_back(requestedPath);
+        }
+        else {
+            if (relative && !requestingPath.empty()) {
+                candidates.push_back(fs::path(requestingPath).parent_path() / requestedPath);
+            }
+            for (const auto& directory : getSearchPaths()) {
+                candidates.push_back(directory / requestedPath);
+            }
+        }
+
+        std::error_code ec;
+        for (const auto& candidate : candidates) {
+            if (fs::is_regular_file(candidate, ec)) {
+                if (auto file = load(candidate.string())) {
+                    return file;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    ShaderIncludeResolver::FilePtr ShaderIncludeResolver::load(const std::string& path) {
+        const std::string normalized = normalizePath(path);
+
+        std::error_code ec;
+        const auto writeTime = fs::last_write_time(normalized, ec);
+        if (ec) {
+            return nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mFiles.find(normalized);
+            if (it != mFiles.end() && it->second->writeTime == writeTime) {
+                mHits++;
+                return it->second;
+            }
+        }
+
+        std::ifstream stream(normalized, std::ios::binary);
+        if (!stream) {
+            return nullptr;
+        }
+        std::stringstream buffer;
+        buffer << stream.rdbuf();
+
+        auto file = std::make_shared<File>();
+        file->path = normalized;
+        file->content = buffer.str();
+        file->contentHash = hashBytes(file->content.data(), file->content.size());
+        file->writeTime = writeTime;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mReads++;
+        mFiles[normalized] = file;
+        return file;
+    }
+
+    bool ShaderIncludeResolver::isUpToDate(const std::vector<ShaderCache::Dependency>& dependencies) {
+        for (const auto& dependency : dependencies) {
+            auto file = load(dependency.path);
+            if (!file || file->contentHash != dependency.contentHash) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void ShaderIncludeResolver::invalidate(const std::string& path) {
+        const std::string normalized = normalizePath(path);
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFiles.erase(normalized);
+    }
+
+    void ShaderIncludeResolver::clear() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFiles.clear();
+    }
+
+    ShaderIncludeResolver::Stats ShaderIncludeResolver::getStats() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return Stats{ mHits, mReads, mFiles.size() };
+    }
+
+    // ==================== ShaderIncluder ====================
+
+    ShaderIncluder::ShaderIncluder(ShaderIncludeResolver::Ptr resolver,
+        const std::string& rootName, const std::string& rootPath)
+        : mResolver(std::move(resolver)), mRootName(rootName), mRootPath(rootPath) {
+    }
+
+    shaderc_include_result* ShaderIncluder::GetInclude(
+        const char* requestedSource,
+        shaderc_include_type type,
+        const char* requestingSource,
+        size_t includeDepth) {
+        // 顶层源码的包含者名称是输入文件名；嵌套包含时是上一级解析出的绝对路径
+        const std::string requesting = requestingSource ? requestingSource : "";
+        const std::string requestingPath = (requesting == mRootName) ? mRootPath : requesting;
+
+        auto* include = new IncludeResult();
+        if (includeDepth <= MAX_INCLUDE_DEPTH) {
+            include->file = mResolver->resolve(requestedSource, requestingPath, type == shaderc_include_type_relative);
+        }
+
+        if (include->file) {
+            const auto& file = *include->file;
+            include->result.source_name = file.path.c_str();
+            include->result.source_name_length = file.path.size();
+            include->result.content = file.content.c_str();
+            include->result.content_length = file.content.size();
+
+            const bool known = std::any_of(mDependencies.begin(), mDependencies.end(),
+                [&](const ShaderCache::Dependency& dependency) { return dependency.path == file.path; });
+            if (!known) {
+                mDependencies.push_back({ file.path, file.contentHash });
+            }
+        }
+        else {
+            // 按shaderc约定：source_name为空表示失败，content为错误信息
+            include->errorMessage = includeDepth > MAX_INCLUDE_DEPTH
+                ? "Include depth exceeds " + std::to_string(MAX_INCLUDE_DEPTH) + " at '" + std::string(requestedSource) + "'"
+                : "Cannot find include file '" + std::string(requestedSource) + "'";
+            include->result.source_name = "";
+            include->result.source_name_length = 0;
+            include->result.content = include->errorMessage.c_str();
+            include->result.content_length = include->errorMessage.size();
+        }
+
+        include->result.user_data = include;
+        return &include->result;
+    }
+
+    void ShaderIncluder::ReleaseInclude(shaderc_include_result* data) {
+        delete static_cast<IncludeResult*>(data->user_data);
+    }
+}
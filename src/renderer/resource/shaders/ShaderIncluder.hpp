@@ -0,0 +1,101 @@
+#pragma once
+#include "ShaderCache.hpp"
+#include <shaderc/shaderc.hpp>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace StarryEngine {
+    // #include文件解析：按搜索路径查找，文件内容在进程内缓存
+    // 多个着色器共享的头文件每次会话只读一次，修改时间变化时自动重新读取
+    class ShaderIncludeResolver {
+    public:
+        using Ptr = std::shared_ptr<ShaderIncludeResolver>;
+        static Ptr create(const std::vector<std::string>& searchPaths = {}) {
+            return std::make_shared<ShaderIncludeResolver>(searchPaths);
+        }
+
+        struct File {
+            std::string path;       // 规范化的绝对路径（'/'分隔）
+            std::string content;
+            uint64_t contentHash = 0;
+            std::filesystem::file_time_type writeTime;
+        };
+        using FilePtr = std::shared_ptr<const File>;
+
+        struct Stats {
+            uint64_t hits = 0;      // 命中内存缓存
+            uint64_t reads = 0;     // 从磁盘读取
+            size_t cachedFiles = 0;
+        };
+
+        ShaderIncludeResolver(const std::vector<std::string>& searchPaths = {});
+
+        void addSearchPath(const std::string& directory);
+        std::vector<std::filesystem::path> getSearchPaths() const;
+
+        // 搜索路径的哈希，参与SPIR-V缓存键（搜索路径变化时同一条include可能解析到不同文件）
+        uint64_t getConfigHash() const;
+
+        // 解析include：带引号的形式先查包含者所在目录，再依次查搜索路径；找不到返回nullptr
+        // requestingPath为包含者的文件路径（字符串源码为空）
+        FilePtr resolve(const std::string& requested, const std::string& requestingPath, bool relative);
+
+        // 读取文件（带缓存）
+        FilePtr load(const std::string& path);
+
+        // 依赖是否仍与磁盘一致（用于校验SPIR-V缓存条目）
+        bool isUpToDate(const std::vector<ShaderCache::Dependency>& dependencies);
+
+        // 规范化路径，与依赖列表中的写法一致
+        static std::string normalizePath(const std::filesystem::path& path);
+
+        void invalidate(const std::string& path);
+        void clear();
+        Stats getStats() const;
+
+    private:
+        mutable std::mutex mMutex;
+        std::vector<std::filesystem::path> mSearchPaths;
+        std::unordered_map<std::string, FilePtr> mFiles;
+        uint64_t mHits = 0;
+        uint64_t mReads = 0;
+    };
+
+    // 单次编译使用的shaderc包含器，记录本次编译实际展开的全部依赖
+    class ShaderIncluder : public shaderc::CompileOptions::IncluderInterface {
+    public:
+        // 嵌套包含的最大深度，超过时按包含失败处理（防止缺少include guard的头文件互相包含）
+        static constexpr size_t MAX_INCLUDE_DEPTH = 32;
+
+        // rootName是传给shaderc的输入文件名；rootPath为源文件路径（字符串源码为空，此时只查搜索路径）
+        ShaderIncluder(ShaderIncludeResolver::Ptr resolver, const std::string& rootName, const std::string& rootPath);
+
+        shaderc_include_result* GetInclude(
+            const char* requestedSource,
+            shaderc_include_type type,
+            const char* requestingSource,
+            size_t includeDepth) override;
+
+        void ReleaseInclude(shaderc_include_result* data) override;
+
+        // 按首次包含的顺序去重
+        const std::vector<ShaderCache::Dependency>& getDependencies() const { return mDependencies; }
+
+    private:
+        // 结果与所引用的文件内容一起分配，ReleaseInclude时释放
+        struct IncludeResult {
+            shaderc_include_result result{};
+            ShaderIncludeResolver::FilePtr file;
+            std::string errorMessage;
+        };
+
+        ShaderIncludeResolver::Ptr mResolver;
+        std::string mRootName;
+        std::string mRootPath;
+        std::vector<ShaderCache::Dependency> mDependencies;
+    };
+}
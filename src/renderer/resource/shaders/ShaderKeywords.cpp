@@ -0,0 +1,140 @@
+#include "ShaderKeywords.hpp"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace StarryEngine {
+    ShaderKeywordSpace::ShaderKeywordSpace(std::vector<Axis> axes) {
+        addAxes(axes);
+    }
+
+    std::vector<ShaderKeywordSpace::Axis> ShaderKeywordSpace::parseAxes(const std::string& source) {
+        std::vector<Axis> axes;
+        std::istringstream stream(source);
+        std::string line;
+        while (std::getline(stream, line)) {
+            std::istringstream tokens(line);
+            std::string directive, pragma;
+            tokens >> directive;
+            if (directive == "#pragma") {
+                tokens >> pragma;
+            }
+            else if (directive == "#") {
+                // 允许 "# pragma keywords" 写法
+                std::string next;
+                tokens >> next;
+                if (next != "pragma") {
+                    continue;
+                }
+                tokens >> pragma;
+            }
+            if (pragma != "keywords") {
+                continue;
+            }
+
+            Axis axis;
+            std::string keyword;
+            while (tokens >> keyword) {
+                if (keyword.rfind("//", 0) == 0) {
+                    break;
+                }
+                if (std::find(axis.keywords.begin(), axis.keywords.end(), keyword) == axis.keywords.end()) {
+                    axis.keywords.push_back(keyword);
+                }
+            }
+            if (!axis.keywords.empty()) {
+                axes.push_back(std::move(axis));
+            }
+        }
+        return axes;
+    }
+
+    void ShaderKeywordSpace::addAxes(const std::vector<Axis>& axes) {
+        for (const auto& axis : axes) {
+            bool exists = std::any_of(mAxes.begin(), mAxes.end(), [&](const Axis& a) {
+                return a.keywords == axis.keywords;
+            });
+            if (!exists) {
+                mAxes.push_back(axis);
+            }
+        }
+        rebuildIndex();
+    }
+
+    void ShaderKeywordSpace::rebuildIndex() {
+        mKeywordIndex.clear();
+        for (size_t a = 0; a < mAxes.size(); ++a) {
+            for (size_t k = 0; k < mAxes[a].keywords.size(); ++k) {
+                const auto& keyword = mAxes[a].keywords[k];
+                if (keyword == "_") {
+                    continue;
+                }
+                if (mKeywordIndex.count(keyword)) {
+                    std::cerr << "ShaderKeywordSpace: keyword " << keyword
+                        << " declared on more than one axis, using the first" << std::endl;
+                    continue;
+                }
+                mKeywordIndex[keyword] = { a, k };
+            }
+        }
+    }
+
+    uint64_t ShaderKeywordSpace::getPermutationCount() const {
+        uint64_t count = 1;
+        for (const auto& axis : mAxes) {
+            count *= axis.keywords.size();
+        }
+        return count;
+    }
+
+    ShaderKeywordSpace::VariantKey ShaderKeywordSpace::computeKey(const std::vector<std::string>& keywords) const {
+        std::vector<size_t> choices(mAxes.size(), 0);
+        for (const auto& keyword : keywords) {
+            auto it = mKeywordIndex.find(keyword);
+            if (it != mKeywordIndex.end()) {
+                choices[it->second.first] = it->second.second;
+            }
+        }
+
+        VariantKey key = 0;
+        uint64_t stride = 1;
+        for (size_t a = 0; a < mAxes.size(); ++a) {
+            key += choices[a] * stride;
+            stride *= mAxes[a].keywords.size();
+        }
+        return key;
+    }
+
+    std::vector<std::pair<std::string, std::string>> ShaderKeywordSpace::getMacros(VariantKey key) const {
+        std::vector<std::pair<std::string, std::string>> macros;
+        for (const auto& axis : mAxes) {
+            const size_t size = axis.keywords.size();
+            const auto& keyword = axis.keywords[key % size];
+            key /= size;
+            if (keyword != "_") {
+                macros.emplace_back(keyword, "1");
+            }
+        }
+        return macros;
+    }
+
+    std::string ShaderKeywordSpace::keyToString(VariantKey key) const {
+        std::string result;
+        for (const auto& [name, value] : getMacros(key)) {
+            result += result.empty() ? name : "+" + name;
+        }
+        return result.empty() ? "_" : result;
+    }
+
+    std::vector<ShaderKeywordSpace::VariantKey> ShaderKeywordSpace::enumerate(
+        const std::function<bool(VariantKey)>& filter) const {
+        std::vector<VariantKey> keys;
+        const uint64_t count = getPermutationCount();
+        for (VariantKey key = 0; key < count; ++key) {
+            if (!filter || filter(key)) {
+                keys.push_back(key);
+            }
+        }
+        return keys;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace StarryEngine {
+    // 着色器关键字空间：源码中用 "#pragma keywords A B C" 声明一个轴，每个轴同时只能选一个关键字
+    // "_" 表示该轴可以不定义任何宏。排列键是各轴选择下标的混合进制编码
+    class ShaderKeywordSpace {
+    public:
+        using VariantKey = uint64_t;
+
+        struct Axis {
+            std::vector<std::string> keywords;
+        };
+
+        ShaderKeywordSpace() = default;
+        explicit ShaderKeywordSpace(std::vector<Axis> axes);
+
+        // 解析源码中的 #pragma keywords 声明
+        static std::vector<Axis> parseAxes(const std::string& source);
+
+        // 添加轴（关键字列表完全相同的轴只保留一个）
+        void addAxes(const std::vector<Axis>& axes);
+
+        const std::vector<Axis>& getAxes() const { return mAxes; }
+
+        // 排列总数
+        uint64_t getPermutationCount() const;
+
+        // 关键字列表 → 排列键；未声明的关键字被忽略，同一轴出现多个时以最后一个为准
+        VariantKey computeKey(const std::vector<std::string>& keywords) const;
+
+        // 排列键 → 宏定义列表（"_"不产生宏）
+        std::vector<std::pair<std::string, std::string>> getMacros(VariantKey key) const;
+
+        // 可读形式，如 "FOG_ON+LIGHT_SPOT"，用于日志和着色器包索引
+        std::string keyToString(VariantKey key) const;
+
+        // 枚举所有排列（filter返回false的排列被跳过）
+        std::vector<VariantKey> enumerate(const std::function<bool(VariantKey)>& filter = nullptr) const;
+
+    private:
+        std::vector<Axis> mAxes;
+        std::unordered_map<std::string, std::pair<size_t, size_t>> mKeywordIndex;  // 关键字 → (轴, 下标)
+
+        void rebuildIndex();
+    };
+}
@@ -0,0 +1,68 @@
+#include "ShaderModule.hpp"
+#include "ShaderModuleRegistry.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace StarryEngine {
+    ShaderModule::ShaderModule(const LogicalDevice::Ptr& logicalDevice,
+        std::vector<uint32_t> code,
+        uint64_t hash,
+        const std::string& debugName,
+        const std::shared_ptr<ShaderModuleRegistry>& registry)
+        : mLogicalDevice(logicalDevice), mOwnedCode(std::move(code)), mHash(hash),
+        mDebugName(debugName), mRegistry(registry) {
+        mCode = mOwnedCode;
+        createHandle();
+    }
+
+    ShaderModule::ShaderModule(const LogicalDevice::Ptr& logicalDevice,
+        std::span<const uint32_t> code,
+        std::shared_ptr<const void> codeOwner,
+        uint64_t hash,
+        const std::string& debugName,
+        const std::shared_ptr<ShaderModuleRegistry>& registry)
+        : mLogicalDevice(logicalDevice), mCodeOwner(std::move(codeOwner)), mCode(code), mHash(hash),
+        mDebugName(debugName), mRegistry(registry) {
+        createHandle();
+    }
+
+    void ShaderModule::createHandle() {
+        VkShaderModuleCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = mCode.size() * sizeof(uint32_t);
+        createInfo.pCode = mCode.data();
+
+        if (vkCreateShaderModule(mLogicalDevice->getHandle(), &createInfo, nullptr, &mShaderModule) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create shader module: " + mDebugName);
+        }
+    }
+
+    ShaderModule::~ShaderModule() {
+        if (mShaderModule != VK_NULL_HANDLE) {
+            vkDestroyShaderModule(mLogicalDevice->getHandle(), mShaderModule, nullptr);
+            mShaderModule = VK_NULL_HANDLE;
+        }
+        if (auto registry = mRegistry.lock()) {
+            registry->onModuleDestroyed(mHash);
+        }
+    }
+
+    void ShaderModule::addDependencies(const std::vector<std::string>& paths) {
+        std::lock_guard<std::mutex> lock(mDependencyMutex);
+        for (const auto& path : paths) {
+            if (std::find(mDependencies.begin(), mDependencies.end(), path) == mDependencies.end()) {
+                mDependencies.push_back(path);
+            }
+        }
+    }
+
+    std::vector<std::string> ShaderModule::getDependencies() const {
+        std::lock_guard<std::mutex> lock(mDependencyMutex);
+        return mDependencies;
+    }
+
+    bool ShaderModule::dependsOn(const std::string& normalizedPath) const {
+        std::lock_guard<std::mutex> lock(mDependencyMutex);
+        return std::find(mDependencies.begin(), mDependencies.end(), normalizedPath) != mDependencies.end();
+    }
+}
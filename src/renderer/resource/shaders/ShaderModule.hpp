@@ -0,0 +1,63 @@
+#pragma once
+#include "../../../renderer/backends/vulkan/vulkanCore/LogicalDevice.hpp"
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace StarryEngine {
+    class ShaderModuleRegistry;
+
+    // 引用计数的VkShaderModule，最后一个持有者释放时销毁模块
+    // 保留SPIR-V代码，供反射和哈希使用（可以自有，也可以引用着色器包的映射内存）
+    class ShaderModule {
+    public:
+        using Ptr = std::shared_ptr<ShaderModule>;
+
+        ShaderModule(const LogicalDevice::Ptr& logicalDevice,
+            std::vector<uint32_t> code,
+            uint64_t hash,
+            const std::string& debugName,
+            const std::shared_ptr<ShaderModuleRegistry>& registry);
+
+        // 引用外部内存中的代码，codeOwner保证内存在模块存活期间有效
+        ShaderModule(const LogicalDevice::Ptr& logicalDevice,
+            std::span<const uint32_t> code,
+            std::shared_ptr<const void> codeOwner,
+            uint64_t hash,
+            const std::string& debugName,
+            const std::shared_ptr<ShaderModuleRegistry>& registry);
+        ~ShaderModule();
+
+        ShaderModule(const ShaderModule&) = delete;
+        ShaderModule& operator=(const ShaderModule&) = delete;
+
+        VkShaderModule getHandle() const { return mShaderModule; }
+        uint64_t getHash() const { return mHash; }
+        std::span<const uint32_t> getCode() const { return mCode; }
+        const std::string& getDebugName() const { return mDebugName; }
+
+        // 编译时通过#include展开的文件（规范化绝对路径），热重载据此判断受影响的模块
+        // 相同SPIR-V的模块是共享的，依赖取各来源的并集
+        void addDependencies(const std::vector<std::string>& paths);
+        std::vector<std::string> getDependencies() const;
+        bool dependsOn(const std::string& normalizedPath) const;
+
+    private:
+        void createHandle();
+
+    private:
+        LogicalDevice::Ptr mLogicalDevice;
+        VkShaderModule mShaderModule = VK_NULL_HANDLE;
+        std::vector<uint32_t> mOwnedCode;
+        std::shared_ptr<const void> mCodeOwner;
+        std::span<const uint32_t> mCode;
+        uint64_t mHash = 0;
+        std::string mDebugName;
+        std::weak_ptr<ShaderModuleRegistry> mRegistry;
+
+        mutable std::mutex mDependencyMutex;
+        std::vector<std::string> mDependencies;
+    };
+}
@@ -0,0 +1,139 @@
+#include "ShaderModuleRegistry.hpp"
+#include "../../utils/Hash.hpp"
+
+namespace StarryEngine {
+    namespace {
+        std::mutex sRegistryMutex;
+        std::unordered_map<VkDevice, std::weak_ptr<ShaderModuleRegistry>> sRegistries;
+    }
+
+    ShaderModuleRegistry::Ptr ShaderModuleRegistry::acquire(const LogicalDevice::Ptr& logicalDevice) {
+        std::lock_guard<std::mutex> lock(sRegistryMutex);
+        auto& weak = sRegistries[logicalDevice->getHandle()];
+        if (auto registry = weak.lock()) {
+            return registry;
+        }
+        auto registry = std::make_shared<ShaderModuleRegistry>(logicalDevice);
+        weak = registry;
+        return registry;
+    }
+
+    ShaderModuleRegistry::Ptr ShaderModuleRegistry::find(VkDevice device) {
+        std::lock_guard<std::mutex> lock(sRegistryMutex);
+        auto it = sRegistries.find(device);
+        return it != sRegistries.end() ? it->second.lock() : nullptr;
+    }
+
+    ShaderModuleRegistry::ShaderModuleRegistry(const LogicalDevice::Ptr& logicalDevice)
+        : mLogicalDevice(logicalDevice), mDevice(logicalDevice->getHandle()) {
+    }
+
+    ShaderModuleRegistry::~ShaderModuleRegistry() {
+        // 设备的最后一个使用者释放后移除表项；期间已为同一设备创建了新注册表时保留
+        std::lock_guard<std::mutex> lock(sRegistryMutex);
+        auto it = sRegistries.find(mDevice);
+        if (it != sRegistries.end() && it->second.expired()) {
+            sRegistries.erase(it);
+        }
+    }
+
+    ShaderModule::Ptr ShaderModuleRegistry::getOrCreate(std::vector<uint32_t> code, const std::string& debugName) {
+        const uint64_t hash = hashBytes(code.data(), code.size() * sizeof(uint32_t));
+        const std::span<const uint32_t> view(code);
+        return getOrCreateImpl(hash, view, [&]() {
+            return std::make_shared<ShaderModule>(mLogicalDevice, std::move(code), hash, debugName, shared_from_this());
+        });
+    }
+
+    ShaderModule::Ptr ShaderModuleRegistry::getOrCreate(std::span<const uint32_t> code, uint64_t hash,
+        std::shared_ptr<const void> codeOwner, const std::string& debugName) {
+        return getOrCreateImpl(hash, code, [&]() {
+            return std::make_shared<ShaderModule>(mLogicalDevice, code, std::move(codeOwner), hash, debugName, shared_from_this());
+        });
+    }
+
+    ShaderModule::Ptr ShaderModuleRegistry::getOrCreateImpl(uint64_t hash, std::span<const uint32_t> code,
+        const std::function<ShaderModule::Ptr()>& createModule) {
+        // 在锁外释放临时强引用，避免模块析构时回调onModuleDestroyed造成死锁
+        std::vector<ShaderModule::Ptr> candidates;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mModules.find(hash);
+            if (it != mModules.end()) {
+                for (const auto& weak : it->second) {
+                    if (auto module = weak.lock()) {
+                        if (std::ranges::equal(module->getCode(), code)) {
+                            mReusedCount++;
+                            return module;
+                        }
+                        candidates.push_back(std::move(module));
+                    }
+                }
+            }
+        }
+
+        // 在锁外创建模块（vkCreateShaderModule可能较慢）
+        auto created = createModule();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto& bucket = mModules[hash];
+        // 并发创建了相同模块时保留先注册的那个
+        for (const auto& weak : bucket) {
+            if (auto module = weak.lock()) {
+                if (std::ranges::equal(module->getCode(), created->getCode())) {
+                    mReusedCount++;
+                    candidates.push_back(std::move(created));
+                    return module;
+                }
+                candidates.push_back(std::move(module));
+            }
+        }
+        bucket.push_back(created);
+        mCreatedCount++;
+        return created;
+    }
+
+    ShaderModule::Ptr ShaderModuleRegistry::find(uint64_t hash) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mModules.find(hash);
+        if (it == mModules.end()) {
+            return nullptr;
+        }
+        for (const auto& weak : it->second) {
+            if (auto module = weak.lock()) {
+                return module;
+            }
+        }
+        return nullptr;
+    }
+
+    ShaderModuleRegistry::Stats ShaderModuleRegistry::getStats() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Stats stats;
+        stats.created = mCreatedCount;
+        stats.reused = mReusedCount;
+        for (const auto& [hash, bucket] : mModules) {
+            for (const auto& weak : bucket) {
+                if (!weak.expired()) {
+                    stats.liveModules++;
+                }
+            }
+        }
+        return stats;
+    }
+
+    void ShaderModuleRegistry::onModuleDestroyed(uint64_t hash) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mModules.find(hash);
+        if (it == mModules.end()) {
+            return;
+        }
+        auto& bucket = it->second;
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+            [](const std::weak_ptr<ShaderModule>& weak) { return weak.expired(); }),
+            bucket.end());
+        if (bucket.empty()) {
+            mModules.erase(it);
+        }
+    }
+}
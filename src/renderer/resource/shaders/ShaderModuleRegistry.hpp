@@ -0,0 +1,59 @@
+#pragma once
+#include "ShaderModule.hpp"
+#include <mutex>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+namespace StarryEngine {
+    // 设备级着色器模块注册表：以SPIR-V哈希为键，相同代码只创建一个VkShaderModule
+    // 注册表只持有弱引用，模块的生命周期由使用者（ShaderProgram等）决定
+    class ShaderModuleRegistry : public std::enable_shared_from_this<ShaderModuleRegistry> {
+    public:
+        using Ptr = std::shared_ptr<ShaderModuleRegistry>;
+
+        struct Stats {
+            uint64_t created = 0;   // 实际创建的模块数
+            uint64_t reused = 0;    // 命中已有模块的次数
+            size_t liveModules = 0; // 当前存活的模块数
+        };
+
+        // 获取设备对应的注册表（同一设备返回同一实例）
+        static Ptr acquire(const LogicalDevice::Ptr& logicalDevice);
+
+        // 查找设备已有的注册表，不存在时返回nullptr（不会创建）
+        static Ptr find(VkDevice device);
+
+        ShaderModuleRegistry(const LogicalDevice::Ptr& logicalDevice);
+        ~ShaderModuleRegistry();
+
+        // 返回已有模块或创建新模块（线程安全）
+        ShaderModule::Ptr getOrCreate(std::vector<uint32_t> code, const std::string& debugName = "");
+
+        // 直接使用外部内存中的代码（如着色器包的映射区域），hash需与hashBytes结果一致
+        ShaderModule::Ptr getOrCreate(std::span<const uint32_t> code, uint64_t hash,
+            std::shared_ptr<const void> codeOwner, const std::string& debugName = "");
+
+        // 按SPIR-V哈希查找存活的模块
+        ShaderModule::Ptr find(uint64_t hash) const;
+
+        Stats getStats() const;
+
+    private:
+        friend class ShaderModule;
+        void onModuleDestroyed(uint64_t hash);
+
+        ShaderModule::Ptr getOrCreateImpl(uint64_t hash, std::span<const uint32_t> code,
+            const std::function<ShaderModule::Ptr()>& createModule);
+
+    private:
+        LogicalDevice::Ptr mLogicalDevice;
+        VkDevice mDevice;
+
+        mutable std::mutex mMutex;
+        // 同一哈希下可能有多个条目（哈希碰撞时按代码内容区分）
+        std::unordered_map<uint64_t, std::vector<std::weak_ptr<ShaderModule>>> mModules;
+        uint64_t mCreatedCount = 0;
+        uint64_t mReusedCount = 0;
+    };
+}
@@ -0,0 +1,97 @@
+#include "ShaderObject.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace StarryEngine {
+    namespace {
+        // 图形阶段的固定顺序，用于计算每个阶段的nextStage
+        const VkShaderStageFlagBits kGraphicsStageOrder[] = {
+            VK_SHADER_STAGE_VERTEX_BIT,
+            VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
+            VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT,
+            VK_SHADER_STAGE_GEOMETRY_BIT,
+            VK_SHADER_STAGE_FRAGMENT_BIT
+        };
+
+        VkShaderStageFlags getLaterStages(VkShaderStageFlagBits stage, VkShaderStageFlags programStages) {
+            VkShaderStageFlags later = 0;
+            bool found = false;
+            for (VkShaderStageFlagBits candidate : kGraphicsStageOrder) {
+                if (found) {
+                    later |= candidate;
+                }
+                found = found || candidate == stage;
+            }
+            return later & programStages;
+        }
+    }
+
+    ShaderObject::ShaderObject(const LogicalDevice::Ptr& logicalDevice,
+        const ShaderProgram::Ptr& program,
+        const std::vector<VkDescriptorSetLayout>& setLayouts,
+        const std::vector<VkPushConstantRange>& pushConstantRanges)
+        : mLogicalDevice(logicalDevice), mProgram(program) {
+        const auto& commands = mLogicalDevice->getShaderObjectCommands();
+        if (!mLogicalDevice->getOptionalFeatures().shaderObject || commands.createShaders == nullptr) {
+            throw std::runtime_error("Shader objects are not supported by the device");
+        }
+
+        const auto& stages = mProgram->getStages();
+        const auto& modules = mProgram->getShaderModules();
+        if (stages.empty() || stages.size() != modules.size()) {
+            throw std::runtime_error("Shader program has no stages for shader objects");
+        }
+
+        VkShaderStageFlags programStages = 0;
+        for (const auto& stage : stages) {
+            programStages |= stage.stage;
+        }
+
+        // 多个阶段一起创建时链接，驱动可以跨阶段优化
+        const bool link = stages.size() > 1 && !(programStages & VK_SHADER_STAGE_COMPUTE_BIT);
+        std::vector<VkShaderCreateInfoEXT> createInfos;
+        createInfos.reserve(stages.size());
+        for (size_t i = 0; i < stages.size(); ++i) {
+            auto code = modules[i]->getCode();
+
+            VkShaderCreateInfoEXT createInfo{};
+            createInfo.sType = VK_STRUCTURE_TYPE_SHADER_CREATE_INFO_EXT;
+            createInfo.flags = link ? VK_SHADER_CREATE_LINK_STAGE_BIT_EXT : 0;
+            createInfo.stage = stages[i].stage;
+            createInfo.nextStage = getLaterStages(stages[i].stage, programStages);
+            createInfo.codeType = VK_SHADER_CODE_TYPE_SPIRV_EXT;
+            createInfo.codeSize = code.size_bytes();
+            createInfo.pCode = code.data();
+            createInfo.pName = stages[i].pName;
+            createInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+            createInfo.pSetLayouts = setLayouts.empty() ? nullptr : setLayouts.data();
+            createInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+            createInfo.pPushConstantRanges = pushConstantRanges.empty() ? nullptr : pushConstantRanges.data();
+            createInfo.pSpecializationInfo = stages[i].pSpecializationInfo;
+            createInfos.push_back(createInfo);
+            mStages.push_back(stages[i].stage);
+        }
+
+        mShaders.resize(createInfos.size(), VK_NULL_HANDLE);
+        VkResult result = commands.createShaders(mLogicalDevice->getHandle(),
+            static_cast<uint32_t>(createInfos.size()), createInfos.data(), nullptr, mShaders.data());
+        if (result != VK_SUCCESS) {
+            // 部分失败时已创建的对象仍需销毁
+            for (VkShaderEXT shader : mShaders) {
+                if (shader != VK_NULL_HANDLE) {
+                    commands.destroyShader(mLogicalDevice->getHandle(), shader, nullptr);
+                }
+            }
+            mShaders.clear();
+            throw std::runtime_error("Failed to create shader objects: VkResult = " + std::to_string(result));
+        }
+    }
+
+    ShaderObject::~ShaderObject() {
+        const auto& commands = mLogicalDevice->getShaderObjectCommands();
+        for (VkShaderEXT shader : mShaders) {
+            commands.destroyShader(mLogicalDevice->getHandle(), shader, nullptr);
+        }
+        mShaders.clear();
+    }
+}
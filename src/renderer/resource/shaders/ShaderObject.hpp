@@ -0,0 +1,41 @@
+#pragma once
+#include "ShaderProgram.hpp"
+#include <memory>
+#include <vector>
+
+namespace StarryEngine {
+    // 由ShaderProgram的各阶段创建的VkShaderEXT（VK_EXT_shader_object）
+    // 多个阶段一起创建并链接，不需要编译管线；所有管线状态在录制时动态设置
+    class ShaderObject {
+    public:
+        using Ptr = std::shared_ptr<ShaderObject>;
+
+        // 设备未启用着色器对象时抛出异常
+        // setLayouts与pushConstantRanges须与绘制时绑定描述符所用的管线布局一致
+        static Ptr create(const LogicalDevice::Ptr& logicalDevice,
+            const ShaderProgram::Ptr& program,
+            const std::vector<VkDescriptorSetLayout>& setLayouts,
+            const std::vector<VkPushConstantRange>& pushConstantRanges = {}) {
+            return std::make_shared<ShaderObject>(logicalDevice, program, setLayouts, pushConstantRanges);
+        }
+
+        ShaderObject(const LogicalDevice::Ptr& logicalDevice,
+            const ShaderProgram::Ptr& program,
+            const std::vector<VkDescriptorSetLayout>& setLayouts,
+            const std::vector<VkPushConstantRange>& pushConstantRanges);
+        ~ShaderObject();
+
+        ShaderObject(const ShaderObject&) = delete;
+        ShaderObject& operator=(const ShaderObject&) = delete;
+
+        // 与getShaders()一一对应
+        const std::vector<VkShaderStageFlagBits>& getStages() const { return mStages; }
+        const std::vector<VkShaderEXT>& getShaders() const { return mShaders; }
+
+    private:
+        LogicalDevice::Ptr mLogicalDevice;
+        ShaderProgram::Ptr mProgram;  // 持有程序，特化常量和入口名在创建期间有效
+        std::vector<VkShaderStageFlagBits> mStages;
+        std::vector<VkShaderEXT> mShaders;
+    };
+}
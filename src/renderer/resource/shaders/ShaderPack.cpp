@@ -0,0 +1,412 @@
+#include "ShaderPack.hpp"
+#include "../../utils/Hash.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace StarryEngine {
+    namespace fs = std::filesystem;
+
+    // ==================== ShaderPack ====================
+
+    ShaderPack::Ptr ShaderPack::open(const std::string& path, const std::string& sourceRoot) {
+        auto pack = std::make_shared<ShaderPack>(path, sourceRoot);
+        if (!pack->map()) {
+            return nullptr;
+        }
+        if (!pack->validate()) {
+            std::cerr << "ShaderPack: invalid or outdated pack " << path << std::endl;
+            return nullptr;
+        }
+        return pack;
+    }
+
+    ShaderPack::ShaderPack(const std::string& path, const std::string& sourceRoot)
+        : mPath(path) {
+        std::error_code ec;
+        mPackTime = fs::last_write_time(path, ec);
+        if (!sourceRoot.empty()) {
+            mSourceRoot = fs::weakly_canonical(sourceRoot, ec);
+            if (ec) {
+                mSourceRoot = fs::path(sourceRoot).lexically_normal();
+            }
+        }
+    }
+
+    ShaderPack::~ShaderPack() {
+        unmap();
+    }
+
+#ifdef _WIN32
+    bool ShaderPack::map() {
+        HANDLE file = CreateFileA(mPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        mFileHandle = file;
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            unmap();
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            unmap();
+            return false;
+        }
+        mMappingHandle = mapping;
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            unmap();
+            return false;
+        }
+        mData = static_cast<const uint8_t*>(view);
+        mSize = static_cast<size_t>(size.QuadPart);
+        return true;
+    }
+
+    void ShaderPack::unmap() {
+        if (mData) {
+            UnmapViewOfFile(mData);
+            mData = nullptr;
+        }
+        if (mMappingHandle) {
+            CloseHandle(static_cast<HANDLE>(mMappingHandle));
+            mMappingHandle = nullptr;
+        }
+        if (mFileHandle) {
+            CloseHandle(static_cast<HANDLE>(mFileHandle));
+            mFileHandle = nullptr;
+        }
+        mSize = 0;
+    }
+#else
+    bool ShaderPack::map() {
+        const int fd = ::open(mPath.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        mFileDescriptor = fd;
+
+        struct stat info {};
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            unmap();
+            return false;
+        }
+
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            std::cerr << "ShaderPack: mmap failed for " << mPath << std::endl;
+            unmap();
+            return false;
+        }
+        mData = static_cast<const uint8_t*>(data);
+        mSize = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void ShaderPack::unmap() {
+        if (mData) {
+            munmap(const_cast<uint8_t*>(mData), mSize);
+            mData = nullptr;
+        }
+        if (mFileDescriptor >= 0) {
+            ::close(mFileDescriptor);
+            mFileDescriptor = -1;
+        }
+        mSize = 0;
+    }
+#endif
+
+    bool ShaderPack::validate() {
+        if (mSize < sizeof(FileHeader)) {
+            return false;
+        }
+
+        FileHeader header{};
+        std::memcpy(&header, mData, sizeof(header));
+        if (header.magic != FILE_MAGIC || header.version != FILE_VERSION ||
+            header.alignment != ALIGNMENT || header.fileSize != mSize) {
+            return false;
+        }
+
+        const uint64_t indexBytes = static_cast<uint64_t>(header.entryCount) * sizeof(FileEntry);
+        if (header.indexOffset % alignof(FileEntry) != 0 ||
+            header.indexOffset + indexBytes > mSize ||
+            header.stringsOffset + header.stringsSize > mSize) {
+            return false;
+        }
+
+        // 逐条检查边界，之后的查找无需再做检查
+        const auto* entries = reinterpret_cast<const FileEntry*>(mData + header.indexOffset);
+        for (uint32_t i = 0; i < header.entryCount; ++i) {
+            const FileEntry& entry = entries[i];
+            if (entry.offset % ALIGNMENT != 0 ||
+                entry.size == 0 || entry.size % sizeof(uint32_t) != 0 ||
+                entry.offset + entry.size > mSize ||
+                static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > header.stringsSize ||
+                static_cast<uint64_t>(entry.variantOffset) + entry.variantLength > header.stringsSize ||
+                static_cast<uint64_t>(entry.dependencyOffset) + entry.dependencyLength > header.stringsSize) {
+                return false;
+            }
+            if (i > 0 && entries[i - 1].lookupHash > entry.lookupHash) {
+                return false;
+            }
+        }
+
+        mEntries = entries;
+        mEntryCount = header.entryCount;
+        mStrings = reinterpret_cast<const char*>(mData + header.stringsOffset);
+        return true;
+    }
+
+    ShaderPack::Entry ShaderPack::toEntry(const FileEntry& fileEntry) const {
+        Entry entry;
+        entry.name = std::string_view(mStrings + fileEntry.nameOffset, fileEntry.nameLength);
+        entry.variant = std::string_view(mStrings + fileEntry.variantOffset, fileEntry.variantLength);
+        entry.stage = static_cast<VkShaderStageFlagBits>(fileEntry.stage);
+        entry.contentHash = fileEntry.contentHash;
+        entry.dependencies = std::string_view(mStrings + fileEntry.dependencyOffset, fileEntry.dependencyLength);
+        entry.code = std::span<const uint32_t>(
+            reinterpret_cast<const uint32_t*>(mData + fileEntry.offset),
+            static_cast<size_t>(fileEntry.size / sizeof(uint32_t)));
+        return entry;
+    }
+
+    std::optional<ShaderPack::Entry> ShaderPack::find(std::string_view name, std::string_view variant) const {
+        const uint64_t lookupHash = makeLookupHash(name, variant);
+        const FileEntry* begin = mEntries;
+        const FileEntry* end = mEntries + mEntryCount;
+        auto it = std::lower_bound(begin, end, lookupHash, [](const FileEntry& entry, uint64_t hash) {
+            return entry.lookupHash < hash;
+        });
+
+        // 哈希相同时再比较字符串，排除冲突
+        for (; it != end && it->lookupHash == lookupHash; ++it) {
+            Entry entry = toEntry(*it);
+            if (entry.name == name && entry.variant == variant) {
+                return entry;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<ShaderPack::Entry> ShaderPack::findSource(const std::string& filename,
+        const std::vector<std::pair<std::string, std::string>>& macros) const {
+        if (mEntryCount == 0) {
+            return std::nullopt;
+        }
+
+        std::error_code ec;
+        const auto sourceTime = fs::last_write_time(filename, ec);
+        if (!ec && sourceTime > mPackTime) {
+            return std::nullopt;
+        }
+
+        fs::path relative = fs::path(filename).lexically_normal();
+        if (!mSourceRoot.empty()) {
+            const fs::path absolute = fs::weakly_canonical(filename, ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            relative = absolute.lexically_relative(mSourceRoot);
+            if (relative.empty() || *relative.begin() == "..") {
+                return std::nullopt;
+            }
+        }
+
+        auto entry = find(relative.generic_string(), makeVariantName(macros));
+        if (entry && !mSourceRoot.empty()) {
+            // include文件修改过时同样视为过期
+            std::string_view remaining = entry->dependencies;
+            while (!remaining.empty()) {
+                const size_t split = remaining.find('\n');
+                if (isStale(std::string(remaining.substr(0, split)))) {
+                    return std::nullopt;
+                }
+                remaining = split == std::string_view::npos ? std::string_view() : remaining.substr(split + 1);
+            }
+        }
+        return entry;
+    }
+
+    bool ShaderPack::isStale(const fs::path& relativePath) const {
+        std::error_code ec;
+        const auto time = fs::last_write_time(mSourceRoot / relativePath, ec);
+        return !ec && time > mPackTime;
+    }
+
+    std::vector<std::string> ShaderPack::resolveDependencies(const Entry& entry) const {
+        std::vector<std::string> paths;
+        if (mSourceRoot.empty()) {
+            return paths;
+        }
+        std::string_view remaining = entry.dependencies;
+        while (!remaining.empty()) {
+            const size_t split = remaining.find('\n');
+            const fs::path path = (mSourceRoot / std::string(remaining.substr(0, split))).lexically_normal();
+            paths.push_back(path.generic_string());
+            remaining = split == std::string_view::npos ? std::string_view() : remaining.substr(split + 1);
+        }
+        return paths;
+    }
+
+    std::vector<ShaderPack::Entry> ShaderPack::getEntries() const {
+        std::vector<Entry> entries;
+        entries.reserve(mEntryCount);
+        for (size_t i = 0; i < mEntryCount; ++i) {
+            entries.push_back(toEntry(mEntries[i]));
+        }
+        return entries;
+    }
+
+    std::string ShaderPack::makeVariantName(const std::vector<std::pair<std::string, std::string>>& macros) {
+        std::vector<std::string> parts;
+        parts.reserve(macros.size());
+        for (const auto& [name, value] : macros) {
+            parts.push_back(value == "1" ? name : name + "=" + value);
+        }
+        std::sort(parts.begin(), parts.end());
+        parts.erase(std::unique(parts.begin(), parts.end()), parts.end());
+
+        std::string result;
+        for (const auto& part : parts) {
+            result += result.empty() ? part : "+" + part;
+        }
+        return result.empty() ? "_" : result;
+    }
+
+    uint64_t ShaderPack::makeLookupHash(std::string_view name, std::string_view variant) {
+        return Hasher().add(name).add(variant).get();
+    }
+
+    // ==================== ShaderPackWriter ====================
+
+    void ShaderPackWriter::add(const std::string& name, const std::string& variant,
+        VkShaderStageFlagBits stage, std::vector<uint32_t> spirv,
+        const std::vector<std::string>& dependencies) {
+        std::string joined;
+        for (const auto& dependency : dependencies) {
+            joined += joined.empty() ? dependency : "\n" + dependency;
+        }
+        mEntries.push_back({ name, variant, stage, std::move(spirv), std::move(joined) });
+    }
+
+    bool ShaderPackWriter::write(const std::string& path) const {
+        using FileHeader = ShaderPack::FileHeader;
+        using FileEntry = ShaderPack::FileEntry;
+        constexpr uint64_t alignment = ShaderPack::ALIGNMENT;
+        auto alignUp = [](uint64_t value) { return (value + alignment - 1) / alignment * alignment; };
+
+        // 字符串表
+        std::string strings;
+        std::vector<FileEntry> index(mEntries.size());
+        for (size_t i = 0; i < mEntries.size(); ++i) {
+            const auto& pending = mEntries[i];
+            FileEntry& entry = index[i];
+            entry.lookupHash = ShaderPack::makeLookupHash(pending.name, pending.variant);
+            entry.contentHash = hashBytes(pending.spirv.data(), pending.spirv.size() * sizeof(uint32_t));
+            entry.size = pending.spirv.size() * sizeof(uint32_t);
+            entry.nameOffset = static_cast<uint32_t>(strings.size());
+            entry.nameLength = static_cast<uint32_t>(pending.name.size());
+            strings += pending.name;
+            entry.variantOffset = static_cast<uint32_t>(strings.size());
+            entry.variantLength = static_cast<uint32_t>(pending.variant.size());
+            strings += pending.variant;
+            entry.dependencyOffset = static_cast<uint32_t>(strings.size());
+            entry.dependencyLength = static_cast<uint32_t>(pending.dependencies.size());
+            strings += pending.dependencies;
+            entry.stage = static_cast<uint32_t>(pending.stage);
+            entry.reserved = 0;
+        }
+
+        FileHeader header{};
+        header.magic = ShaderPack::FILE_MAGIC;
+        header.version = ShaderPack::FILE_VERSION;
+        header.entryCount = static_cast<uint32_t>(mEntries.size());
+        header.alignment = ShaderPack::ALIGNMENT;
+        header.indexOffset = sizeof(FileHeader);
+        header.stringsOffset = header.indexOffset + index.size() * sizeof(FileEntry);
+        header.stringsSize = strings.size();
+
+        // 数据区：每个SPIR-V按ALIGNMENT对齐
+        uint64_t offset = alignUp(header.stringsOffset + header.stringsSize);
+        for (auto& entry : index) {
+            entry.offset = offset;
+            offset = alignUp(offset + entry.size);
+        }
+        header.fileSize = offset;
+
+        // 索引按查找哈希排序（数据区保持添加顺序）
+        std::vector<size_t> order(index.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return index[a].lookupHash < index[b].lookupHash;
+        });
+
+        const fs::path target(path);
+        const fs::path temp = target.string() + ".tmp";
+        std::error_code ec;
+        if (target.has_parent_path()) {
+            fs::create_directories(target.parent_path(), ec);
+        }
+
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                std::cerr << "ShaderPackWriter: failed to open " << temp.string() << std::endl;
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (size_t i : order) {
+                file.write(reinterpret_cast<const char*>(&index[i]), sizeof(FileEntry));
+            }
+            file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+            static const char padding[ShaderPack::ALIGNMENT] = {};
+            uint64_t written = header.stringsOffset + header.stringsSize;
+            for (size_t i = 0; i < mEntries.size(); ++i) {
+                file.write(padding, static_cast<std::streamsize>(index[i].offset - written));
+                file.write(reinterpret_cast<const char*>(mEntries[i].spirv.data()),
+                    static_cast<std::streamsize>(index[i].size));
+                written = index[i].offset + index[i].size;
+            }
+            file.write(padding, static_cast<std::streamsize>(header.fileSize - written));
+
+            if (!file) {
+                std::cerr << "ShaderPackWriter: failed to write " << temp.string() << std::endl;
+                file.close();
+                fs::remove(temp, ec);
+                return false;
+            }
+        }
+
+        fs::rename(temp, target, ec);
+        if (ec) {
+            std::cerr << "ShaderPackWriter: failed to replace " << path << ": " << ec.message() << std::endl;
+            fs::remove(temp, ec);
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace StarryEngine {
+    // 离线编译的着色器包（由starry_shaderc生成）
+    // 布局：文件头 | 按查找哈希排序的索引 | 名称字符串表 | 按ALIGNMENT对齐的SPIR-V数据
+    // 运行时整体内存映射，模块直接从映射内存创建，不经过shaderc和文件拷贝
+    class ShaderPack {
+    public:
+        using Ptr = std::shared_ptr<ShaderPack>;
+
+        struct Entry {
+            std::string_view name;      // 相对着色器根目录的路径，如 "core/shader.vert"
+            std::string_view variant;   // 规范化的宏组合，见makeVariantName
+            VkShaderStageFlagBits stage = VK_SHADER_STAGE_VERTEX_BIT;
+            uint64_t contentHash = 0;   // 与hashBytes(SPIR-V)一致，可直接作为模块注册表的键
+            std::span<const uint32_t> code;
+            std::string_view dependencies;  // 编译时展开的include文件，相对着色器根目录，'\n'分隔
+        };
+
+        // 映射包文件；sourceRoot用于把运行时的源文件路径换算成包内名称
+        // 文件不存在或格式无效时返回nullptr
+        static Ptr open(const std::string& path, const std::string& sourceRoot = "");
+
+        ShaderPack(const ShaderPack&) = delete;
+        ShaderPack& operator=(const ShaderPack&) = delete;
+        ~ShaderPack();
+
+        std::optional<Entry> find(std::string_view name, std::string_view variant) const;
+
+        // 按源文件路径和宏列表查找（宏顺序无关）
+        // 源文件或其include依赖存在且比包新时视为过期（例如热重载编辑过的文件），返回空以回退到运行时编译
+        std::optional<Entry> findSource(const std::string& filename,
+            const std::vector<std::pair<std::string, std::string>>& macros) const;
+
+        // 条目依赖的规范化绝对路径（需要sourceRoot）
+        std::vector<std::string> resolveDependencies(const Entry& entry) const;
+
+        size_t getEntryCount() const { return mEntryCount; }
+        std::vector<Entry> getEntries() const;
+        const std::string& getPath() const { return mPath; }
+
+        // 宏列表 → 规范化变体名：按名称排序，值为"1"时省略，用'+'连接；空列表为"_"
+        static std::string makeVariantName(const std::vector<std::pair<std::string, std::string>>& macros);
+
+        // 索引使用的查找哈希
+        static uint64_t makeLookupHash(std::string_view name, std::string_view variant);
+
+        static constexpr uint32_t FILE_MAGIC = 0x4B415053; // "SPAK"
+        static constexpr uint32_t FILE_VERSION = 2;
+        static constexpr uint32_t ALIGNMENT = 64;
+
+        struct FileHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t entryCount;
+            uint32_t alignment;
+            uint64_t indexOffset;
+            uint64_t stringsOffset;
+            uint64_t stringsSize;
+            uint64_t fileSize;
+        };
+
+        struct FileEntry {
+            uint64_t lookupHash;
+            uint64_t contentHash;
+            uint64_t offset;        // 数据偏移（字节，ALIGNMENT对齐）
+            uint64_t size;          // 数据大小（字节）
+            uint32_t nameOffset;    // 字符串表内偏移
+            uint32_t nameLength;
+            uint32_t variantOffset;
+            uint32_t variantLength;
+            uint32_t stage;
+            uint32_t dependencyOffset;
+            uint32_t dependencyLength;
+            uint32_t reserved;
+        };
+
+        ShaderPack(const std::string& path, const std::string& sourceRoot);
+
+    private:
+        bool map();
+        void unmap();
+        bool validate();
+        Entry toEntry(const FileEntry& fileEntry) const;
+        bool isStale(const std::filesystem::path& relativePath) const;
+
+    private:
+        std::string mPath;
+        std::filesystem::path mSourceRoot;
+        std::filesystem::file_time_type mPackTime;
+
+        const uint8_t* mData = nullptr;
+        size_t mSize = 0;
+        const FileEntry* mEntries = nullptr;
+        size_t mEntryCount = 0;
+        const char* mStrings = nullptr;
+
+#ifdef _WIN32
+        void* mFileHandle = nullptr;
+        void* mMappingHandle = nullptr;
+#else
+        int mFileDescriptor = -1;
+#endif
+    };
+
+    // 着色器包写入器（离线编译工具使用）
+    class ShaderPackWriter {
+    public:
+        // dependencies为相对着色器根目录的include文件
+        void add(const std::string& name, const std::string& variant,
+            VkShaderStageFlagBits stage, std::vector<uint32_t> spirv,
+            const std::vector<std::string>& dependencies = {});
+
+        // 原子写入：先写临时文件再重命名
+        bool write(const std::string& path) const;
+
+        size_t getEntryCount() const { return mEntries.size(); }
+
+    private:
+        struct PendingEntry {
+            std::string name;
+            std::string variant;
+            VkShaderStageFlagBits stage;
+            std::vector<uint32_t> spirv;
+            std::string dependencies;
+        };
+        std::vector<PendingEntry> mEntries;
+    };
+}
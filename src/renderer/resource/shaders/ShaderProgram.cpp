@@ -1,13 +1,15 @@
 #include"ShaderProgram.hpp"
+#include <algorithm>
+#include <filesystem>
 namespace StarryEngine {
     ShaderProgram::ShaderProgram(const LogicalDevice::Ptr& logicalDevice) : mLogicalDevice(logicalDevice) {
         mShaderUtils = ShaderUtils::create(logicalDevice);
     }
 
     ShaderProgram::~ShaderProgram() {
-        for (auto module : mShaderModules) {
-            vkDestroyShaderModule(mLogicalDevice->getHandle(), module, nullptr);
-        }
+        // 模块由注册表引用计数管理，最后一个持有者释放时销毁
+        mStages.clear();
+        mShaderModules.clear();
     }
 
     // 添加GLSL着色器阶段（支持宏）
@@ -16,13 +18,14 @@ namespace StarryEngine {
         VkShaderStageFlagBits stage,
         const char* entryPoint,
         const std::vector<std::pair<std::string, std::string>>& macros,
-        const std::string& debugName
+        const std::string& debugName,
+        const ShaderSpecialization& specialization
     ) {
-        VkShaderModule module = mShaderUtils->loadFromGLSL(
+        auto module = mShaderUtils->loadFromGLSL(
             filename, stage, macros, debugName
         );
-        mShaderModules.push_back(module);
-        mStages.push_back(createStageInfo(module, stage, entryPoint));
+        addModule(module, ShaderStageDesc{ ShaderStageDesc::SourceType::GLSLFile,
+            filename, stage, entryPoint, macros, debugName, specialization });
     }
 
     // 添加预编译的SPIR-V着色器阶段
@@ -30,11 +33,12 @@ namespace StarryEngine {
         const std::string& filename,
         VkShaderStageFlagBits stage,
         const char* entryPoint,
-        const std::string& debugName
+        const std::string& debugName,
+        const ShaderSpecialization& specialization
     ) {
-        VkShaderModule module = mShaderUtils->loadFromSPV(filename, debugName);
-        mShaderModules.push_back(module);
-        mStages.push_back(createStageInfo(module, stage, entryPoint));
+        auto module = mShaderUtils->loadFromSPV(filename, debugName);
+        addModule(module, ShaderStageDesc{ ShaderStageDesc::SourceType::SPVFile,
+            filename, stage, entryPoint, {}, debugName, specialization });
     }
 
     void ShaderProgram::addGLSLStringStage(
@@ -42,19 +46,162 @@ namespace StarryEngine {
         VkShaderStageFlagBits stage,
         const char* entryPoint,
         const std::vector<std::pair<std::string, std::string>>& macros,
-        const std::string& debugName
+        const std::string& debugName,
+        const ShaderSpecialization& specialization
     ) {
-        VkShaderModule module = mShaderUtils->loadFromGLSLString(
+        auto module = mShaderUtils->loadFromGLSLString(
             sourceCode, stage, macros, debugName
         );
+        addModule(module, ShaderStageDesc{ ShaderStageDesc::SourceType::GLSLString,
+            sourceCode, stage, entryPoint, macros, debugName, specialization });
+    }
+
+    void ShaderProgram::addStages(const std::vector<ShaderStageDesc>& stages) {
+        auto modules = mShaderUtils->loadBatch(stages);
+        for (size_t i = 0; i < stages.size(); ++i) {
+            addModule(modules[i], stages[i]);
+        }
+    }
+
+    std::vector<ShaderProgram::Ptr> ShaderProgram::createBatch(
+        const LogicalDevice::Ptr& logicalDevice,
+        const std::vector<std::vector<ShaderStageDesc>>& programs
+    ) {
+        // 展平为一个批次，编译完成后再按程序拆分
+        std::vector<ShaderStageDesc> allStages;
+        for (const auto& stages : programs) {
+            allStages.insert(allStages.end(), stages.begin(), stages.end());
+        }
+
+        std::vector<Ptr> result;
+        result.reserve(programs.size());
+        for (size_t i = 0; i < programs.size(); ++i) {
+            result.push_back(create(logicalDevice));
+        }
+        if (allStages.empty()) {
+            return result;
+        }
+
+        auto modules = result.front()->mShaderUtils->loadBatch(allStages);
+
+        size_t index = 0;
+        for (size_t p = 0; p < programs.size(); ++p) {
+            for (const auto& desc : programs[p]) {
+                result[p]->addModule(modules[index++], desc);
+            }
+        }
+        return result;
+    }
+
+    void ShaderProgram::addModule(const ShaderModule::Ptr& module, const ShaderStageDesc& desc) {
+        mEntryPoints.push_back(desc.entryPoint);
         mShaderModules.push_back(module);
-        mStages.push_back(createStageInfo(module, stage, entryPoint));
+        {
+            std::lock_guard<std::mutex> lock(mStageDescMutex);
+            mStageDescs.push_back(desc);
+        }
+        mSpecializations.push_back(desc.specialization);
+        mStages.push_back(createStageInfo(module->getHandle(), desc.stage, mEntryPoints.back().c_str(),
+            mSpecializations.back().getInfo()));
+        collectDependencies();
+    }
+
+    void ShaderProgram::setSpecialization(VkShaderStageFlagBits stage, const ShaderSpecialization& specialization) {
+        bool found = false;
+        for (size_t i = 0; i < mStages.size(); ++i) {
+            if (mStages[i].stage != stage) {
+                continue;
+            }
+            mSpecializations[i] = specialization;
+            {
+                std::lock_guard<std::mutex> lock(mStageDescMutex);
+                mStageDescs[i].specialization = specialization;
+            }
+            mStages[i].pSpecializationInfo = mSpecializations[i].getInfo();
+            found = true;
+        }
+        if (!found) {
+            throw std::runtime_error("ShaderProgram::setSpecialization: program has no such stage");
+        }
+        mRevision++;
+    }
+
+    std::vector<ShaderStageDesc> ShaderProgram::snapshotStageDescs() const {
+        std::lock_guard<std::mutex> lock(mStageDescMutex);
+        return mStageDescs;
+    }
+
+    const ShaderSpecialization* ShaderProgram::getSpecialization(VkShaderStageFlagBits stage) const {
+        for (size_t i = 0; i < mStages.size(); ++i) {
+            if (mStages[i].stage == stage) {
+                return &mSpecializations[i];
+            }
+        }
+        return nullptr;
+    }
+
+    ShaderProgram::Ptr ShaderProgram::specialize(
+        const std::unordered_map<VkShaderStageFlagBits, ShaderSpecialization>& overrides) const {
+        auto program = create(mLogicalDevice);
+        for (size_t i = 0; i < mShaderModules.size(); ++i) {
+            ShaderStageDesc desc = mStageDescs[i];
+            auto it = overrides.find(desc.stage);
+            if (it != overrides.end()) {
+                desc.specialization.merge(it->second);
+            }
+            program->addModule(mShaderModules[i], desc);
+        }
+        return program;
+    }
+
+    void ShaderProgram::collectDependencies() {
+        std::vector<std::string> dependencies;
+        for (const auto& module : mShaderModules) {
+            for (auto& path : module->getDependencies()) {
+                if (std::find(dependencies.begin(), dependencies.end(), path) == dependencies.end()) {
+                    dependencies.push_back(std::move(path));
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(mDependencyMutex);
+        mDependencies = std::move(dependencies);
+    }
+
+    bool ShaderProgram::referencesFile(const std::string& path) const {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        const fs::path target = fs::weakly_canonical(path, ec);
+        for (const auto& desc : mStageDescs) {
+            if (desc.sourceType == ShaderStageDesc::SourceType::GLSLString) {
+                continue;
+            }
+            if (fs::weakly_canonical(desc.source, ec) == target) {
+                return true;
+            }
+        }
+
+        const std::string normalized = ShaderIncludeResolver::normalizePath(path);
+        std::lock_guard<std::mutex> lock(mDependencyMutex);
+        return std::find(mDependencies.begin(), mDependencies.end(), normalized) != mDependencies.end();
+    }
+
+    void ShaderProgram::replaceModules(const std::vector<ShaderModule::Ptr>& modules) {
+        if (modules.size() != mShaderModules.size()) {
+            throw std::runtime_error("ShaderProgram::replaceModules: stage count mismatch");
+        }
+        for (size_t i = 0; i < modules.size(); ++i) {
+            mShaderModules[i] = modules[i];
+            mStages[i].module = modules[i]->getHandle();
+        }
+        collectDependencies();
+        mRevision++;
     }
 
     VkPipelineShaderStageCreateInfo ShaderProgram::createStageInfo(
         VkShaderModule module,
         VkShaderStageFlagBits stage,
-        const char* entryPoint
+        const char* entryPoint,
+        const VkSpecializationInfo* specializationInfo
     ) {
         return VkPipelineShaderStageCreateInfo{
             .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
@@ -63,7 +210,7 @@ namespace StarryEngine {
             .stage = stage,
             .module = module,
             .pName = entryPoint,
-            .pSpecializationInfo = nullptr
+            .pSpecializationInfo = specializationInfo
         };
     }
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 #include "shaderUtils.hpp"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 namespace StarryEngine {
     class ShaderProgram {
     public:
@@ -13,13 +16,38 @@ namespace StarryEngine {
         ~ShaderProgram();
 
         const std::vector<VkPipelineShaderStageCreateInfo>& getStages() const { return mStages; }
+        const std::vector<ShaderModule::Ptr>& getShaderModules() const { return mShaderModules; }
+
+        // 各阶段的源描述（热重载时据此重新编译）
+        const std::vector<ShaderStageDesc>& getStageDescs() const { return mStageDescs; }
+
+        // 加锁复制的源描述，热重载线程使用（主线程可能同时修改特化常量）
+        std::vector<ShaderStageDesc> snapshotStageDescs() const;
+
+        // 是否有阶段来自指定文件或通过#include依赖该文件（按规范化路径比较）
+        // 可在热重载线程中调用
+        bool referencesFile(const std::string& path) const;
+
+        // 用重新编译的模块替换全部阶段（顺序与getStageDescs一致），只能在帧边界调用
+        void replaceModules(const std::vector<ShaderModule::Ptr>& modules);
+
+        // 每次替换模块或修改特化常量后递增
+        uint64_t getRevision() const { return mRevision; }
+
+        // 修改指定阶段的特化常量（不重新编译），之后创建的管线生效
+        void setSpecialization(VkShaderStageFlagBits stage, const ShaderSpecialization& specialization);
+        const ShaderSpecialization* getSpecialization(VkShaderStageFlagBits stage) const;
+
+        // 共享同一组模块、只替换特化常量的新程序（overrides中的常量覆盖原值）
+        Ptr specialize(const std::unordered_map<VkShaderStageFlagBits, ShaderSpecialization>& overrides) const;
 
         void addGLSLStage(
             const std::string& filename,
             VkShaderStageFlagBits stage,
             const char* entryPoint,
             const std::vector<std::pair<std::string, std::string>>& macros = {},
-            const std::string& debugName = ""
+            const std::string& debugName = "",
+            const ShaderSpecialization& specialization = {}
         );
 
         void addGLSLStringStage(
@@ -27,27 +55,50 @@ namespace StarryEngine {
             VkShaderStageFlagBits stage,
             const char* entryPoint,
             const std::vector<std::pair<std::string, std::string>>& macros = {},
-            const std::string& debugName = ""
+            const std::string& debugName = "",
+            const ShaderSpecialization& specialization = {}
         );
 
         void addSPVStage(
             const std::string& filename,
             VkShaderStageFlagBits stage,
             const char* entryPoint,
-            const std::string& debugName = ""
+            const std::string& debugName = "",
+            const ShaderSpecialization& specialization = {}
+        );
+
+        // 批量添加阶段，各阶段在工作线程池上并行编译
+        void addStages(const std::vector<ShaderStageDesc>& stages);
+
+        // 批量创建多个程序：所有程序的所有阶段合并为一次并行编译
+        static std::vector<Ptr> createBatch(
+            const LogicalDevice::Ptr& logicalDevice,
+            const std::vector<std::vector<ShaderStageDesc>>& programs
         );
 
     private:
         VkPipelineShaderStageCreateInfo createStageInfo(
             VkShaderModule module,
             VkShaderStageFlagBits stage,
-            const char* entryPoint
+            const char* entryPoint,
+            const VkSpecializationInfo* specializationInfo = nullptr
         );
 
+        void addModule(const ShaderModule::Ptr& module, const ShaderStageDesc& desc);
+        void collectDependencies();
+
     private:
         LogicalDevice::Ptr mLogicalDevice;
         ShaderUtils::Ptr mShaderUtils;
-        std::vector<VkShaderModule> mShaderModules;
+        std::vector<ShaderModule::Ptr> mShaderModules;  // 共享模块，随程序释放引用
         std::vector<VkPipelineShaderStageCreateInfo> mStages;
+        std::deque<std::string> mEntryPoints;  // pName指向此处，deque保证地址稳定
+        std::deque<ShaderSpecialization> mSpecializations;  // pSpecializationInfo指向此处
+        std::vector<ShaderStageDesc> mStageDescs;
+        mutable std::mutex mStageDescMutex;  // 保护mStageDescs的修改与snapshotStageDescs()
+        uint64_t mRevision = 0;
+
+        mutable std::mutex mDependencyMutex;
+        std::vector<std::string> mDependencies;  // 各模块include依赖的并集
     };
 }
\ No newline at end of file
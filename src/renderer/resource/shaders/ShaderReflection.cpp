@@ -0,0 +1,654 @@
+#include "ShaderReflection.hpp"
+#include "ShaderProgram.hpp"
+#include "../../utils/Hash.hpp"
+#include "../../backends/vulkan/descriptor/DescriptorManager.hpp"
+#include "../../backends/vulkan/pipeline/LayoutCache.hpp"
+#include "../../backends/vulkan/pipeline/pipelineStateComponent/VertexInputComponent.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace StarryEngine {
+    namespace {
+        // 用到的SPIR-V操作码与枚举值（见SPIR-V规范）
+        namespace spv {
+            constexpr uint32_t MAGIC = 0x07230203;
+
+            constexpr uint32_t OpName = 5;
+            constexpr uint32_t OpEntryPoint = 15;
+            constexpr uint32_t OpTypeBool = 20;
+            constexpr uint32_t OpTypeInt = 21;
+            constexpr uint32_t OpTypeFloat = 22;
+            constexpr uint32_t OpTypeVector = 23;
+            constexpr uint32_t OpTypeMatrix = 24;
+            constexpr uint32_t OpTypeImage = 25;
+            constexpr uint32_t OpTypeSampler = 26;
+            constexpr uint32_t OpTypeSampledImage = 27;
+            constexpr uint32_t OpTypeArray = 28;
+            constexpr uint32_t OpTypeRuntimeArray = 29;
+            constexpr uint32_t OpTypeStruct = 30;
+            constexpr uint32_t OpTypePointer = 32;
+            constexpr uint32_t OpConstant = 43;
+            constexpr uint32_t OpSpecConstant = 50;
+            constexpr uint32_t OpVariable = 59;
+            constexpr uint32_t OpDecorate = 71;
+            constexpr uint32_t OpMemberDecorate = 72;
+            constexpr uint32_t OpTypeAccelerationStructureKHR = 5341;
+
+            constexpr uint32_t DecorationBlock = 2;
+            constexpr uint32_t DecorationBufferBlock = 3;
+            constexpr uint32_t DecorationArrayStride = 6;
+            constexpr uint32_t DecorationMatrixStride = 7;
+            constexpr uint32_t DecorationBuiltIn = 11;
+            constexpr uint32_t DecorationLocation = 30;
+            constexpr uint32_t DecorationBinding = 33;
+            constexpr uint32_t DecorationDescriptorSet = 34;
+            constexpr uint32_t DecorationOffset = 35;
+
+            constexpr uint32_t StorageUniformConstant = 0;
+            constexpr uint32_t StorageInput = 1;
+            constexpr uint32_t StorageUniform = 2;
+            constexpr uint32_t StoragePushConstant = 9;
+            constexpr uint32_t StorageStorageBuffer = 12;
+
+            constexpr uint32_t DimBuffer = 5;
+            constexpr uint32_t DimSubpassData = 6;
+        }
+
+        struct SpirvType {
+            uint32_t opcode = 0;
+            std::vector<uint32_t> operands;  // 去掉结果ID后的操作数
+        };
+
+        struct SpirvDecorations {
+            uint32_t set = 0;
+            uint32_t binding = 0;
+            uint32_t location = 0;
+            uint32_t arrayStride = 0;
+            bool hasSet = false;
+            bool hasBinding = false;
+            bool hasLocation = false;
+            bool builtIn = false;
+            bool block = false;
+            bool bufferBlock = false;
+        };
+
+        struct SpirvMemberDecorations {
+            uint32_t offset = 0;
+            uint32_t matrixStride = 0;
+            bool builtIn = false;
+        };
+
+        struct SpirvVariable {
+            uint32_t id = 0;
+            uint32_t typeId = 0;
+            uint32_t storageClass = 0;
+        };
+
+        class SpirvModule {
+        public:
+            explicit SpirvModule(std::span<const uint32_t> code) {
+                if (code.size() < 5 || code[0] != spv::MAGIC) {
+                    throw std::runtime_error("ShaderReflection: invalid SPIR-V");
+                }
+                size_t i = 5;
+                while (i < code.size()) {
+                    const uint32_t wordCount = code[i] >> 16;
+                    const uint32_t opcode = code[i] & 0xFFFF;
+                    if (wordCount == 0 || i + wordCount > code.size()) {
+                        throw std::runtime_error("ShaderReflection: truncated SPIR-V instruction");
+                    }
+                    parseInstruction(opcode, code.data() + i + 1, wordCount - 1);
+                    i += wordCount;
+                }
+            }
+
+            VkShaderStageFlags stage = 0;
+            std::unordered_map<uint32_t, SpirvType> types;
+            std::unordered_map<uint32_t, uint32_t> constants;
+            std::unordered_map<uint32_t, std::string> names;
+            std::unordered_map<uint32_t, SpirvDecorations> decorations;
+            std::unordered_map<uint32_t, std::unordered_map<uint32_t, SpirvMemberDecorations>> memberDecorations;
+            std::vector<SpirvVariable> variables;
+
+            const SpirvType* findType(uint32_t id) const {
+                auto it = types.find(id);
+                return it != types.end() ? &it->second : nullptr;
+            }
+
+            SpirvDecorations getDecorations(uint32_t id) const {
+                auto it = decorations.find(id);
+                return it != decorations.end() ? it->second : SpirvDecorations{};
+            }
+
+            std::string getName(uint32_t id) const {
+                auto it = names.find(id);
+                return it != names.end() ? it->second : std::string();
+            }
+
+            // 按显式布局（Offset/ArrayStride/MatrixStride）计算类型大小
+            uint32_t sizeOf(uint32_t typeId, uint32_t matrixStride = 0) const {
+                const SpirvType* type = findType(typeId);
+                if (!type) {
+                    return 0;
+                }
+                switch (type->opcode) {
+                case spv::OpTypeBool:
+                    return 4;
+                case spv::OpTypeInt:
+                case spv::OpTypeFloat:
+                    return type->operands[0] / 8;
+                case spv::OpTypeVector:
+                    return sizeOf(type->operands[0]) * type->operands[1];
+                case spv::OpTypeMatrix: {
+                    const uint32_t columns = type->operands[1];
+                    const uint32_t stride = matrixStride ? matrixStride : sizeOf(type->operands[0]);
+                    return stride * columns;
+                }
+                case spv::OpTypeArray: {
+                    const uint32_t length = constantValue(type->operands[1]);
+                    uint32_t stride = getDecorations(typeId).arrayStride;
+                    if (stride == 0) {
+                        stride = sizeOf(type->operands[0], matrixStride);
+                    }
+                    return stride * length;
+                }
+                case spv::OpTypeStruct: {
+                    uint32_t size = 0;
+                    auto memberIt = memberDecorations.find(typeId);
+                    for (uint32_t m = 0; m < type->operands.size(); ++m) {
+                        SpirvMemberDecorations member{};
+                        if (memberIt != memberDecorations.end()) {
+                            auto found = memberIt->second.find(m);
+                            if (found != memberIt->second.end()) {
+                                member = found->second;
+                            }
+                        }
+                        size = std::max(size, member.offset + sizeOf(type->operands[m], member.matrixStride));
+                    }
+                    return size;
+                }
+                default:
+                    return 0;
+                }
+            }
+
+            // 结构体成员的最小Offset（推送常量块可能从非零偏移开始，供多个阶段分段使用）
+            uint32_t minMemberOffset(uint32_t typeId) const {
+                const SpirvType* type = findType(typeId);
+                if (!type || type->opcode != spv::OpTypeStruct || type->operands.empty()) {
+                    return 0;
+                }
+                auto memberIt = memberDecorations.find(typeId);
+                if (memberIt == memberDecorations.end()) {
+                    return 0;
+                }
+                uint32_t offset = UINT32_MAX;
+                for (uint32_t m = 0; m < type->operands.size(); ++m) {
+                    auto found = memberIt->second.find(m);
+                    offset = std::min(offset, found != memberIt->second.end() ? found->second.offset : 0u);
+                }
+                return offset;
+            }
+
+            uint32_t constantValue(uint32_t id) const {
+                auto it = constants.find(id);
+                return it != constants.end() ? it->second : 1;
+            }
+
+        private:
+            static std::string readString(const uint32_t* words, uint32_t count, uint32_t& outWordCount) {
+                std::string result;
+                for (uint32_t w = 0; w < count; ++w) {
+                    for (int b = 0; b < 4; ++b) {
+                        const char c = static_cast<char>((words[w] >> (b * 8)) & 0xFF);
+                        if (c == '\0') {
+                            outWordCount = w + 1;
+                            return result;
+                        }
+                        result.push_back(c);
+                    }
+                }
+                outWordCount = count;
+                return result;
+            }
+
+            static VkShaderStageFlags toStageFlags(uint32_t executionModel) {
+                switch (executionModel) {
+                case 0: return VK_SHADER_STAGE_VERTEX_BIT;
+                case 1: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+                case 2: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+                case 3: return VK_SHADER_STAGE_GEOMETRY_BIT;
+                case 4: return VK_SHADER_STAGE_FRAGMENT_BIT;
+                case 5: return VK_SHADER_STAGE_COMPUTE_BIT;
+                default: return 0;
+                }
+            }
+
+            void parseInstruction(uint32_t opcode, const uint32_t* ops, uint32_t count) {
+                switch (opcode) {
+                case spv::OpEntryPoint:
+                    if (count >= 1) {
+                        stage |= toStageFlags(ops[0]);
+                    }
+                    break;
+                case spv::OpName:
+                    if (count >= 2) {
+                        uint32_t used = 0;
+                        names[ops[0]] = readString(ops + 1, count - 1, used);
+                    }
+                    break;
+                case spv::OpTypeBool:
+                case spv::OpTypeInt:
+                case spv::OpTypeFloat:
+                case spv::OpTypeVector:
+                case spv::OpTypeMatrix:
+                case spv::OpTypeImage:
+                case spv::OpTypeSampler:
+                case spv::OpTypeSampledImage:
+                case spv::OpTypeArray:
+                case spv::OpTypeRuntimeArray:
+                case spv::OpTypeStruct:
+                case spv::OpTypePointer:
+                case spv::OpTypeAccelerationStructureKHR:
+                    if (count >= 1) {
+                        types[ops[0]] = SpirvType{ opcode, std::vector<uint32_t>(ops + 1, ops + count) };
+                    }
+                    break;
+                case spv::OpConstant:
+                case spv::OpSpecConstant:
+                    // 只关心数组长度，取低32位即可
+                    if (count >= 3) {
+                        constants[ops[1]] = ops[2];
+                    }
+                    break;
+                case spv::OpVariable:
+                    if (count >= 3) {
+                        variables.push_back(SpirvVariable{ ops[1], ops[0], ops[2] });
+                    }
+                    break;
+                case spv::OpDecorate:
+                    if (count >= 2) {
+                        auto& deco = decorations[ops[0]];
+                        const uint32_t value = count >= 3 ? ops[2] : 0;
+                        switch (ops[1]) {
+                        case spv::DecorationDescriptorSet: deco.set = value; deco.hasSet = true; break;
+                        case spv::DecorationBinding: deco.binding = value; deco.hasBinding = true; break;
+                        case spv::DecorationLocation: deco.location = value; deco.hasLocation = true; break;
+                        case spv::DecorationArrayStride: deco.arrayStride = value; break;
+                        case spv::DecorationBuiltIn: deco.builtIn = true; break;
+                        case spv::DecorationBlock: deco.block = true; break;
+                        case spv::DecorationBufferBlock: deco.bufferBlock = true; break;
+                        default: break;
+                        }
+                    }
+                    break;
+                case spv::OpMemberDecorate:
+                    if (count >= 3) {
+                        auto& member = memberDecorations[ops[0]][ops[1]];
+                        const uint32_t value = count >= 4 ? ops[3] : 0;
+                        switch (ops[2]) {
+                        case spv::DecorationOffset: member.offset = value; break;
+                        case spv::DecorationMatrixStride: member.matrixStride = value; break;
+                        case spv::DecorationBuiltIn: member.builtIn = true; break;
+                        default: break;
+                        }
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+        };
+
+        constexpr VkFormat FLOAT32[] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+        constexpr VkFormat FLOAT64[] = { VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT, VK_FORMAT_R64G64B64_SFLOAT, VK_FORMAT_R64G64B64A64_SFLOAT };
+        constexpr VkFormat SINT32[] = { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+        constexpr VkFormat UINT32[] = { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+
+        // 是否为反射能推导出的格式（其他格式如UNORM可能是合法的压缩输入，不做严格比较）
+        bool isReflectedFormat(VkFormat format) {
+            for (const auto* table : { FLOAT32, FLOAT64, SINT32, UINT32 }) {
+                if (std::find(table, table + 4, format) != table + 4) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        VkFormat toVertexFormat(const SpirvModule& module, uint32_t typeId, uint32_t& outSize) {
+            const SpirvType* type = module.findType(typeId);
+            outSize = 0;
+            if (!type) {
+                return VK_FORMAT_UNDEFINED;
+            }
+
+            uint32_t components = 1;
+            const SpirvType* scalar = type;
+            if (type->opcode == spv::OpTypeVector) {
+                components = type->operands[1];
+                scalar = module.findType(type->operands[0]);
+            }
+            // 只有数值标量带位宽操作数，先检查操作码再读取
+            if (!scalar || (scalar->opcode != spv::OpTypeFloat && scalar->opcode != spv::OpTypeInt) ||
+                scalar->operands.empty()) {
+                return VK_FORMAT_UNDEFINED;
+            }
+
+            const uint32_t width = scalar->operands[0];
+            outSize = width / 8 * components;
+
+            if (components < 1 || components > 4) {
+                return VK_FORMAT_UNDEFINED;
+            }
+            if (scalar->opcode == spv::OpTypeFloat) {
+                return width == 64 ? FLOAT64[components - 1] : FLOAT32[components - 1];
+            }
+            if (scalar->opcode == spv::OpTypeInt && width == 32 && scalar->operands.size() > 1) {
+                return scalar->operands[1] ? SINT32[components - 1] : UINT32[components - 1];
+            }
+            return VK_FORMAT_UNDEFINED;
+        }
+
+        VkDescriptorType toDescriptorType(const SpirvModule& module, uint32_t typeId, uint32_t storageClass) {
+            const SpirvType* type = module.findType(typeId);
+            if (!type) {
+                return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+            }
+
+            switch (storageClass) {
+            case spv::StorageUniform:
+                // 旧式SSBO使用Uniform存储类+BufferBlock修饰
+                return module.getDecorations(typeId).bufferBlock ?
+                    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            case spv::StorageStorageBuffer:
+                return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            case spv::StorageUniformConstant:
+                break;
+            default:
+                return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+            }
+
+            switch (type->opcode) {
+            case spv::OpTypeSampler:
+                return VK_DESCRIPTOR_TYPE_SAMPLER;
+            case spv::OpTypeSampledImage: {
+                const SpirvType* image = module.findType(type->operands[0]);
+                if (image && image->operands[1] == spv::DimBuffer) {
+                    return VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                }
+                return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            }
+            case spv::OpTypeImage: {
+                // 操作数：采样类型、Dim、Depth、Arrayed、MS、Sampled、Format
+                const uint32_t dim = type->operands[1];
+                const uint32_t sampled = type->operands[5];
+                if (dim == spv::DimSubpassData) {
+                    return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                }
+                if (dim == spv::DimBuffer) {
+                    return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                }
+                return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+            }
+            case spv::OpTypeAccelerationStructureKHR:
+                return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+            default:
+                return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+            }
+        }
+    }
+
+    ShaderReflection ShaderReflection::reflect(std::span<const uint32_t> spirv) {
+        const SpirvModule module(spirv);
+        ShaderReflection result;
+        result.mStageFlags = module.stage;
+
+        for (const auto& variable : module.variables) {
+            const SpirvType* pointer = module.findType(variable.typeId);
+            if (!pointer || pointer->opcode != spv::OpTypePointer) {
+                continue;
+            }
+            uint32_t typeId = pointer->operands[1];
+            const SpirvDecorations deco = module.getDecorations(variable.id);
+
+            switch (variable.storageClass) {
+            case spv::StorageUniformConstant:
+            case spv::StorageUniform:
+            case spv::StorageStorageBuffer: {
+                if (!deco.hasBinding) {
+                    break;
+                }
+
+                // 展开数组维度
+                uint32_t count = 1;
+                for (const SpirvType* type = module.findType(typeId); type;) {
+                    if (type->opcode == spv::OpTypeArray) {
+                        count *= module.constantValue(type->operands[1]);
+                    }
+                    else if (type->opcode == spv::OpTypeRuntimeArray) {
+                        count = 0;
+                    }
+                    else {
+                        break;
+                    }
+                    typeId = type->operands[0];
+                    type = module.findType(typeId);
+                }
+
+                DescriptorBinding binding;
+                binding.set = deco.set;
+                binding.binding = deco.binding;
+                binding.type = toDescriptorType(module, typeId, variable.storageClass);
+                binding.count = count;
+                binding.stageFlags = module.stage;
+                binding.name = module.getName(variable.id);
+                if (binding.name.empty()) {
+                    binding.name = module.getName(typeId);
+                }
+                if (binding.type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || binding.type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) {
+                    binding.blockSize = module.sizeOf(typeId);
+                }
+                if (binding.type == VK_DESCRIPTOR_TYPE_MAX_ENUM) {
+                    throw std::runtime_error("ShaderReflection: unsupported resource type for binding " + binding.name);
+                }
+                result.mBindings.push_back(binding);
+                break;
+            }
+            case spv::StoragePushConstant: {
+                const uint32_t end = module.sizeOf(typeId);
+                const uint32_t offset = module.minMemberOffset(typeId);
+                if (end > offset) {
+                    result.mPushConstantRanges.push_back(VkPushConstantRange{ module.stage, offset, end - offset });
+                }
+                break;
+            }
+            case spv::StorageInput: {
+                if (module.stage != VK_SHADER_STAGE_VERTEX_BIT || deco.builtIn || !deco.hasLocation) {
+                    break;
+                }
+
+                // 矩阵输入按列占用连续的location
+                const SpirvType* type = module.findType(typeId);
+                uint32_t columns = 1;
+                uint32_t columnType = typeId;
+                if (type && type->opcode == spv::OpTypeMatrix) {
+                    columns = type->operands[1];
+                    columnType = type->operands[0];
+                }
+
+                for (uint32_t c = 0; c < columns; ++c) {
+                    VertexInput input;
+                    input.location = deco.location + c;
+                    input.format = toVertexFormat(module, columnType, input.size);
+                    input.name = module.getName(variable.id);
+                    result.mVertexInputs.push_back(input);
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        std::sort(result.mBindings.begin(), result.mBindings.end(), [](const auto& a, const auto& b) {
+            return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+        });
+        std::sort(result.mVertexInputs.begin(), result.mVertexInputs.end(), [](const auto& a, const auto& b) {
+            return a.location < b.location;
+        });
+        return result;
+    }
+
+    ShaderReflection ShaderReflection::reflect(const ShaderProgram& program) {
+        ShaderReflection result;
+        for (const auto& module : program.getShaderModules()) {
+            result.merge(reflect(module->getCode()));
+        }
+        return result;
+    }
+
+    ShaderReflection& ShaderReflection::merge(const ShaderReflection& other) {
+        mStageFlags |= other.mStageFlags;
+
+        for (const auto& incoming : other.mBindings) {
+            auto it = std::find_if(mBindings.begin(), mBindings.end(), [&](const DescriptorBinding& b) {
+                return b.set == incoming.set && b.binding == incoming.binding;
+            });
+            if (it == mBindings.end()) {
+                mBindings.push_back(incoming);
+                continue;
+            }
+            if (it->type != incoming.type) {
+                throw std::runtime_error("ShaderReflection: conflicting descriptor types at set " +
+                    std::to_string(incoming.set) + ", binding " + std::to_string(incoming.binding));
+            }
+            it->stageFlags |= incoming.stageFlags;
+            it->count = (it->count == 0 || incoming.count == 0) ? 0 : std::max(it->count, incoming.count);
+            it->blockSize = std::max(it->blockSize, incoming.blockSize);
+        }
+        std::sort(mBindings.begin(), mBindings.end(), [](const auto& a, const auto& b) {
+            return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+        });
+
+        // 范围相同的推送常量合并阶段标志
+        for (const auto& incoming : other.mPushConstantRanges) {
+            auto it = std::find_if(mPushConstantRanges.begin(), mPushConstantRanges.end(), [&](const VkPushConstantRange& r) {
+                return r.offset == incoming.offset && r.size == incoming.size;
+            });
+            if (it != mPushConstantRanges.end()) {
+                it->stageFlags |= incoming.stageFlags;
+            }
+            else {
+                mPushConstantRanges.push_back(incoming);
+            }
+        }
+
+        // 顶点输入只来自顶点阶段
+        if (!other.mVertexInputs.empty()) {
+            mVertexInputs = other.mVertexInputs;
+        }
+        return *this;
+    }
+
+    std::vector<uint32_t> ShaderReflection::getSetIndices() const {
+        std::vector<uint32_t> sets;
+        for (const auto& binding : mBindings) {
+            if (sets.empty() || sets.back() != binding.set) {
+                sets.push_back(binding.set);
+            }
+        }
+        return sets;
+    }
+
+    std::vector<VkDescriptorSetLayoutBinding> ShaderReflection::getSetLayoutBindings(uint32_t set) const {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        for (const auto& binding : mBindings) {
+            if (binding.set != set) {
+                continue;
+            }
+            VkDescriptorSetLayoutBinding layoutBinding{};
+            layoutBinding.binding = binding.binding;
+            layoutBinding.descriptorType = binding.type;
+            // 运行时数组的实际上限由使用方决定，这里至少保留一个
+            layoutBinding.descriptorCount = std::max(binding.count, 1u);
+            layoutBinding.stageFlags = binding.stageFlags;
+            bindings.push_back(layoutBinding);
+        }
+        return bindings;
+    }
+
+    uint64_t ShaderReflection::getSetLayoutHash(uint32_t set) const {
+        Hasher hasher;
+        for (const auto& binding : getSetLayoutBindings(set)) {
+            hasher.add(binding.binding)
+                .add(binding.descriptorType)
+                .add(binding.descriptorCount)
+                .add(binding.stageFlags);
+        }
+        return hasher.get();
+    }
+
+    std::map<uint32_t, std::shared_ptr<DescriptorSetLayout>> ShaderReflection::createSetLayouts(
+        const std::shared_ptr<LogicalDevice>& logicalDevice) const {
+        std::map<uint32_t, std::shared_ptr<DescriptorSetLayout>> layouts;
+        auto layoutCache = LayoutCache::acquire(logicalDevice);
+
+        // 绑定相同的集合（包括其他着色器反射出的集合）共享同一个布局
+        for (uint32_t set : getSetIndices()) {
+            layouts[set] = layoutCache->getDescriptorSetLayout(getSetLayoutBindings(set));
+        }
+        return layouts;
+    }
+
+    void ShaderReflection::configureDescriptorManager(DescriptorManager& manager) const {
+        for (uint32_t set : getSetIndices()) {
+            manager.beginSetLayout(set);
+            for (const auto& binding : getSetLayoutBindings(set)) {
+                manager.addBinding(binding.binding, binding.descriptorType, binding.stageFlags, binding.descriptorCount);
+            }
+            manager.endSetLayout();
+        }
+    }
+
+    std::vector<VkVertexInputAttributeDescription> ShaderReflection::buildVertexAttributes(
+        uint32_t binding, uint32_t* outStride) const {
+        std::vector<VkVertexInputAttributeDescription> attributes;
+        uint32_t offset = 0;
+        for (const auto& input : mVertexInputs) {
+            attributes.push_back(VkVertexInputAttributeDescription{ input.location, binding, input.format, offset });
+            offset += input.size;
+        }
+        if (outStride) {
+            *outStride = offset;
+        }
+        return attributes;
+    }
+
+    void ShaderReflection::configureVertexInput(VertexInputComponent& component, uint32_t binding) const {
+        uint32_t stride = 0;
+        auto attributes = buildVertexAttributes(binding, &stride);
+        component.setBindings({ VkVertexInputBindingDescription{ binding, stride, VK_VERTEX_INPUT_RATE_VERTEX } })
+            .setAttributes(attributes);
+    }
+
+    std::vector<std::string> ShaderReflection::validateVertexInput(const VertexInputComponent& component) const {
+        std::vector<std::string> errors;
+        const auto& attributes = component.getAttributes();
+        for (const auto& input : mVertexInputs) {
+            auto it = std::find_if(attributes.begin(), attributes.end(), [&](const VkVertexInputAttributeDescription& a) {
+                return a.location == input.location;
+            });
+            const std::string label = "location " + std::to_string(input.location) +
+                (input.name.empty() ? "" : " (" + input.name + ")");
+            if (it == attributes.end()) {
+                errors.push_back(label + ": no vertex attribute provided");
+            }
+            else if (it->format != input.format && isReflectedFormat(it->format)) {
+                errors.push_back(label + ": attribute format " + std::to_string(it->format) +
+                    " does not match shader input format " + std::to_string(input.format));
+            }
+        }
+        return errors;
+    }
+}
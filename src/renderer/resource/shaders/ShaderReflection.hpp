@@ -0,0 +1,86 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace StarryEngine {
+    class LogicalDevice;
+    class ShaderProgram;
+    class DescriptorManager;
+    class DescriptorSetLayout;
+    class VertexInputComponent;
+
+    // SPIR-V反射：从着色器代码中提取描述符绑定、推送常量和顶点输入
+    // 多个阶段的结果可以合并，用于直接构建DescriptorSetLayout和顶点输入状态
+    class ShaderReflection {
+    public:
+        struct DescriptorBinding {
+            uint32_t set = 0;
+            uint32_t binding = 0;
+            VkDescriptorType type = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+            uint32_t count = 1;         // 0表示运行时数组（大小不定）
+            VkShaderStageFlags stageFlags = 0;
+            uint32_t blockSize = 0;     // uniform/storage缓冲的结构体大小
+            std::string name;
+        };
+
+        struct VertexInput {
+            uint32_t location = 0;
+            VkFormat format = VK_FORMAT_UNDEFINED;
+            uint32_t size = 0;          // 字节数
+            std::string name;
+        };
+
+        ShaderReflection() = default;
+
+        // 反射单个SPIR-V模块（阶段由入口点的执行模型决定）
+        static ShaderReflection reflect(std::span<const uint32_t> spirv);
+
+        // 反射并合并程序的所有阶段
+        static ShaderReflection reflect(const ShaderProgram& program);
+
+        // 合并另一个阶段的反射结果：同一绑定的类型必须一致，阶段标志取并集
+        ShaderReflection& merge(const ShaderReflection& other);
+
+        const std::vector<DescriptorBinding>& getDescriptorBindings() const { return mBindings; }
+        const std::vector<VkPushConstantRange>& getPushConstantRanges() const { return mPushConstantRanges; }
+        const std::vector<VertexInput>& getVertexInputs() const { return mVertexInputs; }
+        VkShaderStageFlags getStageFlags() const { return mStageFlags; }
+
+        // 所有使用到的set索引（升序）
+        std::vector<uint32_t> getSetIndices() const;
+
+        // 指定set的布局绑定（按binding排序）
+        std::vector<VkDescriptorSetLayoutBinding> getSetLayoutBindings(uint32_t set) const;
+
+        // 布局内容哈希，相同哈希的set可以共享同一个VkDescriptorSetLayout
+        uint64_t getSetLayoutHash(uint32_t set) const;
+
+        // 按反射结果获取描述符集布局，内容相同的set通过设备级LayoutCache共享同一个布局对象
+        std::map<uint32_t, std::shared_ptr<DescriptorSetLayout>> createSetLayouts(
+            const std::shared_ptr<LogicalDevice>& logicalDevice) const;
+
+        // 在DescriptorManager中定义全部set布局（代替手写的beginSetLayout/add*调用）
+        void configureDescriptorManager(DescriptorManager& manager) const;
+
+        // 按location顺序紧密排列的顶点属性（单个交错绑定），返回步长
+        std::vector<VkVertexInputAttributeDescription> buildVertexAttributes(
+            uint32_t binding = 0, uint32_t* outStride = nullptr) const;
+
+        // 用反射结果配置顶点输入组件
+        void configureVertexInput(VertexInputComponent& component, uint32_t binding = 0) const;
+
+        // 检查顶点输入组件与着色器输入是否匹配，返回不匹配的描述（为空表示一致）
+        std::vector<std::string> validateVertexInput(const VertexInputComponent& component) const;
+
+    private:
+        std::vector<DescriptorBinding> mBindings;
+        std::vector<VkPushConstantRange> mPushConstantRanges;
+        std::vector<VertexInput> mVertexInputs;
+        VkShaderStageFlags mStageFlags = 0;
+    };
+}
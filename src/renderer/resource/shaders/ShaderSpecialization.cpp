@@ -0,0 +1,61 @@
+#include "ShaderSpecialization.hpp"
+#include "../../utils/Hash.hpp"
+
+namespace StarryEngine {
+    ShaderSpecialization::ShaderSpecialization(const ShaderSpecialization& other)
+        : mValues(other.mValues) {
+        pack();
+    }
+
+    ShaderSpecialization& ShaderSpecialization::operator=(const ShaderSpecialization& other) {
+        if (this != &other) {
+            mValues = other.mValues;
+            pack();
+        }
+        return *this;
+    }
+
+    ShaderSpecialization& ShaderSpecialization::remove(uint32_t constantID) {
+        if (mValues.erase(constantID) > 0) {
+            pack();
+        }
+        return *this;
+    }
+
+    ShaderSpecialization& ShaderSpecialization::merge(const ShaderSpecialization& other) {
+        for (const auto& [constantID, value] : other.mValues) {
+            mValues[constantID] = value;
+        }
+        pack();
+        return *this;
+    }
+
+    void ShaderSpecialization::pack() {
+        mData.clear();
+        mEntries.clear();
+        for (const auto& [constantID, value] : mValues) {
+            VkSpecializationMapEntry entry{};
+            entry.constantID = constantID;
+            entry.offset = static_cast<uint32_t>(mData.size());
+            entry.size = value.size;
+            mEntries.push_back(entry);
+
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&value.bits);
+            mData.insert(mData.end(), bytes, bytes + value.size);
+        }
+
+        mInfo.mapEntryCount = static_cast<uint32_t>(mEntries.size());
+        mInfo.pMapEntries = mEntries.data();
+        mInfo.dataSize = mData.size();
+        mInfo.pData = mData.data();
+    }
+
+    uint64_t ShaderSpecialization::getHash() const {
+        Hasher hasher;
+        hasher.add(static_cast<uint64_t>(mValues.size()));
+        for (const auto& [constantID, value] : mValues) {
+            hasher.add(constantID).add(value.size).add(value.bits);
+        }
+        return hasher.get();
+    }
+}
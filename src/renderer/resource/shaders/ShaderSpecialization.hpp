@@ -0,0 +1,78 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <type_traits>
+#include <vector>
+
+namespace StarryEngine {
+    // 特化常量集合（constant_id → 值），用于构造VkSpecializationInfo
+    // 同一个SPIR-V模块配合不同的特化常量即可生成不同的管线变体，无需重新编译GLSL
+    class ShaderSpecialization {
+    public:
+        ShaderSpecialization() = default;
+
+        // 拷贝后重新打包，mInfo指向自身的数据（移动也走拷贝，常量很少）
+        ShaderSpecialization(const ShaderSpecialization& other);
+        ShaderSpecialization& operator=(const ShaderSpecialization& other);
+
+        // bool按VkBool32存储（与GLSL中的 layout(constant_id) const bool 对应）
+        ShaderSpecialization& set(uint32_t constantID, bool value) {
+            return setRaw(constantID, static_cast<VkBool32>(value ? VK_TRUE : VK_FALSE));
+        }
+
+        // int/uint/float/double
+        template<typename T>
+            requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 4 || sizeof(T) == 8))
+        ShaderSpecialization& set(uint32_t constantID, T value) {
+            return setRaw(constantID, value);
+        }
+
+        ShaderSpecialization& remove(uint32_t constantID);
+
+        bool empty() const { return mValues.empty(); }
+        size_t size() const { return mValues.size(); }
+        bool contains(uint32_t constantID) const { return mValues.count(constantID) > 0; }
+
+        // 合并：other中的常量覆盖当前值
+        ShaderSpecialization& merge(const ShaderSpecialization& other);
+
+        // 没有常量时返回nullptr；返回的指针在对象被修改或销毁前有效
+        // 修改常量时立即打包，这里只读，多个线程可同时调用
+        const VkSpecializationInfo* getInfo() const { return mValues.empty() ? nullptr : &mInfo; }
+
+        // 内容哈希（按constant_id排序），用于管线去重
+        uint64_t getHash() const;
+
+        bool operator==(const ShaderSpecialization& other) const { return mValues == other.mValues; }
+        bool operator!=(const ShaderSpecialization& other) const { return !(*this == other); }
+
+    private:
+        struct Value {
+            uint64_t bits = 0;
+            uint32_t size = 0;
+            bool operator==(const Value& other) const { return bits == other.bits && size == other.size; }
+        };
+
+        template<typename T>
+        ShaderSpecialization& setRaw(uint32_t constantID, T value) {
+            Value stored;
+            std::memcpy(&stored.bits, &value, sizeof(T));
+            stored.size = sizeof(T);
+            mValues[constantID] = stored;
+            pack();
+            return *this;
+        }
+
+        // 按constant_id顺序重新生成mData/mEntries/mInfo
+        void pack();
+
+        std::map<uint32_t, Value> mValues;
+
+        // getInfo()的打包结果，每次修改后重新生成
+        std::vector<uint8_t> mData;
+        std::vector<VkSpecializationMapEntry> mEntries;
+        VkSpecializationInfo mInfo{};
+    };
+}
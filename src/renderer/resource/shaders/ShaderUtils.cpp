@@ -1,75 +1,214 @@
 #include"shaderUtils.hpp"
+#include "../../utils/Hash.hpp"
 namespace StarryEngine {
+    std::atomic<ShaderCache::Ptr> ShaderUtils::sShaderCache;
+    std::atomic<ShaderPack::Ptr> ShaderUtils::sShaderPack;
+    std::atomic<ShaderIncludeResolver::Ptr> ShaderUtils::sIncludeResolver{ ShaderIncludeResolver::create() };
+
+    void ShaderUtils::SetShaderCache(ShaderCache::Ptr cache) {
+        sShaderCache.store(std::move(cache));
+    }
+
+    void ShaderUtils::SetShaderPack(ShaderPack::Ptr pack) {
+        sShaderPack.store(std::move(pack));
+    }
+
+    void ShaderUtils::SetIncludeResolver(ShaderIncludeResolver::Ptr resolver) {
+        sIncludeResolver.store(std::move(resolver));
+    }
+
     ShaderUtils::ShaderUtils(const LogicalDevice::Ptr& logicalDevice)
-        : mLogicalDevice(logicalDevice) {
+        : mLogicalDevice(logicalDevice),
+        mModuleRegistry(ShaderModuleRegistry::acquire(logicalDevice)) {
     }
 
-    VkShaderModule ShaderUtils::loadFromGLSL(
+    ShaderModule::Ptr ShaderUtils::loadFromGLSL(
         const std::string& filename,
         VkShaderStageFlagBits stage,
         const std::vector<std::pair<std::string, std::string>>& macros,
         const std::string& debugName
     ) {
-        const std::string source = readTextFile(filename);
-        shaderc_shader_kind kind;
-
-        switch (stage) {
-        case VK_SHADER_STAGE_VERTEX_BIT:   kind = shaderc_vertex_shader; break;
-        case VK_SHADER_STAGE_FRAGMENT_BIT: kind = shaderc_fragment_shader; break;
-        case VK_SHADER_STAGE_COMPUTE_BIT:  kind = shaderc_compute_shader; break;
-        default:
-            throw std::runtime_error("Unsupported shader stage");
+        if (auto module = loadFromPack(filename, macros, debugName)) {
+            return module;
         }
 
-        auto spirv = compileGLSL(source, kind, macros, debugName);
-        return createShaderModule(spirv, debugName);
+        const std::string source = readTextFile(filename);
+        std::vector<ShaderCache::Dependency> dependencies;
+        auto spirv = compileGLSL(mCompiler, source, toShaderKind(stage), macros, debugName, filename, &dependencies);
+        return createShaderModule(std::move(spirv), debugName, dependencies);
     }
 
-    VkShaderModule ShaderUtils::loadFromSPV(
+    ShaderModule::Ptr ShaderUtils::loadFromSPV(
         const std::string& filename,
         const std::string& debugName
     ) {
         auto spirv = readBinaryFile(filename);
         validateSPIRV(spirv);
-        return createShaderModule(spirv, debugName);
+        return createShaderModule(std::move(spirv), debugName);
     }
 
-    // 在shaderUtils.cpp中实现
-
-    VkShaderModule ShaderUtils::loadFromGLSLString(
+    ShaderModule::Ptr ShaderUtils::loadFromGLSLString(
         const std::string& sourceCode,
         VkShaderStageFlagBits stage,
         const std::vector<std::pair<std::string, std::string>>& macros,
         const std::string& debugName
     ) {
-        shaderc_shader_kind kind;
+        std::vector<ShaderCache::Dependency> dependencies;
+        auto spirv = compileGLSL(mCompiler, sourceCode, toShaderKind(stage), macros, debugName, "", &dependencies);
+        return createShaderModule(std::move(spirv), debugName, dependencies);
+    }
+
+    std::vector<ShaderModule::Ptr> ShaderUtils::loadBatch(
+        const std::vector<ShaderStageDesc>& stages,
+        const ThreadPool::Ptr& threadPool
+    ) {
+        std::vector<ShaderModule::Ptr> modules(stages.size());
+        if (stages.empty()) {
+            return modules;
+        }
+
+        // shaderc::Compiler不是线程安全的，每个工作线程各持有一个
+        std::vector<std::future<ShaderModule::Ptr>> futures;
+        futures.reserve(stages.size());
+        for (const auto& desc : stages) {
+            futures.push_back(threadPool->submit([this, &desc]() {
+                thread_local shaderc::Compiler workerCompiler;
+                return loadStage(workerCompiler, desc);
+            }));
+        }
+
+        // 按输入顺序收集结果并汇总错误
+        std::string errors;
+        uint32_t failedCount = 0;
+        for (size_t i = 0; i < futures.size(); ++i) {
+            try {
+                modules[i] = futures[i].get();
+            }
+            catch (const std::exception& e) {
+                failedCount++;
+                errors += "\n[" + std::to_string(i) + "] " +
+                    (stages[i].debugName.empty() ? stages[i].source.substr(0, 64) : stages[i].debugName) +
+                    ": " + e.what();
+            }
+        }
+
+        if (failedCount > 0) {
+            throw std::runtime_error("Batch shader compilation failed (" + std::to_string(failedCount) +
+                "/" + std::to_string(stages.size()) + " stages):" + errors);
+        }
+
+        return modules;
+    }
+
+    ShaderModule::Ptr ShaderUtils::loadStage(const shaderc::Compiler& compiler, const ShaderStageDesc& desc) {
+        switch (desc.sourceType) {
+        case ShaderStageDesc::SourceType::GLSLFile: {
+            if (auto module = loadFromPack(desc.source, desc.macros, desc.debugName)) {
+                return module;
+            }
+            const std::string source = readTextFile(desc.source);
+            std::vector<ShaderCache::Dependency> dependencies;
+            auto spirv = compileGLSL(compiler, source, toShaderKind(desc.stage), desc.macros,
+                desc.debugName.empty() ? desc.source : desc.debugName, desc.source, &dependencies);
+            return createShaderModule(std::move(spirv), desc.debugName, dependencies);
+        }
+        case ShaderStageDesc::SourceType::GLSLString: {
+            std::vector<ShaderCache::Dependency> dependencies;
+            auto spirv = compileGLSL(compiler, desc.source, toShaderKind(desc.stage), desc.macros,
+                desc.debugName, "", &dependencies);
+            return createShaderModule(std::move(spirv), desc.debugName, dependencies);
+        }
+        case ShaderStageDesc::SourceType::SPVFile: {
+            auto spirv = readBinaryFile(desc.source);
+            validateSPIRV(spirv);
+            return createShaderModule(std::move(spirv), desc.debugName);
+        }
+        default:
+            throw std::runtime_error("Unknown shader source type");
+        }
+    }
+
+    ShaderModule::Ptr ShaderUtils::loadFromPack(
+        const std::string& filename,
+        const std::vector<std::pair<std::string, std::string>>& macros,
+        const std::string& debugName
+    ) {
+        // 原子地取一份引用，避免与SetShaderPack并发时包被提前释放
+        ShaderPack::Ptr pack = sShaderPack.load();
+        if (!pack) {
+            return nullptr;
+        }
+
+        auto entry = pack->findSource(filename, macros);
+        if (!entry) {
+            return nullptr;
+        }
+
+        // 模块直接引用映射内存，并持有包的引用保证映射在模块销毁前有效
+        auto module = mModuleRegistry->getOrCreate(entry->code, entry->contentHash, pack, debugName);
+        module->addDependencies(pack->resolveDependencies(*entry));
+        return module;
+    }
+
+    shaderc_shader_kind ShaderUtils::toShaderKind(VkShaderStageFlagBits stage) {
         switch (stage) {
-        case VK_SHADER_STAGE_VERTEX_BIT:   kind = shaderc_vertex_shader; break;
-        case VK_SHADER_STAGE_FRAGMENT_BIT: kind = shaderc_fragment_shader; break;
-        case VK_SHADER_STAGE_COMPUTE_BIT:  kind = shaderc_compute_shader; break;
-        case VK_SHADER_STAGE_GEOMETRY_BIT: kind = shaderc_geometry_shader; break;
-        case VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT: kind = shaderc_tess_control_shader; break;
-        case VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT: kind = shaderc_tess_evaluation_shader; break;
+        case VK_SHADER_STAGE_VERTEX_BIT:   return shaderc_vertex_shader;
+        case VK_SHADER_STAGE_FRAGMENT_BIT: return shaderc_fragment_shader;
+        case VK_SHADER_STAGE_COMPUTE_BIT:  return shaderc_compute_shader;
+        case VK_SHADER_STAGE_GEOMETRY_BIT: return shaderc_geometry_shader;
+        case VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT: return shaderc_tess_control_shader;
+        case VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT: return shaderc_tess_evaluation_shader;
         default:
             throw std::runtime_error("Unsupported shader stage");
         }
-
-        auto spirv = compileGLSL(sourceCode, kind, macros, debugName);
-        return createShaderModule(spirv, debugName);
     }
 
     std::vector<uint32_t> ShaderUtils::compileGLSL(
+        const shaderc::Compiler& compiler,
         const std::string& source,
         shaderc_shader_kind kind,
         const std::vector<std::pair<std::string, std::string>>& macros,
-        const std::string& debugName
+        const std::string& debugName,
+        const std::string& sourcePath,
+        std::vector<ShaderCache::Dependency>* outDependencies
     ) {
+        // 取一份引用，编译期间不受SetIncludeResolver影响
+        ShaderIncludeResolver::Ptr resolver = sIncludeResolver.load();
+        // 同样只读取一次缓存，检查与使用之间被SetShaderCache(nullptr)也不会解引用空指针
+        ShaderCache::Ptr cache = sShaderCache.load();
+
+        // 先查磁盘缓存，命中且include依赖未变化时完全跳过shaderc
+        uint64_t cacheKey = 0;
+        if (cache) {
+            cacheKey = ShaderCache::computeKey(source, kind, macros,
+                TARGET_ENV, TARGET_ENV_VERSION, OPTIMIZATION_LEVEL);
+            if (resolver) {
+                hashCombine(cacheKey, resolver->getConfigHash());
+                // 相对#include按源文件所在目录解析，同样的源码放在不同目录可能得到不同结果
+                if (!sourcePath.empty()) {
+                    const std::filesystem::path directory =
+                        std::filesystem::path(ShaderIncludeResolver::normalizePath(sourcePath)).parent_path();
+                    hashCombine(cacheKey, Hasher().add(directory.generic_string()).get());
+                }
+            }
+
+            std::vector<uint32_t> cached;
+            std::vector<ShaderCache::Dependency> cachedDependencies;
+            const bool hit = cache->load(cacheKey, cached, &cachedDependencies,
+                [&resolver](const std::vector<ShaderCache::Dependency>& dependencies) {
+                    return dependencies.empty() || (resolver && resolver->isUpToDate(dependencies));
+                });
+            if (hit) {
+                if (outDependencies) {
+                    *outDependencies = std::move(cachedDependencies);
+                }
+                return cached;
+            }
+        }
+
         shaderc::CompileOptions options;
-        options.SetTargetEnvironment(
-            shaderc_target_env_vulkan,
-            shaderc_env_version_vulkan_1_2
-        );
-        options.SetOptimizationLevel(shaderc_optimization_level_performance);
+        options.SetTargetEnvironment(TARGET_ENV, TARGET_ENV_VERSION);
+        options.SetOptimizationLevel(OPTIMIZATION_LEVEL);
 
         // 添加用户定义的宏
         for (const auto& [name, value] : macros) {
@@ -81,29 +220,51 @@ namespace StarryEngine {
             }
         }
 
-        shaderc::SpvCompilationResult result = mCompiler.CompileGlslToSpv(
-            source, kind, debugName.c_str(), options
+        // 包含器归options所有，编译结束前保留裸指针用于取回依赖
+        const std::string inputName = sourcePath.empty() ? debugName : sourcePath;
+        ShaderIncluder* includer = nullptr;
+        if (resolver) {
+            auto ownedIncluder = std::make_unique<ShaderIncluder>(resolver, inputName,
+                sourcePath.empty() ? "" : ShaderIncludeResolver::normalizePath(sourcePath));
+            includer = ownedIncluder.get();
+            options.SetIncluder(std::move(ownedIncluder));
+        }
+
+        shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(
+            source, kind, inputName.c_str(), options
         );
 
         if (result.GetCompilationStatus() != shaderc_compilation_status_success) {
             throw std::runtime_error("Shader compile error: " + debugName + "\n" + result.GetErrorMessage());
         }
 
-        return { result.cbegin(), result.cend() };
+        std::vector<uint32_t> spirv(result.cbegin(), result.cend());
+        std::vector<ShaderCache::Dependency> dependencies;
+        if (includer) {
+            dependencies = includer->getDependencies();
+        }
+        if (cache) {
+            cache->store(cacheKey, spirv, dependencies);
+        }
+        if (outDependencies) {
+            *outDependencies = std::move(dependencies);
+        }
+        return spirv;
     }
 
-    VkShaderModule ShaderUtils::createShaderModule(
-        const std::vector<uint32_t>& code,
-        const std::string& debugName
+    ShaderModule::Ptr ShaderUtils::createShaderModule(
+        std::vector<uint32_t> code,
+        const std::string& debugName,
+        const std::vector<ShaderCache::Dependency>& dependencies
     ) {
-        VkShaderModuleCreateInfo createInfo{};
-        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        createInfo.codeSize = code.size() * sizeof(uint32_t);
-        createInfo.pCode = code.data();
-
-        VkShaderModule module;
-        if (vkCreateShaderModule(mLogicalDevice->getHandle(), &createInfo, nullptr, &module) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create shader module: " + debugName);
+        auto module = mModuleRegistry->getOrCreate(std::move(code), debugName);
+        if (!dependencies.empty()) {
+            std::vector<std::string> paths;
+            paths.reserve(dependencies.size());
+            for (const auto& dependency : dependencies) {
+                paths.push_back(dependency.path);
+            }
+            module->addDependencies(paths);
         }
         return module;
     }
@@ -1,8 +1,32 @@
 #pragma once
 #include "../../../base.hpp"
 #include "../../../renderer/backends/vulkan/vulkanCore/VulkanCore.hpp"
+#include "ShaderCache.hpp"
+#include "ShaderIncluder.hpp"
+#include "ShaderModuleRegistry.hpp"
+#include "ShaderPack.hpp"
+#include "ShaderSpecialization.hpp"
+#include "../../utils/ThreadPool.hpp"
 #include <shaderc/shaderc.hpp>
+#include <atomic>
 namespace StarryEngine {
+    // 批量编译时的单个着色器阶段描述
+    struct ShaderStageDesc {
+        enum class SourceType {
+            GLSLFile,
+            GLSLString,
+            SPVFile
+        };
+
+        SourceType sourceType = SourceType::GLSLFile;
+        std::string source;       // 文件路径或GLSL源码
+        VkShaderStageFlagBits stage = VK_SHADER_STAGE_VERTEX_BIT;
+        std::string entryPoint = "main";
+        std::vector<std::pair<std::string, std::string>> macros;
+        std::string debugName;
+        ShaderSpecialization specialization;  // 不参与编译，只在创建管线时使用
+    };
+
     class ShaderUtils {
     public:
         using Ptr = std::shared_ptr<ShaderUtils>;
@@ -13,7 +37,8 @@ namespace StarryEngine {
         ShaderUtils(const LogicalDevice::Ptr& logicalDevice);
 
         // 编译GLSL为SPIR-V（支持动态宏定义）
-        VkShaderModule loadFromGLSL(
+        // 返回的模块由设备级注册表共享，相同SPIR-V只创建一次
+        ShaderModule::Ptr loadFromGLSL(
             const std::string& filename,
             VkShaderStageFlagBits stage,  // 改用Vulkan原生类型
             const std::vector<std::pair<std::string, std::string>>& macros = {},
@@ -21,42 +46,93 @@ namespace StarryEngine {
         );
 
         // 直接加载SPIR-V文件
-        VkShaderModule loadFromSPV(
+        ShaderModule::Ptr loadFromSPV(
             const std::string& filename,
             const std::string& debugName = ""
         );
 
-        VkShaderModule loadFromGLSLString(
+        ShaderModule::Ptr loadFromGLSLString(
             const std::string& sourceCode,
             VkShaderStageFlagBits stage,
             const std::vector<std::pair<std::string, std::string>>& macros = {},
             const std::string& debugName = ""
         );
 
+        // 批量并行编译：每个工作线程持有独立的shaderc::Compiler
+        // 返回的模块与输入顺序一致；任一阶段失败时抛出汇总错误（已创建的模块随引用释放）
+        std::vector<ShaderModule::Ptr> loadBatch(
+            const std::vector<ShaderStageDesc>& stages,
+            const ThreadPool::Ptr& threadPool = ThreadPool::getShared()
+        );
+
+        static shaderc_shader_kind toShaderKind(VkShaderStageFlagBits stage);
+
+        const ShaderModuleRegistry::Ptr& getModuleRegistry() const { return mModuleRegistry; }
+
         // 文件读取工具
         static std::string readTextFile(const std::string& filename);
         static std::vector<uint32_t> readBinaryFile(const std::string& filename);
 
-    private:
-        // 编译GLSL核心逻辑（每次编译使用独立的CompileOptions）
-        std::vector<uint32_t> compileGLSL(
+        // 设置全局SPIR-V磁盘缓存（传入nullptr关闭缓存）
+        static void SetShaderCache(ShaderCache::Ptr cache);
+        static ShaderCache::Ptr GetShaderCache() { return sShaderCache.load(); }
+
+        // 设置全局离线着色器包（传入nullptr关闭）
+        // 设置后GLSL文件优先从包中取预编译的SPIR-V，包中没有的组合才回退到运行时编译
+        static void SetShaderPack(ShaderPack::Ptr pack);
+        static ShaderPack::Ptr GetShaderPack() { return sShaderPack.load(); }
+
+        // 设置全局#include解析器（搜索路径 + 文件内容缓存），传入nullptr关闭include支持
+        static void SetIncludeResolver(ShaderIncludeResolver::Ptr resolver);
+        static ShaderIncludeResolver::Ptr GetIncludeResolver() { return sIncludeResolver.load(); }
+
+        // 编译参数（同时参与缓存键计算）
+        static constexpr shaderc_target_env TARGET_ENV = shaderc_target_env_vulkan;
+        static constexpr shaderc_env_version TARGET_ENV_VERSION = shaderc_env_version_vulkan_1_2;
+        static constexpr shaderc_optimization_level OPTIMIZATION_LEVEL = shaderc_optimization_level_performance;
+
+        // 编译GLSL核心逻辑（每次编译使用独立的CompileOptions），离线工具也使用该入口
+        // sourcePath为源文件路径（用于解析相对include，字符串源码传空）
+        // outDependencies返回展开的全部include文件，缓存命中时取自缓存条目
+        static std::vector<uint32_t> compileGLSL(
+            const shaderc::Compiler& compiler,
             const std::string& source,
             shaderc_shader_kind kind,
             const std::vector<std::pair<std::string, std::string>>& macros,
-            const std::string& debugName
+            const std::string& debugName,
+            const std::string& sourcePath = "",
+            std::vector<ShaderCache::Dependency>* outDependencies = nullptr
         );
 
-        // 创建ShaderModule
-        VkShaderModule createShaderModule(
-            const std::vector<uint32_t>& code,
+    private:
+        // 从着色器包加载，未命中时返回nullptr
+        ShaderModule::Ptr loadFromPack(
+            const std::string& filename,
+            const std::vector<std::pair<std::string, std::string>>& macros,
             const std::string& debugName
         );
 
+        // 按描述加载单个阶段（批量编译的工作线程入口）
+        ShaderModule::Ptr loadStage(const shaderc::Compiler& compiler, const ShaderStageDesc& desc);
+
+        // 通过注册表获取或创建ShaderModule
+        ShaderModule::Ptr createShaderModule(
+            std::vector<uint32_t> code,
+            const std::string& debugName,
+            const std::vector<ShaderCache::Dependency>& dependencies = {}
+        );
+
         // SPIR-V验证
         static void validateSPIRV(const std::vector<uint32_t>& code);
 
     private:
         LogicalDevice::Ptr mLogicalDevice;
+        ShaderModuleRegistry::Ptr mModuleRegistry;
         shaderc::Compiler mCompiler;
+
+        // 全局设置可能在工作线程编译期间被替换，读写都是原子的
+        static std::atomic<ShaderCache::Ptr> sShaderCache;
+        static std::atomic<ShaderPack::Ptr> sShaderPack;
+        static std::atomic<ShaderIncludeResolver::Ptr> sIncludeResolver;
     };
 }
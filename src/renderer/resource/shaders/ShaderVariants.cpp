@@ -0,0 +1,194 @@
+#include "ShaderVariants.hpp"
+#include <iostream>
+
+namespace StarryEngine {
+    // ==================== ShaderVariantLibrary ====================
+
+    ShaderVariantLibrary::ShaderVariantLibrary(const LogicalDevice::Ptr& logicalDevice, const std::vector<ShaderStageDesc>& stages)
+        : mLogicalDevice(logicalDevice), mStageTemplates(stages) {
+        for (const auto& desc : mStageTemplates) {
+            switch (desc.sourceType) {
+            case ShaderStageDesc::SourceType::GLSLFile:
+                mKeywordSpace.addAxes(ShaderKeywordSpace::parseAxes(ShaderUtils::readTextFile(desc.source)));
+                break;
+            case ShaderStageDesc::SourceType::GLSLString:
+                mKeywordSpace.addAxes(ShaderKeywordSpace::parseAxes(desc.source));
+                break;
+            default:
+                // SPIR-V没有关键字
+                break;
+            }
+        }
+    }
+
+    std::vector<ShaderStageDesc> ShaderVariantLibrary::getStageDescs(VariantKey key) const {
+        const auto keywordMacros = mKeywordSpace.getMacros(key);
+        std::vector<ShaderStageDesc> descs = mStageTemplates;
+        for (auto& desc : descs) {
+            if (desc.sourceType == ShaderStageDesc::SourceType::SPVFile) {
+                continue;
+            }
+            desc.macros.insert(desc.macros.end(), keywordMacros.begin(), keywordMacros.end());
+            if (!desc.debugName.empty()) {
+                desc.debugName += "[" + mKeywordSpace.keyToString(key) + "]";
+            }
+        }
+        return descs;
+    }
+
+    ShaderProgram::Ptr ShaderVariantLibrary::compileVariant(VariantKey key) const {
+        // 逐阶段编译，不使用loadBatch：该函数可能运行在工作线程池中，嵌套提交会造成死锁
+        auto program = ShaderProgram::create(mLogicalDevice);
+        for (const auto& desc : getStageDescs(key)) {
+            switch (desc.sourceType) {
+            case ShaderStageDesc::SourceType::GLSLFile:
+                program->addGLSLStage(desc.source, desc.stage, desc.entryPoint.c_str(), desc.macros, desc.debugName,
+                    desc.specialization);
+                break;
+            case ShaderStageDesc::SourceType::GLSLString:
+                program->addGLSLStringStage(desc.source, desc.stage, desc.entryPoint.c_str(), desc.macros, desc.debugName,
+                    desc.specialization);
+                break;
+            case ShaderStageDesc::SourceType::SPVFile:
+                program->addSPVStage(desc.source, desc.stage, desc.entryPoint.c_str(), desc.debugName, desc.specialization);
+                break;
+            }
+        }
+        return program;
+    }
+
+    ShaderProgram::Ptr ShaderVariantLibrary::getVariant(const std::vector<std::string>& keywords) {
+        return getVariant(mKeywordSpace.computeKey(keywords));
+    }
+
+    ShaderProgram::Ptr ShaderVariantLibrary::getVariant(VariantKey key) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mVariants.find(key);
+            if (it != mVariants.end()) {
+                return it->second;
+            }
+            if (mCompiling.count(key) || mFailed.count(key)) {
+                return mPlaceholder;
+            }
+            mCompiling.insert(key);
+        }
+
+        auto self = shared_from_this();
+        ThreadPool::getShared()->submit([self, key]() {
+            ShaderProgram::Ptr program;
+            try {
+                program = self->compileVariant(key);
+            }
+            catch (const std::exception& e) {
+                std::cerr << "ShaderVariantLibrary: failed to compile variant "
+                    << self->mKeywordSpace.keyToString(key) << ": " << e.what() << std::endl;
+            }
+
+            std::lock_guard<std::mutex> lock(self->mMutex);
+            self->mCompiling.erase(key);
+            if (program) {
+                self->mVariants[key] = program;
+            }
+            else {
+                self->mFailed.insert(key);
+            }
+        });
+        return mPlaceholder;
+    }
+
+    ShaderProgram::Ptr ShaderVariantLibrary::getVariantBlocking(const std::vector<std::string>& keywords) {
+        return getVariantBlocking(mKeywordSpace.computeKey(keywords));
+    }
+
+    ShaderProgram::Ptr ShaderVariantLibrary::getVariantBlocking(VariantKey key) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mVariants.find(key);
+            if (it != mVariants.end()) {
+                return it->second;
+            }
+        }
+
+        // 与后台编译重复时，相同SPIR-V会在模块注册表中复用
+        auto program = compileVariant(key);
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFailed.erase(key);
+        return mVariants.emplace(key, program).first->second;
+    }
+
+    bool ShaderVariantLibrary::isReady(VariantKey key) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mVariants.count(key) > 0;
+    }
+
+    void ShaderVariantLibrary::precompileAll(const std::function<bool(VariantKey)>& filter) {
+        precompileKeys(mKeywordSpace.enumerate(filter));
+    }
+
+    void ShaderVariantLibrary::precompile(const std::vector<std::vector<std::string>>& keywordSets) {
+        std::vector<VariantKey> keys;
+        for (const auto& keywords : keywordSets) {
+            const VariantKey key = mKeywordSpace.computeKey(keywords);
+            if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+                keys.push_back(key);
+            }
+        }
+        precompileKeys(keys);
+    }
+
+    void ShaderVariantLibrary::precompileKeys(const std::vector<VariantKey>& keys) {
+        std::vector<VariantKey> missing;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (VariantKey key : keys) {
+                if (!mVariants.count(key)) {
+                    missing.push_back(key);
+                }
+            }
+        }
+        if (missing.empty()) {
+            return;
+        }
+
+        std::vector<std::vector<ShaderStageDesc>> programs;
+        programs.reserve(missing.size());
+        for (VariantKey key : missing) {
+            programs.push_back(getStageDescs(key));
+        }
+
+        std::vector<ShaderProgram::Ptr> compiled;
+        try {
+            compiled = ShaderProgram::createBatch(mLogicalDevice, programs);
+        }
+        catch (const std::exception& e) {
+            // 批量失败时逐个编译，定位失败的变体，其余变体照常可用
+            std::cerr << "ShaderVariantLibrary: batch precompile failed, retrying per variant:\n" << e.what() << std::endl;
+            compiled.assign(missing.size(), nullptr);
+            for (size_t i = 0; i < missing.size(); ++i) {
+                try {
+                    compiled[i] = compileVariant(missing[i]);
+                }
+                catch (const std::exception& variantError) {
+                    std::cerr << "ShaderVariantLibrary: variant " << mKeywordSpace.keyToString(missing[i])
+                        << " failed: " << variantError.what() << std::endl;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (size_t i = 0; i < missing.size(); ++i) {
+            if (compiled[i]) {
+                mVariants.emplace(missing[i], compiled[i]);
+            }
+            else {
+                mFailed.insert(missing[i]);
+            }
+        }
+    }
+
+    size_t ShaderVariantLibrary::getCompiledCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mVariants.size();
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "ShaderProgram.hpp"
+#include "ShaderKeywords.hpp"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace StarryEngine {
+    // 着色器变体库：同一组阶段源码按关键字组合编译出不同的ShaderProgram
+    class ShaderVariantLibrary : public std::enable_shared_from_this<ShaderVariantLibrary> {
+    public:
+        using Ptr = std::shared_ptr<ShaderVariantLibrary>;
+        using VariantKey = ShaderKeywordSpace::VariantKey;
+
+        enum class CompileMode {
+            Lazy,       // 首次请求时后台编译，编译期间返回占位程序
+            Precompile  // 创建后立即编译全部排列
+        };
+
+        static Ptr create(const LogicalDevice::Ptr& logicalDevice,
+            const std::vector<ShaderStageDesc>& stages,
+            CompileMode mode = CompileMode::Lazy) {
+            auto library = std::make_shared<ShaderVariantLibrary>(logicalDevice, stages);
+            if (mode == CompileMode::Precompile) {
+                library->precompileAll();
+            }
+            return library;
+        }
+
+        // stages中的源码（GLSL文件或字符串）会被解析出关键字轴
+        ShaderVariantLibrary(const LogicalDevice::Ptr& logicalDevice, const std::vector<ShaderStageDesc>& stages);
+
+        // 变体未就绪时返回的程序（为空则返回nullptr，调用方跳过绘制）
+        void setPlaceholder(const ShaderProgram::Ptr& placeholder) { mPlaceholder = placeholder; }
+
+        // 获取变体：已编译则直接返回；否则提交后台编译并返回占位程序，不阻塞调用线程
+        ShaderProgram::Ptr getVariant(const std::vector<std::string>& keywords);
+        ShaderProgram::Ptr getVariant(VariantKey key);
+
+        // 同步获取变体（必要时在当前线程编译）
+        ShaderProgram::Ptr getVariantBlocking(const std::vector<std::string>& keywords);
+        ShaderProgram::Ptr getVariantBlocking(VariantKey key);
+
+        bool isReady(VariantKey key) const;
+
+        // 预编译全部（或filter允许的）排列，所有阶段合并为一次并行批量编译
+        void precompileAll(const std::function<bool(VariantKey)>& filter = nullptr);
+
+        // 预编译指定的关键字组合（可达排列通常远少于全排列）
+        void precompile(const std::vector<std::vector<std::string>>& keywordSets);
+
+        const ShaderKeywordSpace& getKeywordSpace() const { return mKeywordSpace; }
+        const std::vector<ShaderStageDesc>& getStageTemplates() const { return mStageTemplates; }
+
+        // 变体对应的阶段描述（模板宏 + 关键字宏）
+        std::vector<ShaderStageDesc> getStageDescs(VariantKey key) const;
+
+        size_t getCompiledCount() const;
+
+    private:
+        ShaderProgram::Ptr compileVariant(VariantKey key) const;
+        void precompileKeys(const std::vector<VariantKey>& keys);
+
+    private:
+        LogicalDevice::Ptr mLogicalDevice;
+        std::vector<ShaderStageDesc> mStageTemplates;
+        ShaderKeywordSpace mKeywordSpace;
+        ShaderProgram::Ptr mPlaceholder;
+
+        mutable std::mutex mMutex;
+        std::unordered_map<VariantKey, ShaderProgram::Ptr> mVariants;
+        std::unordered_set<VariantKey> mCompiling;
+        std::unordered_set<VariantKey> mFailed;  // 编译失败的变体不再重试，继续使用占位程序
+    };
+}
@@ -54,6 +54,8 @@ namespace StarryEngine {
         if (pixels.data() && pixels.size() > 0) {
             uploadData(pixels.data(), pixels.size(), extent);
         }
+
+        registerBindless();
     }
 
     // 深度纹理专用构造函数
@@ -91,6 +93,19 @@ namespace StarryEngine {
     }
 
     void Texture::cleanup() {
+        if (mBindlessImageIndex != BindlessTable::INVALID_INDEX || mBindlessSamplerIndex != BindlessTable::INVALID_INDEX) {
+            if (auto bindless = BindlessTable::find(mLogicalDevice->getHandle())) {
+                bindless->release(BindlessTable::Binding::SampledImage, mBindlessImageIndex);
+                bindless->releaseSampler(mBindlessSamplerIndex);
+            }
+            // 共享采样器归资源表所有，不在这里销毁
+            if (mBindlessSamplerIndex != BindlessTable::INVALID_INDEX) {
+                mSampler = VK_NULL_HANDLE;
+            }
+            mBindlessImageIndex = BindlessTable::INVALID_INDEX;
+            mBindlessSamplerIndex = BindlessTable::INVALID_INDEX;
+        }
+
         if (mImageView != VK_NULL_HANDLE) {
             vkDestroyImageView(mLogicalDevice->getHandle(), mImageView, nullptr);
             mImageView = VK_NULL_HANDLE;
@@ -201,11 +216,27 @@ namespace StarryEngine {
     }
 
     void Texture::createSampler(const VkSamplerCreateInfo& samplerInfo) {
+        // 启用无绑定时使用资源表中按参数共享的采样器
+        if (auto bindless = BindlessTable::find(mLogicalDevice->getHandle())) {
+            auto shared = bindless->acquireSampler(samplerInfo);
+            if (shared.sampler != VK_NULL_HANDLE) {
+                mSampler = shared.sampler;
+                mBindlessSamplerIndex = shared.index;
+                return;
+            }
+        }
         if (vkCreateSampler(mLogicalDevice->getHandle(), &samplerInfo, nullptr, &mSampler) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create texture sampler!");
         }
     }
 
+    void Texture::registerBindless() {
+        if (auto bindless = BindlessTable::find(mLogicalDevice->getHandle())) {
+            mBindlessImageIndex = bindless->registerSampledImage(mImageView);
+            // 采样器槽位已在createSampler()中随共享采样器取得
+        }
+    }
+
     void Texture::uploadData(const void* data, size_t dataSize, VkExtent2D extent) {
         // 创建暂存缓冲区
         VkBuffer stagingBuffer;
@@ -3,6 +3,7 @@
 #include "../../../renderer/backends/vulkan/vulkanCore/VulkanCore.hpp"
 #include "../../../renderer/backends/vulkan/windowContext/Swapchain.hpp"
 #include "../../../renderer/backends/vulkan/renderContext/CommandPool.hpp"
+#include "../../../renderer/backends/vulkan/descriptor/BindlessTable.hpp"
 #include <stdexcept>
 namespace StarryEngine {
     class Texture {
@@ -55,6 +56,10 @@ namespace StarryEngine {
         VkFormat getFormat() const { return mFormat; }
         Type getType() const { return mType; }
 
+        // 在无绑定资源表中的索引（设备未启用无绑定或深度纹理时为BindlessTable::INVALID_INDEX）
+        uint32_t getBindlessImageIndex() const { return mBindlessImageIndex; }
+        uint32_t getBindlessSamplerIndex() const { return mBindlessSamplerIndex; }
+
     private:
         LogicalDevice::Ptr mLogicalDevice;
         CommandPool::Ptr mCommandPool;
@@ -64,6 +69,9 @@ namespace StarryEngine {
         VkSampler mSampler = VK_NULL_HANDLE;
         VkDeviceMemory mMemory = VK_NULL_HANDLE;
 
+        uint32_t mBindlessImageIndex = BindlessTable::INVALID_INDEX;
+        uint32_t mBindlessSamplerIndex = BindlessTable::INVALID_INDEX;
+
         Type mType = Type::Color;
         VkFormat mFormat = VK_FORMAT_UNDEFINED;
 
@@ -78,6 +86,7 @@ namespace StarryEngine {
         void allocateMemory(VkMemoryPropertyFlags properties);
         void createImageView();
         void createSampler(const VkSamplerCreateInfo& samplerInfo);
+        void registerBindless();
         void uploadData(const void* data, size_t dataSize, VkExtent2D extent);
         void transitionImageLayout(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout);
         void copyBufferToImage(VkBuffer buffer, VkImage image, VkExtent2D extent);
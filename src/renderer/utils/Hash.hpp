@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace StarryEngine {
+
+    // FNV-1a 64位哈希，用于着色器/管线等内容寻址的键
+    class Hasher {
+    public:
+        static constexpr uint64_t OFFSET_BASIS = 14695981039346656037ull;
+        static constexpr uint64_t PRIME = 1099511628211ull;
+
+        constexpr Hasher() = default;
+        constexpr explicit Hasher(uint64_t seed) : mValue(seed) {}
+
+        // 按字节累加
+        Hasher& addBytes(const void* data, size_t size) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                mValue ^= bytes[i];
+                mValue *= PRIME;
+            }
+            return *this;
+        }
+
+        // 整数/枚举按小端字节序累加，保证编译期与运行期结果一致
+        template<typename T>
+            requires std::is_integral_v<T> || std::is_enum_v<T>
+        constexpr Hasher& add(T value) {
+            const uint64_t bits = static_cast<uint64_t>(value);
+            for (int i = 0; i < 8; ++i) {
+                mValue ^= (bits >> (i * 8)) & 0xFF;
+                mValue *= PRIME;
+            }
+            return *this;
+        }
+
+        // 字符串带长度前缀，避免 "ab"+"c" 与 "a"+"bc" 冲突
+        constexpr Hasher& add(std::string_view str) {
+            add(static_cast<uint64_t>(str.size()));
+            for (char c : str) {
+                mValue ^= static_cast<uint8_t>(c);
+                mValue *= PRIME;
+            }
+            return *this;
+        }
+
+        Hasher& add(const std::string& str) { return add(std::string_view(str)); }
+        Hasher& add(const char* str) { return add(std::string_view(str)); }
+
+        Hasher& add(float value) {
+            return addBytes(&value, sizeof(value));
+        }
+
+        template<typename T>
+        Hasher& add(const std::vector<T>& values) {
+            add(static_cast<uint64_t>(values.size()));
+            return addBytes(values.data(), values.size() * sizeof(T));
+        }
+
+        constexpr uint64_t get() const { return mValue; }
+
+    private:
+        uint64_t mValue = OFFSET_BASIS;
+    };
+
+    inline uint64_t hashBytes(const void* data, size_t size) {
+        return Hasher().addBytes(data, size).get();
+    }
+
+    inline void hashCombine(uint64_t& seed, uint64_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 12) + (seed >> 4);
+    }
+
+    // 64位哈希转16位十六进制字符串（用作缓存文件名）
+    inline std::string hashToHex(uint64_t value) {
+        static const char* digits = "0123456789abcdef";
+        std::string out(16, '0');
+        for (int i = 15; i >= 0; --i) {
+            out[i] = digits[value & 0xF];
+            value >>= 4;
+        }
+        return out;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace StarryEngine {
+    // 简单的固定线程数工作池（着色器编译、管线创建等后台任务共用）
+    class ThreadPool {
+    public:
+        using Ptr = std::shared_ptr<ThreadPool>;
+        static Ptr create(uint32_t threadCount = 0) {
+            return std::make_shared<ThreadPool>(threadCount);
+        }
+
+        // 进程级共享工作池，首次使用时创建
+        static Ptr getShared() {
+            static Ptr sShared = create();
+            return sShared;
+        }
+
+        explicit ThreadPool(uint32_t threadCount = 0) {
+            if (threadCount == 0) {
+                threadCount = std::max(1u, std::thread::hardware_concurrency());
+            }
+            mWorkers.reserve(threadCount);
+            for (uint32_t i = 0; i < threadCount; ++i) {
+                mWorkers.emplace_back([this]() { workerLoop(); });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStopping = true;
+            }
+            mCondition.notify_all();
+            for (auto& worker : mWorkers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // 提交任务，返回future（任务中的异常通过future传播）
+        template<typename F>
+        auto submit(F&& func) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+            std::future<Result> future = task->get_future();
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mTasks.emplace([task]() { (*task)(); });
+            }
+            mCondition.notify_one();
+            return future;
+        }
+
+        uint32_t getThreadCount() const { return static_cast<uint32_t>(mWorkers.size()); }
+
+        size_t getPendingTaskCount() const {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mTasks.size();
+        }
+
+    private:
+        void workerLoop() {
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mMutex);
+                    mCondition.wait(lock, [this]() { return mStopping || !mTasks.empty(); });
+                    if (mStopping && mTasks.empty()) {
+                        return;
+                    }
+                    task = std::move(mTasks.front());
+                    mTasks.pop();
+                }
+                task();
+            }
+        }
+
+    private:
+        std::vector<std::thread> mWorkers;
+        std::queue<std::function<void()>> mTasks;
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mStopping = false;
+    };
+}
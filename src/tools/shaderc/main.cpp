@@ -0,0 +1,159 @@
+// starry_shaderc：离线编译着色器目录中的全部着色器及其关键字变体，输出单个着色器包
+// 用法：starry_shaderc <着色器目录> <输出包> [--cache <SPIR-V缓存目录>]
+#include "renderer/resource/shaders/ShaderUtils.hpp"
+#include "renderer/resource/shaders/ShaderPack.hpp"
+#include "renderer/resource/shaders/ShaderKeywords.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <map>
+
+using namespace StarryEngine;
+namespace fs = std::filesystem;
+
+namespace {
+    const std::map<std::string, VkShaderStageFlagBits> STAGE_EXTENSIONS = {
+        { ".vert", VK_SHADER_STAGE_VERTEX_BIT },
+        { ".frag", VK_SHADER_STAGE_FRAGMENT_BIT },
+        { ".comp", VK_SHADER_STAGE_COMPUTE_BIT },
+        { ".geom", VK_SHADER_STAGE_GEOMETRY_BIT },
+        { ".tesc", VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT },
+        { ".tese", VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT },
+    };
+
+    struct CompileJob {
+        std::string name;       // 包内名称（相对着色器目录）
+        std::string variant;
+        std::string debugName;
+        std::string path;
+        VkShaderStageFlagBits stage;
+        const std::string* source;
+        std::vector<std::pair<std::string, std::string>> macros;
+    };
+
+    int printUsage() {
+        std::cerr << "Usage: starry_shaderc <shader_dir> <output.pack> [--cache <cache_dir>]" << std::endl;
+        return 2;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        return printUsage();
+    }
+
+    const fs::path shaderDir = argv[1];
+    const std::string outputPath = argv[2];
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--cache" && i + 1 < argc) {
+            // 增量构建：未改动的变体直接从SPIR-V缓存读取
+            ShaderUtils::SetShaderCache(ShaderCache::create(argv[++i]));
+        }
+        else {
+            return printUsage();
+        }
+    }
+
+    if (!fs::is_directory(shaderDir)) {
+        std::cerr << "starry_shaderc: shader directory not found: " << shaderDir.string() << std::endl;
+        return 1;
+    }
+
+    // include按着色器目录解析（与运行时的搜索路径一致）
+    ShaderUtils::SetIncludeResolver(ShaderIncludeResolver::create({ shaderDir.string() }));
+    const fs::path shaderRoot = ShaderIncludeResolver::normalizePath(shaderDir);
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // 收集源文件（按路径排序，保证输出稳定）
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(shaderDir)) {
+        if (entry.is_regular_file() && STAGE_EXTENSIONS.count(entry.path().extension().string())) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    // 每个文件按 #pragma keywords 展开全部排列
+    std::vector<std::string> sources;
+    sources.reserve(files.size());
+    std::vector<CompileJob> jobs;
+    try {
+        for (const auto& file : files) {
+            sources.push_back(ShaderUtils::readTextFile(file.string()));
+            const std::string& source = sources.back();
+            const std::string name = file.lexically_relative(shaderDir).generic_string();
+            const VkShaderStageFlagBits stage = STAGE_EXTENSIONS.at(file.extension().string());
+
+            ShaderKeywordSpace keywordSpace(ShaderKeywordSpace::parseAxes(source));
+            for (auto key : keywordSpace.enumerate()) {
+                CompileJob job;
+                job.name = name;
+                job.macros = keywordSpace.getMacros(key);
+                job.variant = ShaderPack::makeVariantName(job.macros);
+                job.debugName = name + "[" + job.variant + "]";
+                job.path = file.string();
+                job.stage = stage;
+                job.source = &source;
+                jobs.push_back(std::move(job));
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "starry_shaderc: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // 并行编译，每个工作线程持有独立的shaderc::Compiler
+    struct CompileResult {
+        std::vector<uint32_t> spirv;
+        std::vector<std::string> dependencies;  // 相对着色器目录
+    };
+    std::vector<std::future<CompileResult>> futures;
+    futures.reserve(jobs.size());
+    auto threadPool = ThreadPool::getShared();
+    for (const auto& job : jobs) {
+        futures.push_back(threadPool->submit([&job, &shaderRoot]() {
+            thread_local shaderc::Compiler workerCompiler;
+            std::vector<ShaderCache::Dependency> dependencies;
+            CompileResult result;
+            result.spirv = ShaderUtils::compileGLSL(workerCompiler, *job.source,
+                ShaderUtils::toShaderKind(job.stage), job.macros, job.debugName, job.path, &dependencies);
+            for (const auto& dependency : dependencies) {
+                result.dependencies.push_back(
+                    fs::path(dependency.path).lexically_relative(shaderRoot).generic_string());
+            }
+            return result;
+        }));
+    }
+
+    ShaderPackWriter writer;
+    uint32_t failedCount = 0;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        try {
+            CompileResult result = futures[i].get();
+            writer.add(jobs[i].name, jobs[i].variant, jobs[i].stage, std::move(result.spirv), result.dependencies);
+        }
+        catch (const std::exception& e) {
+            failedCount++;
+            std::cerr << e.what() << std::endl;
+        }
+    }
+
+    if (failedCount > 0) {
+        std::cerr << "starry_shaderc: " << failedCount << "/" << jobs.size() << " variants failed" << std::endl;
+        return 1;
+    }
+
+    if (!writer.write(outputPath)) {
+        return 1;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "starry_shaderc: packed " << writer.getEntryCount() << " variants from "
+        << files.size() << " files into " << outputPath << " (" << elapsed << " ms)" << std::endl;
+    return 0;
+}